@@ -0,0 +1,92 @@
+#ifndef ANIMATION_HPP
+#define ANIMATION_HPP
+
+#include "SFML/Graphics.hpp"
+#include "GameConfig.hpp"
+#include "EntityState.hpp"
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+// Um frame de um clip. Os clips de texturas soltas (Isaac, Demon, Bishop) trocam
+// a textura; os de spritesheet (Chubby, Monstro) trocam so o rect.
+struct AnimationFrame {
+    const sf::Texture* texture = nullptr; // nullptr = mantem a textura do sprite
+    sf::IntRect rect{};                   // tamanho 0 = mantem o rect do sprite
+};
+
+// Clip imutavel partilhado por todas as instancias (vive na AnimationLibrary)
+struct AnimationClip {
+    std::string name;
+    std::uint32_t id = 0;       // Hash do nome (estavel entre execucoes, vai para o save)
+    std::vector<AnimationFrame> frames;
+    float frameDuration = 0.1f;
+    bool loop = true;
+    int eventFrame = -1; // Frame que dispara o evento do clip (-1 = nenhum)
+
+    int frameCount() const { return static_cast<int>(frames.size()); }
+    const AnimationFrame& frame(int index) const { return frames[index % frames.size()]; }
+    void apply(sf::Sprite& sprite, int index) const;
+};
+
+// Estado da animacao de uma entidade: so o clip atual e a posicao nele.
+// O avanco e feito em lote (advanceAnimations) antes do update das entidades,
+// que depois leem frame/eventFired e aplicam o frame ao sprite.
+struct AnimationPlayhead {
+    const AnimationClip* clip = nullptr;
+    float time = 0.f;
+    int frame = 0;
+    bool playing = false;
+    bool finished = false;     // Clip sem loop chegou ao fim
+    bool frameChanged = false; // Resultado do ultimo avanco
+    bool eventFired = false;   // Passou pelo eventFrame no ultimo avanco
+
+    // Muda de clip (volta ao inicio se for outro clip ou se 'restart')
+    void play(const AnimationClip* newClip, bool restart = false);
+    // Para no frame 0 do clip atual
+    void stop();
+    void apply(sf::Sprite& sprite) const;
+
+    // Save da run: o clip tem de ja existir na biblioteca (criado no spawn da entidade)
+    void save(AnimationState& state) const;
+    void load(const AnimationState& state);
+};
+
+// Avanca todos os playheads de uma vez
+void advanceAnimations(const std::vector<AnimationPlayhead*>& playheads, float deltaTime);
+void advanceAnimation(AnimationPlayhead& playhead, float deltaTime);
+
+// Clips partilhados, criados na primeira vez que sao pedidos (thread principal,
+// no spawn). Os enderecos sao estaveis enquanto a biblioteca existir. O nome
+// identifica o clip (e o que vai para o save): pedi-lo de novo com outras texturas,
+// frames ou tempos lanca std::runtime_error em vez de devolver o clip antigo.
+class AnimationLibrary {
+public:
+    static AnimationLibrary& getInstance();
+
+    // Clip de texturas soltas (um frame por textura, no maximo 'frames')
+    const AnimationClip* fromTextures(const std::string& name, const std::vector<sf::Texture>& textures,
+        int frames, float frameDuration, bool loop = true, int eventFrame = -1);
+
+    // Clip de um arquetipo (chave "arquetipo/clip")
+    const AnimationClip* fromArchetype(const EnemyArchetype& archetype, int clipIndex);
+
+    // nullptr se nao existir
+    const AnimationClip* find(const std::string& name) const;
+    const AnimationClip* find(std::uint32_t id) const;
+
+    std::size_t size() const { return clips.size(); }
+
+private:
+    AnimationLibrary() = default;
+    AnimationLibrary(const AnimationLibrary&) = delete;
+    AnimationLibrary& operator=(const AnimationLibrary&) = delete;
+
+    std::map<std::string, AnimationClip> clips;
+    std::map<std::uint32_t, const AnimationClip*> clipsById;
+
+    const AnimationClip* add(AnimationClip&& clip);
+};
+
+#endif // ANIMATION_HPP
@@ -4,23 +4,167 @@
 #define ASSETMANAGER_HPP
 
 #include "SFML/Graphics.hpp"
-#include <map>
+#include "AssetPack.hpp"
+#include <cstdint>
+#include <deque>
 #include <vector>
 #include <string>
-#include <iostream>
+#include <string_view>
 #include <stdexcept>
 
+// Hash FNV-1a de 32 bits, calculado em compilao para os nomes conhecidos
+constexpr std::uint32_t assetHash(std::string_view name) {
+    std::uint32_t hash = 2166136261u;
+    for (char c : name) {
+        hash ^= static_cast<std::uint8_t>(c);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Nome de um asset j convertido em hash (o nome fica para mensagens de erro)
+struct AssetId {
+    std::uint32_t hash;
+    std::string_view name;
+
+    constexpr AssetId(std::string_view assetName) : hash(assetHash(assetName)), name(assetName) {}
+    constexpr AssetId(const char* assetName) : AssetId(std::string_view(assetName)) {}
+};
+
+// Registo dos assets do jogo: cada nome existe uma s vez, em compilao
+namespace AssetIds {
+    inline constexpr AssetId IsaacDown{ "I_Down" };
+    inline constexpr AssetId IsaacUp{ "I_Up" };
+    inline constexpr AssetId IsaacLeft{ "I_Left" };
+    inline constexpr AssetId IsaacRight{ "I_Right" };
+    inline constexpr AssetId DemonDown{ "D_Down" };
+    inline constexpr AssetId DemonUp{ "D_Up" };
+    inline constexpr AssetId DemonLeft{ "D_Left" };
+    inline constexpr AssetId DemonRight{ "D_Right" };
+    inline constexpr AssetId Bishop{ "Bishop" };
+    inline constexpr AssetId TearAtlas{ "TearAtlas" };
+    inline constexpr AssetId ChubbySheet{ "ChubbySheet" };
+    inline constexpr AssetId MonstroSheet{ "MonstroSheet" };
+    inline constexpr AssetId Door{ "Door" };
+    inline constexpr AssetId HeartFull{ "HeartF" };
+    inline constexpr AssetId HeartHalf{ "HeartH" };
+    inline constexpr AssetId HeartEmpty{ "HeartE" };
+    inline constexpr AssetId BasementCorner{ "BasementCorner" };
+    inline constexpr AssetId MenuPlay{ "MenuPlay" };
+    inline constexpr AssetId MenuExit{ "MenuExit" };
+    inline constexpr AssetId MenuBackground{ "MenuBackground" };
+}
+
+constexpr std::uint32_t kInvalidAsset = 0xFFFFFFFFu;
+
+// ndice direto no array do AssetManager, resolvido uma vez a partir do AssetId
+struct TextureHandle {
+    std::uint32_t index = kInvalidAsset;
+    explicit operator bool() const { return index != kInvalidAsset; }
+};
+
+struct AnimationHandle {
+    std::uint32_t index = kInvalidAsset;
+    explicit operator bool() const { return index != kInvalidAsset; }
+};
+
+// Residncia de um asset: quanto ocupa na VRAM, quem o est a usar e quando foi
+// usado pela ltima vez. Os assets sem referncias so os candidatos a sair.
+struct AssetResidency {
+    std::vector<std::string> sources;   // Ficheiros para recarregar (1 textura ou os frames)
+    std::uint64_t bytes = 0;            // RGBA (largura * altura * 4)
+    std::uint64_t lastUse = 0;          // Relgio LRU
+    int refs = 0;
+    bool resident = false;
+};
+
+// Pedido de uma animao para o carregamento em lote
+struct AnimationRequest {
+    AssetId id;
+    std::string folderName;
+    std::string prefix;
+    int totalFrames = 0;
+    std::string suffix;
+};
+
+class AssetManager;
+
+// Referncia contada a um asset (RAII): enquanto existir, o asset no  despejado
+class AssetLease {
+public:
+    AssetLease() = default;
+    AssetLease(AssetManager& manager, TextureHandle handle);
+    AssetLease(AssetManager& manager, AnimationHandle handle);
+    AssetLease(AssetLease&& other) noexcept;
+    AssetLease& operator=(AssetLease&& other) noexcept;
+    AssetLease(const AssetLease&) = delete;
+    AssetLease& operator=(const AssetLease&) = delete;
+    ~AssetLease() { reset(); }
+
+    void reset();
+
+private:
+    AssetManager* owner = nullptr;
+    std::uint32_t index = kInvalidAsset;
+    bool animation = false;
+};
+
 class AssetManager {
 private:
-    // Mapas para guardar todas as texturas e vetores de animao
-    std::map<std::string, sf::Texture> textures;
-    static std::map<std::string, std::vector<sf::Texture>> animationSets;
+    // Arrays densos (deque: as referncias entregues aos sprites nunca mudam de stio)
+    // e, em paralelo, o hash e o nome de cada entrada
+    std::deque<sf::Texture> textures;
+    std::vector<std::uint32_t> textureHashes;
+    std::vector<std::string> textureNames;
+
+    std::deque<std::vector<sf::Texture>> animationSets;
+    std::vector<std::uint32_t> animationHashes;
+    std::vector<std::string> animationNames;
+
+    // Residncia (em paralelo com os arrays acima) e oramento de VRAM
+    std::vector<AssetResidency> textureResidency;
+    std::vector<AssetResidency> animationResidency;
+    std::uint64_t residentBytes = 0;
+    std::uint64_t budgetBytes = 0;      // 0 = sem limite
+    std::uint64_t useClock = 0;
+    bool budgetWarned = false;
+
+    // Pack montado (opcional): as imagens que l esto no passam pelo PNG
+    AssetPack pack;
+    std::vector<std::uint8_t> decodeBuffer;
+    int packLoads = 0;
+    int fileLoads = 0;
 
     // Construtor privado para garantir o Singleton
     AssetManager() = default;
     AssetManager(const AssetManager&) = delete;
     AssetManager& operator=(const AssetManager&) = delete;
 
+    static std::uint32_t indexOf(const std::vector<std::uint32_t>& hashes, std::uint32_t hash);
+    static void checkCollision(const std::vector<std::string>& names, std::uint32_t index, AssetId id);
+
+    // Frame descodificado num worker (PNG -> sf::Image, ou RGBA do pack)
+    struct DecodedFrame {
+        sf::Image image;
+        std::vector<std::uint8_t> rgba;
+        const std::uint8_t* pixels = nullptr;
+        sf::Vector2u size;
+        double decodeMs = 0.0;
+        bool ok = false;
+    };
+
+    // Descodifica 'files' em paralelo no JobSystem (s CPU, sem tocar na GPU).
+    // uploadFrame envia depois cada frame na thread principal, pela ordem, e lana
+    // "Asset Not Found" com o nome do ficheiro se a descodificao tiver falhado.
+    void decodeFrames(const std::vector<std::string>& files, std::vector<DecodedFrame>& decoded);
+    void uploadFrame(const std::string& filename, DecodedFrame& frame, sf::Texture& texture);
+    AnimationHandle storeAnimation(AssetId id, std::vector<sf::Texture>&& frames, std::vector<std::string>&& sources, std::uint64_t bytes);
+
+    void track(std::vector<AssetResidency>& residency, std::uint32_t index, std::vector<std::string> sources, std::uint64_t bytes);
+    void reloadTexture(std::uint32_t index);
+    void reloadAnimation(std::uint32_t index);
+    void evict(bool animation, std::uint32_t index);
+
 public:
     // Mtodo para obter a nica instncia (Singleton)
     static AssetManager& getInstance() {
@@ -28,22 +172,69 @@ public:
         return instance;
     }
 
-    // Carrega uma nica textura
-    bool loadTexture(const std::string& name, const std::string& filename);
+    // Monta o pack de assets; se falhar, tudo continua a vir dos ficheiros soltos
+    bool mountPack(const std::string& path);
+    bool hasPack() const { return pack.isOpen(); }
 
-    // Carrega uma animao completa
-    void loadAnimation(
-        const std::string& setPrefix,
+    // L 'filename' do pack (se l estiver) ou do disco
+    bool loadTextureFile(const std::string& filename, sf::Texture& texture);
+    int texturesFromPack() const { return packLoads; }
+    int texturesFromFiles() const { return fileLoads; }
+
+    // Carrega uma nica textura (o mesmo id substitui a textura no mesmo ndice)
+    TextureHandle loadTexture(AssetId id, const std::string& filename);
+
+    // Carrega uma animao completa (o mesmo id recarrega os frames no stio; o
+    // nmero de frames tem de ser o mesmo, seno lana)
+    AnimationHandle loadAnimation(
+        AssetId id,
         const std::string& folderName,
         const std::string& prefix,
         int totalFrames,
         const std::string& suffix);
 
-    // Obter uma nica textura por nome
-    sf::Texture& getTexture(const std::string& name);
+    // Carrega vrias animaes de uma vez: todos os frames de todos os sets so
+    // descodificados em paralelo e enviados para a GPU pela ordem dos pedidos
+    std::vector<AnimationHandle> loadAnimations(const std::vector<AnimationRequest>& requests);
+
+    // Resolve o nome para um handle (faz-se uma vez; lana se no existir)
+    TextureHandle findTexture(AssetId id) const;
+    AnimationHandle findAnimation(AssetId id) const;
+
+    // Acesso por handle: um ndice (e recarrega se tiver sido despejado)
+    sf::Texture& get(TextureHandle handle) {
+        AssetResidency& state = textureResidency[handle.index];
+        state.lastUse = ++useClock;
+        if (!state.resident) reloadTexture(handle.index);
+        return textures[handle.index];
+    }
+    std::vector<sf::Texture>& get(AnimationHandle handle) {
+        AssetResidency& state = animationResidency[handle.index];
+        state.lastUse = ++useClock;
+        if (!state.resident) reloadAnimation(handle.index);
+        return animationSets[handle.index];
+    }
+
+    // Contagem de referncias (normalmente via AssetLease). retain garante residncia.
+    void retain(TextureHandle handle);
+    void retain(AnimationHandle handle);
+    void release(TextureHandle handle);
+    void release(AnimationHandle handle);
+
+    // Oramento de VRAM. trim() despeja, do menos usado para o mais usado, os assets
+    // sem referncias at caber no oramento. Os objetos sf::Texture continuam no
+    // mesmo stio (ficam vazios), por isso os sprites que os apontam no se partem.
+    // S chamar quando nenhum worker estiver a mexer em sprites (ex.: troca de sala).
+    void setBudget(std::uint64_t bytes) { budgetBytes = bytes; budgetWarned = false; }
+    void trim();
+    std::uint64_t getResidentBytes() const { return residentBytes; }
+
+    // Relatrio de debug: cada asset, bytes, referncias e se est residente
+    void logResidencyReport() const;
 
-    // Obter um vetor de texturas de uma animao carregada
-    std::vector<sf::Texture>& getAnimationSet(const std::string& setPrefix);
+    // Atalhos para cdigo de arranque (resolve + acesso)
+    sf::Texture& getTexture(AssetId id) { return get(findTexture(id)); }
+    std::vector<sf::Texture>& getAnimationSet(AssetId id) { return get(findAnimation(id)); }
 };
 
 #endif // ASSETMANAGER_HPP
\ No newline at end of file
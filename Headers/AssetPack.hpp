@@ -0,0 +1,76 @@
+#ifndef ASSETPACK_HPP
+#define ASSETPACK_HPP
+
+#include "SFML/Graphics.hpp"
+#include "MappedFile.hpp"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Formato do pack (little-endian):
+//   PackHeader | dados das imagens (alinhados a 16) | nomes | indice (PackEntry[], ordenado por hash)
+// As imagens vao ja descodificadas em RGBA: cru ou com RLE de pixeis (sprites com
+// muito transparente), que se descodifica com memcpy quase so.
+constexpr char kAssetPackMagic[4] = { 'I', 'P', 'A', 'K' };
+constexpr std::uint32_t kAssetPackVersion = 1;
+
+enum class PackCodec : std::uint32_t {
+    Raw = 0,        // RGBA tal e qual
+    PixelRle = 1    // Blocos: cabecalho (bit 7 = repeticao) + 1..128 pixeis
+};
+
+struct PackHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t entryCount;
+    std::uint32_t reserved;
+    std::uint64_t indexOffset;
+    std::uint64_t namesOffset;
+};
+
+struct PackEntry {
+    std::uint32_t hash;         // assetHash do caminho (ex.: "Images/Tears/bulletatlas.png")
+    std::uint32_t nameOffset;   // Relativo a namesOffset (para confirmar colisoes)
+    std::uint32_t nameLength;
+    std::uint32_t width;
+    std::uint32_t height;
+    PackCodec codec;
+    std::uint64_t dataOffset;
+    std::uint64_t dataSize;
+};
+
+static_assert(sizeof(PackHeader) == 32 && sizeof(PackEntry) == 40, "layout do pack mudou");
+
+// RLE de pixeis RGBA (4 bytes); devolvem false se os dados nao baterem certo
+void encodePixelRle(const std::uint8_t* rgba, std::size_t pixelCount, std::vector<std::uint8_t>& out);
+bool decodePixelRle(const std::uint8_t* data, std::size_t size, std::uint8_t* rgba, std::size_t pixelCount);
+
+// Leitura de um pack mapeado em memoria. So o indice (limites e tamanhos das
+// imagens) e validado ao abrir; as imagens so saem do disco quando sao pedidas.
+class AssetPack {
+public:
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const { return entries != nullptr; }
+    std::size_t size() const { return count; }
+
+    const PackEntry* find(std::string_view name) const;
+    std::string_view nameOf(const PackEntry& entry) const;
+
+    // RGBA descodificado para 'rgba' (redimensionado para width * height * 4)
+    bool decode(const PackEntry& entry, std::vector<std::uint8_t>& rgba) const;
+
+    // Cria a textura a partir da entrada. Imagens cruas vao diretas do mapeamento
+    // para a GPU; 'scratch' so e usado para descodificar as comprimidas.
+    bool loadTexture(const PackEntry& entry, sf::Texture& texture, std::vector<std::uint8_t>& scratch) const;
+
+private:
+    MappedFile file;
+    const PackEntry* entries = nullptr;
+    const char* names = nullptr;
+    std::uint32_t count = 0;
+};
+
+#endif // ASSETPACK_HPP
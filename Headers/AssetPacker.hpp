@@ -0,0 +1,11 @@
+#ifndef ASSETPACKER_HPP
+#define ASSETPACKER_HPP
+
+#include <string>
+
+// Gera o pack de assets a partir de todos os PNG de 'imagesDir' e compara o
+// arranque a frio com o pack e com os ficheiros soltos.
+// Executar com: "The Game.exe" --pack [Images] [assets.pak]
+int runAssetPacker(const std::string& imagesDir, const std::string& outputPath);
+
+#endif // ASSETPACKER_HPP
@@ -0,0 +1,39 @@
+#ifndef AURA_HPP
+#define AURA_HPP
+
+#include "SFML/Graphics.hpp"
+#include <cstdint>
+#include <vector>
+
+class EnemyBase;
+class CrowdSteering;
+class EventBus;
+
+enum class AuraKind : std::uint8_t {
+    Heal,   // Cura 'magnitude' de vida
+    Haste,  // Velocidade * (1 + magnitude) durante 'duration'
+    Slow    // Velocidade * (1 - magnitude) durante 'duration'
+};
+
+// Efeito de area publicado por um emissor durante o update. As auras do tick
+// sao resolvidas todas de uma vez pela sala, depois da IA, contra o indice
+// espacial da multidao.
+struct AuraEffect {
+    AuraKind kind = AuraKind::Heal;
+    const EnemyBase* source = nullptr;
+    sf::Vector2f center;
+    float radius = 0.f;              // 0 = sala inteira
+    float magnitude = 0.f;
+    float duration = 0.f;
+    std::uint8_t targets = 0;        // Mascara AuraTargets
+    bool affectsSource = false;
+};
+
+// Aplica 'auras' pela ordem em que foram publicadas. 'agents' tem a mesma ordem
+// que a fotografia de 'crowd' (o indice do agente e o indice no vetor). Com 'events'
+// as curas vao para o bus (resolvidas na fase de eventos do tick); sem bus (salas
+// em segundo plano) sao aplicadas logo.
+void resolveAuras(const std::vector<AuraEffect>& auras, const CrowdSteering& crowd,
+    const std::vector<EnemyBase*>& agents, EventBus* events);
+
+#endif // AURA_HPP
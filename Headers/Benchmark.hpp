@@ -0,0 +1,8 @@
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+// Benchmarks de performance dos subsistemas do jogo.
+// Executar com: "The Game.exe" --bench
+void runBenchmarks();
+
+#endif // BENCHMARK_HPP
@@ -0,0 +1,75 @@
+#ifndef BOSSTIMELINE_HPP
+#define BOSSTIMELINE_HPP
+
+#include "SFML/Graphics.hpp"
+#include "GameConfig.hpp"
+#include "EntityState.hpp"
+#include <cstdint>
+#include <vector>
+
+// O que aconteceu num update: entrada num segmento (mudar clip) ou um evento
+// da timeline. Exatamente um dos ponteiros esta preenchido.
+struct BossOutput {
+    const BossSegmentConfig* segment = nullptr;
+    const BossEventConfig* event = nullptr;
+};
+
+// Maquina de estados de um boss a correr uma BossTimelineConfig. Nao mexe em
+// sprites: so guarda posicoes/escala e diz o que mudou, para correr sem janela
+// (balanceamento) ou ser aplicada a um sprite pelo boss.
+class BossBrain {
+public:
+    explicit BossBrain(const BossTimelineConfig& timeline);
+
+    void setGroundPosition(sf::Vector2f position);
+
+    // Avanca 'deltaTime' e acrescenta a 'out' as mudancas de segmento e os eventos.
+    // 'healthFraction' = vida / vida maxima (condicoes das transicoes).
+    void update(float deltaTime, sf::Vector2f playerPosition, float healthFraction,
+        std::uint32_t& rngState, std::vector<BossOutput>& out);
+
+    const BossStateConfig& currentState() const { return timeline->states[state]; }
+    int stateIndex() const { return state; }
+    float stateTime() const { return timer; }
+
+    sf::Vector2f groundPosition() const { return ground; }
+    sf::Vector2f bodyPosition() const { return body; }
+    sf::Vector2f targetPosition() const { return target; }
+    // Multiplicador de escala; x negativo = virado para a direita
+    sf::Vector2f scaleFactor() const { return scale; }
+
+    // O que mudou no ultimo update (so nesse caso e preciso tocar no sprite)
+    bool bodyChanged() const { return bodyDirty; }
+    bool scaleChanged() const { return scaleDirty; }
+
+    // Save da run, nos slots do EnemyState do boss:
+    // timers[0] = tempo no estado; points = { chao, corpo, alvo, direcao do salto, escala };
+    // values[0..4] = { estado, proximo evento, segmento ativo, ultima acao, started }
+    void save(EnemyState& state) const;
+    void load(const EnemyState& state);
+
+private:
+    void enterState(int index, sf::Vector2f playerPosition, std::vector<BossOutput>& out);
+    void fireEvents(sf::Vector2f playerPosition, std::vector<BossOutput>& out);
+    int pickTransition(float healthFraction, std::uint32_t& rngState) const;
+    void applySegment(const BossSegmentConfig& segment, float deltaTime, sf::Vector2f playerPosition);
+    void setBody(sf::Vector2f position);
+
+    const BossTimelineConfig* timeline;
+    bool started = false;
+    int state = 0;
+    float timer = 0.f;
+    std::size_t nextEvent = 0;
+    int activeSegment = -1;
+    int lastAction = -1;
+
+    sf::Vector2f ground;
+    sf::Vector2f body;
+    sf::Vector2f target;
+    sf::Vector2f moveDir;
+    sf::Vector2f scale{ 1.f, 1.f };
+    bool bodyDirty = false;
+    bool scaleDirty = false;
+};
+
+#endif // BOSSTIMELINE_HPP
@@ -0,0 +1,59 @@
+#ifndef BULLETPATTERN_HPP
+#define BULLETPATTERN_HPP
+
+#include "SFML/Graphics.hpp"
+#include "GameConfig.hpp"
+#include "enemy.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Padrao de disparo (anel, leque, espiral ou dispersao aleatoria).
+// As direcoes de cada projetil sao calculadas uma vez na construcao; numa rajada
+// so ha um cos/sin para rodar a tabela para a mira (e para o passo da espiral).
+class BulletPattern {
+public:
+    explicit BulletPattern(const BulletPatternConfig& config);
+
+    const BulletPatternConfig& getConfig() const { return config; }
+    int count() const { return config.count; }
+
+    // Acrescenta uma rajada a 'out'. Cada projetil e uma copia de 'prototype'
+    // (textura, rect, origem e escala ja prontos). 'aimDegrees' e o angulo da mira
+    // em coordenadas de ecra (atan2(dy, dx)), ignorado se o padrao nao for apontado.
+    // 'volley' conta as rajadas (so a espiral usa). Devolve quantos projeteis saiu.
+    std::size_t emit(const EnemyProjectile& prototype, const HitboxConfig& hitboxShape,
+        sf::Vector2f origin, float aimDegrees, int volley, std::uint32_t& rngState,
+        std::vector<EnemyProjectile>& out) const;
+
+private:
+    BulletPatternConfig config;
+    std::vector<sf::Vector2f> directions; // Vetores unitarios (angulo relativo a mira)
+    std::vector<float> angles;            // Os mesmos angulos em graus (rotacao dos sprites)
+    int speedSteps = 1;
+};
+
+// Padroes carregados do config ("bullet_patterns"), pela mesma ordem,
+// para os indices resolvidos nos arquetipos (pattern_id) baterem certo.
+class BulletPatternLibrary {
+public:
+    static BulletPatternLibrary& getInstance();
+
+    void build(const std::vector<BulletPatternConfig>& configs);
+
+    // nullptr se nao existir
+    const BulletPattern* find(const std::string& name) const;
+    const BulletPattern* get(int id) const;
+
+    std::size_t size() const { return patterns.size(); }
+
+private:
+    BulletPatternLibrary() = default;
+    BulletPatternLibrary(const BulletPatternLibrary&) = delete;
+    BulletPatternLibrary& operator=(const BulletPatternLibrary&) = delete;
+
+    std::vector<BulletPattern> patterns;
+};
+
+#endif // BULLETPATTERN_HPP
@@ -8,9 +8,11 @@ enum class FaceDir { Up, Down, Left, Right };
 
 class Chubby : public EnemyBase {
 public:
-    Chubby(sf::Texture& sheet, sf::Texture& projSheet);
+    // 'archetype' e copiado para a entidade (registo POD, sem lookups depois do spawn)
+    Chubby(const EnemyArchetype& archetype, sf::Texture& sheet, sf::Texture& projSheet);
 
     void update(float deltaTime, sf::Vector2f playerPos, const sf::FloatRect& gameBounds) override;
+    std::uint8_t getAuraTargetBit() const override { return AuraTargets::Chubby; }
     void draw(sf::RenderWindow& window) override;
     void setPosition(const sf::Vector2f& pos) override;
     sf::FloatRect getGlobalBounds() const override;
@@ -22,25 +24,45 @@ public:
 
     bool BoomerangActive() const { return boomerangActive; }
     sf::FloatRect getBoomerangBounds() const;
+    // Deslocamento do bumerangue no ultimo tick (colisao continua)
+    sf::Vector2f getBoomerangMotion() const { return boomerangStep; }
+
+    void saveState(EnemyState& state, std::vector<ProjectileState>& projectiles) const override;
+    void loadState(const EnemyState& state, const ProjectileState* projectiles) override;
 
 private:
+    EnemyArchetype archetype;
+
+    // Clips partilhados resolvidos no spawn; os arrays sao indexados por dirIndex() (lado, baixo, cima)
+    const AnimationClip* clipIdle = nullptr;
+    const AnimationClip* clipWalk = nullptr;
+    const AnimationClip* clipWindup[3] = {};
+    const AnimationClip* clipThrow[3] = {};
+    const AnimationClip* clipBoomerang[3] = {};
+    const AnimationClip* clipReturn[3] = {};
+
     ChubbyState state;
     FaceDir faceDir;
     sf::Vector2f moveDir;
     float stateTimer;
-    float animTimer;
-    int animFrame;
     float scaleFactor;
 
     // Bumerangue
     std::optional<sf::Sprite> projectileSprite;
     sf::Vector2f projectilePos;
     sf::Vector2f projectileVel;
+    sf::Vector2f boomerangStep;
+    HitboxConfig boomerangHitboxShape;
+    sf::FloatRect boomerangHitbox;
     bool boomerangActive;
     bool boomerangReturn;
     float distanceWalked;
 
-    void updateAnimation(float deltaTime);
+    int dirIndex() const;
+    sf::IntRect frameRect(const AnimationClip* clip, int frame = 0) const;
+    void showClip(const AnimationClip* clip);
+    void updateAnimation();
+    void applyFacing();
     void handleAttackSequence(float deltaTime, sf::Vector2f playerPos);
     void launchBoomerang();
     void updateBoomerang(float deltaTime);
@@ -0,0 +1,93 @@
+#ifndef COLLISION_HPP
+#define COLLISION_HPP
+
+#include "SFML/Graphics.hpp"
+#include "Utils.hpp"
+#include "GameConfig.hpp"
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Lote de retangulos em formato SoA (min/max separados) para os testes em SIMD.
+// Cada array tem padding ate multiplo de 8 com retangulos vazios, assim os
+// kernels SSE/AVX podem ler blocos completos sem tratar o resto a parte.
+class RectBatch {
+public:
+    void clear();
+    void reserve(std::size_t count);
+    void push(const sf::FloatRect& rect);
+
+    // Desativa um retangulo (ex.: inimigo morreu a meio do loop de lagrimas)
+    void disable(std::size_t index);
+
+    // Retangulo guardado na posicao 'index'
+    sf::FloatRect get(std::size_t index) const;
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    const float* minXData() const { return minX.data(); }
+    const float* minYData() const { return minY.data(); }
+    const float* maxXData() const { return maxX.data(); }
+    const float* maxYData() const { return maxY.data(); }
+
+private:
+    void pad();
+
+    std::vector<float> minX, minY, maxX, maxY;
+    std::size_t count = 0;
+};
+
+// Hitbox de uma entidade em 'position' (centro = posicao + offset do config)
+sf::FloatRect makeHitbox(sf::Vector2f position, const HitboxConfig& shape);
+
+// Ajusta 'position' para que a hitbox fique dentro de 'bounds'
+sf::Vector2f clampToBounds(sf::Vector2f position, const HitboxConfig& shape, const sf::FloatRect& bounds);
+
+// Um contra muitos: preenche 'mask' com 1 para cada retangulo do lote que intersecta 'rect'.
+// Devolve o numero de colisoes.
+std::size_t collisionMask(const sf::FloatRect& rect, const RectBatch& batch, std::vector<std::uint8_t>& mask);
+
+// Um contra muitos: indice do primeiro retangulo que intersecta 'rect', ou -1.
+int firstCollision(const sf::FloatRect& rect, const RectBatch& batch);
+
+// Muitos contra muitos: para cada retangulo de 'a', o indice do primeiro em 'b' (ou -1).
+void firstCollisions(const RectBatch& a, const RectBatch& b, std::vector<int>& firstHit);
+
+// --- Colisao continua (swept AABB) ---
+// 'rect' e a caixa no inicio do tick e 'motion' o deslocamento feito durante o tick.
+// Devolve true se tocar em 'target' e escreve em 'timeOfImpact' a fracao [0, 1]
+// do movimento em que o contacto comeca. Nao depende da taxa de frames.
+bool sweptCollision(const sf::FloatRect& rect, sf::Vector2f motion, const sf::FloatRect& target, float& timeOfImpact);
+
+// Caixa que cobre todo o varrimento (usada como broad phase no lote)
+sf::FloatRect sweptBounds(const sf::FloatRect& rect, sf::Vector2f motion);
+
+// Alvo do lote atingido primeiro durante o varrimento (menor tempo de impacto), ou -1
+int firstSweptCollision(const sf::FloatRect& rect, sf::Vector2f motion, const RectBatch& batch, std::vector<std::uint8_t>& scratch);
+
+// Versao escalar (referencia para o benchmark e para CPUs sem SSE)
+std::size_t collisionMaskScalar(const sf::FloatRect& rect, const RectBatch& batch, std::vector<std::uint8_t>& mask);
+
+// Nome do caminho SIMD compilado ("AVX", "SSE2" ou "Scalar")
+const char* collisionBackendName();
+
+// Remove os elementos marcados na mascara, mantendo a ordem dos restantes
+template <typename T>
+void eraseMasked(std::vector<T>& items, const std::vector<std::uint8_t>& mask) {
+    std::size_t write = 0;
+    for (std::size_t read = 0; read < items.size(); ++read) {
+        if (mask[read]) continue;
+        if (write != read) items[write] = std::move(items[read]);
+        ++write;
+    }
+    items.erase(items.begin() + write, items.end());
+}
+
+// Remove os projeteis marcados como 'expiring' (ja passaram pelas colisoes do tick)
+template <typename T>
+void eraseExpiring(std::vector<T>& items) {
+    std::erase_if(items, [](const T& item) { return item.expiring; });
+}
+
+#endif // COLLISION_HPP
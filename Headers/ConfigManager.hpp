@@ -31,8 +31,7 @@ public:
             std::ifstream file(filepath);
 
             if (!file.is_open()) {
-                std::cerr << "ERRO: Não foi possível abrir '" << filepath << "'" << std::endl;
-                std::cerr << "   Usando valores padrão..." << std::endl;
+                LOG_ERROR(LogCategory::Config, "Não foi possível abrir '", filepath, "', usando valores padrão");
                 config = GameConfig();  // Usa defaults das structs
                 loaded = true;
                 return false;
@@ -43,31 +42,28 @@ public:
             currentFilepath = filepath;
             loaded = true;
 
-            std::cout << "  Config carregado: " << filepath << std::endl;
+            LOG_INFO(LogCategory::Config, "Config carregado: ", filepath);
             printLoadedConfig();
 
             return true;
 
         }
         catch (const json::parse_error& e) {
-            std::cerr << "  ERRO ao parsear JSON: " << e.what() << std::endl;
-            std::cerr << "   Linha: " << e.byte << std::endl;
-            std::cerr << "   Usando valores padrão..." << std::endl;
+            LOG_ERROR(LogCategory::Config, "ao parsear JSON (byte ", e.byte, "): ", e.what(), ", usando valores padrão");
             config = GameConfig();
             loaded = true;
             return false;
 
         }
         catch (const json::exception& e) {
-            std::cerr << "  ERRO JSON: " << e.what() << std::endl;
-            std::cerr << "   Usando valores padrão..." << std::endl;
+            LOG_ERROR(LogCategory::Config, "JSON: ", e.what(), ", usando valores padrão");
             config = GameConfig();
             loaded = true;
             return false;
 
         }
         catch (const std::exception& e) {
-            std::cerr << "  ERRO: " << e.what() << std::endl;
+            LOG_ERROR(LogCategory::Config, e.what());
             config = GameConfig();
             loaded = true;
             return false;
@@ -104,35 +100,15 @@ public:
     void printLoadedConfig() const {
         if (!loaded) return;
 
-        std::cout << "\n|====================================" << std::endl;
-        std::cout << "|   CONFIGURACOES CARREGADAS         " << std::endl;
-        std::cout << "|====================================" << std::endl;
-        std::cout << "| Player:                            " << std::endl;
-        std::cout << "|   Health: " << std::setw(4) << config.player.stats.initial_health
-            << "                         " << std::endl;
-        std::cout << "|   Damage: " << std::setw(4) << config.player.stats.damage
-            << "                         " << std::endl;
-        std::cout << "|   Speed:  " << std::setw(6) << std::setprecision(1) << std::fixed
-            << config.player.stats.speed << "                     " << std::endl;
-        std::cout << "|                                    " << std::endl;
-        std::cout << "| Demon:                             " << std::endl;
-        std::cout << "|   Health: " << std::setw(4) << config.demon.stats.initial_health
-            << "                         " << std::endl;
-        std::cout << "|   Damage: " << std::setw(4) << config.demon.stats.damage
-            << "                         " << std::endl;
-        std::cout << "|   Speed:  " << std::setw(6) << std::setprecision(1)
-            << config.demon.stats.speed << "                     " << std::endl;
-        std::cout << "|                                    " << std::endl;
-        std::cout << "| Bishop:                            " << std::endl;
-        std::cout << "|   Health: " << std::setw(4) << config.bishop.stats.initial_health
-            << "                         " << std::endl;
-        std::cout << "|   Damage: " << std::setw(4) << config.bishop.stats.damage
-            << "                         " << std::endl;
-        std::cout << "|   Heal:   " << std::setw(4) << config.bishop.heal.amount
-            << "                         " << std::endl;
-        std::cout << "|====================================\n" << std::endl;
-        std::cout << "DEBUG: Player Attack Cooldown Carregado: "
-            << config.player.attack.cooldown << std::endl;
+        LOG_INFO(LogCategory::Config, "Player: vida ", config.player.stats.initial_health,
+            ", dano ", config.player.stats.damage, ", velocidade ", config.player.stats.speed);
+        LOG_INFO(LogCategory::Config, "Demon: vida ", config.demon.stats.initial_health,
+            ", dano ", config.demon.stats.damage, ", velocidade ", config.demon.stats.speed);
+        LOG_INFO(LogCategory::Config, "Bishop: vida ", config.bishop.stats.initial_health,
+            ", dano ", config.bishop.stats.damage, ", cura ", config.bishop.heal.amount);
+        LOG_INFO(LogCategory::Config, "Arquetipos: ", config.archetypes.records.size(),
+            ", padroes de disparo: ", config.bullet_patterns.size());
+        LOG_DEBUG(LogCategory::Config, "Player attack cooldown: ", config.player.attack.cooldown);
     }
 };
 
@@ -0,0 +1,69 @@
+#ifndef CROWDSTEERING_HPP
+#define CROWDSTEERING_HPP
+
+#include "SFML/Graphics.hpp"
+#include "GameConfig.hpp"
+#include "SpatialHash.hpp"
+#include "ObstacleGrid.hpp"
+#include <vector>
+
+// Steering de grupo dos inimigos de uma sala: separacao entre vizinhos, chegada
+// suave ao alvo e desvio de paredes/obstaculos. A sala tira uma fotografia das
+// posicoes (begin/add/finish) antes da IA; durante o update, que pode correr em
+// paralelo, os inimigos so leem a fotografia, por isso o resultado nao depende
+// da ordem nem do numero de threads. Os vizinhos vem do SpatialHash (O(n)); a
+// mesma fotografia serve de indice espacial para resolver as auras.
+class CrowdSteering {
+public:
+    void configure(const SteeringConfig& config);
+
+    void begin(const sf::FloatRect& bounds, const ObstacleGrid* obstacles);
+    int add(sf::Vector2f position, float radius);
+    void finish();
+
+    // Empurrao para longe dos vizinhos que se sobrepoem (cresce com a sobreposicao)
+    sf::Vector2f separation(int agent) const;
+
+    // Fator de velocidade [0, 1] pela distancia ao alvo (0 dentro de arrival_radius)
+    float arrival(float distance) const;
+
+    // Desvio lateral quando a antena a frente bate numa borda ou num obstaculo
+    sf::Vector2f avoidWalls(int agent, sf::Vector2f heading) const;
+
+    // Velocidade final (comprimento <= 1): 'desired' (ja com a chegada aplicada)
+    // mais separacao e desvio de paredes
+    sf::Vector2f steer(int agent, sf::Vector2f desired) const;
+
+    // Ha um vizinho encostado na direcao 'direction'? (para quem anda em linha reta)
+    bool blockedAhead(int agent, sf::Vector2f direction) const;
+
+    // Chama fn(agent) para cada agente cujo circulo toca o circulo (center, radius)
+    template <typename Fn>
+    void forEachInRadius(sf::Vector2f center, float radius, Fn&& fn) const;
+
+    std::size_t size() const { return positions.size(); }
+
+private:
+    template <typename Fn>
+    void forEachNeighbor(int agent, Fn&& fn) const;
+
+    SteeringConfig settings;
+    sf::FloatRect area;
+    const ObstacleGrid* walls = nullptr;
+
+    std::vector<sf::Vector2f> positions;
+    std::vector<float> radii;
+    float maxRadius = 0.f;
+    SpatialHash hash;
+};
+
+template <typename Fn>
+void CrowdSteering::forEachInRadius(sf::Vector2f center, float radius, Fn&& fn) const {
+    hash.query(center, radius + maxRadius, [&](std::uint32_t agent) {
+        const sf::Vector2f offset = positions[agent] - center;
+        const float reach = radius + radii[agent];
+        if (offset.x * offset.x + offset.y * offset.y <= reach * reach) fn(static_cast<int>(agent));
+        });
+}
+
+#endif // CROWDSTEERING_HPP
@@ -0,0 +1,110 @@
+#ifndef DUNGEONCACHE_HPP
+#define DUNGEONCACHE_HPP
+
+#include "DungeonGenerator.hpp"
+#include "GameConfig.hpp"
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Formato de uma planta em cache (little-endian):
+//   DungeonCacheHeader | CachedRoom[roomCount] | CachedDoor[doorCount] | CachedSpawn[spawnCount]
+// O ficheiro e lido de uma vez e copiado registo a registo, sem parsing.
+constexpr char kDungeonCacheMagic[4] = { 'I', 'D', 'N', 'G' };
+constexpr std::uint32_t kDungeonCacheFormat = 1;
+
+// Contagens e metadados da planta (tambem no cabecalho do save da run)
+struct CachedLayoutCounts {
+    std::uint16_t roomCount;
+    std::uint16_t doorCount;
+    std::uint16_t spawnCount;
+    std::int16_t treasureRoom;
+    std::int16_t bossRoom;
+    std::uint8_t bossDistance;
+    std::uint8_t loops;
+    std::uint8_t attempts;
+    std::uint8_t satisfied;
+    std::uint8_t reserved[2];
+};
+
+struct DungeonCacheHeader {
+    char magic[4];
+    std::uint32_t format;
+    std::uint32_t generatorVersion;
+    std::uint32_t fingerprint;      // Config de que a planta depende (ver layoutFingerprint)
+    std::uint32_t seed;
+    std::int32_t floorIndex;
+    CachedLayoutCounts layout;
+};
+
+struct CachedRoom {
+    std::int16_t x;
+    std::int16_t y;
+    std::uint8_t type;
+    std::uint8_t cornerVariant;
+    std::uint16_t spawnCount;       // Os spawns vem seguidos, pela ordem das salas
+    std::uint32_t seed;
+};
+
+struct CachedDoor {
+    std::uint16_t from;
+    std::uint16_t to;
+    std::uint8_t direction;
+    std::uint8_t type;
+    std::uint8_t reserved[2];
+};
+
+struct CachedSpawn {
+    std::uint8_t kind;
+    std::uint8_t reserved;
+    std::uint16_t archetype;
+    float x;
+    float y;
+};
+
+static_assert(sizeof(CachedLayoutCounts) == 16 && sizeof(DungeonCacheHeader) == 40 && sizeof(CachedRoom) == 12 &&
+    sizeof(CachedDoor) == 8 && sizeof(CachedSpawn) == 12, "layout da cache mudou");
+
+// Registos POD copiados tal e qual (cache das plantas e save da run)
+template <typename T>
+void appendRecords(std::vector<char>& out, const T* records, std::size_t count) {
+    static_assert(std::is_trivially_copyable_v<T>, "so registos POD");
+    const char* bytes = reinterpret_cast<const char*>(records);
+    out.insert(out.end(), bytes, bytes + count * sizeof(T));
+}
+
+// false se os dados acabarem antes de 'count' registos
+template <typename T>
+bool readRecords(const std::vector<char>& data, std::size_t& offset, std::size_t count, std::vector<T>& out) {
+    static_assert(std::is_trivially_copyable_v<T>, "so registos POD");
+    const std::size_t bytes = count * sizeof(T);
+    if (offset > data.size() || data.size() - offset < bytes) return false;
+    out.resize(count);
+    if (bytes) std::memcpy(out.data(), data.data() + offset, bytes);
+    offset += bytes;
+    return true;
+}
+
+// Salas, portas e spawns da planta, a seguir a um cabecalho com as contagens
+void appendLayoutRecords(const DungeonLayout& layout, CachedLayoutCounts& counts, std::vector<char>& out);
+// Valida os indices antes de mexer em 'layout' (um indice errado partiria o RoomManager)
+bool readLayoutRecords(const std::vector<char>& data, std::size_t& offset, const CachedLayoutCounts& counts, DungeonLayout& layout);
+
+// Hash da config que muda a planta ou os rosters para a mesma seed (salas por
+// andar, portas extra, obstaculos, arquetipos...). Planta com outro valor e ignorada.
+std::uint32_t layoutFingerprint(const GameConfig& config, const DungeonConfig::FloorConfig& floor);
+
+// "<dir>/v<versao>_f<andar>_<seed>.dng"
+std::string dungeonCachePath(const std::string& directory, int floorIndex, std::uint32_t seed);
+
+// Devolvem false (sem mexer em nada no caso do load) se o ficheiro nao existir,
+// for de outra versao/config ou estiver truncado
+bool loadCachedLayout(const std::string& path, int floorIndex, std::uint32_t seed, std::uint32_t fingerprint, DungeonLayout& layout);
+bool saveCachedLayout(const std::string& path, int floorIndex, std::uint32_t seed, std::uint32_t fingerprint, const DungeonLayout& layout);
+
+// Escreve num .tmp ao lado e troca pelo nome final (usado tambem pelo save da run)
+bool writeFileAtomically(const std::string& path, const std::vector<char>& data);
+
+#endif // DUNGEONCACHE_HPP
@@ -0,0 +1,90 @@
+#ifndef DUNGEONGENERATOR_HPP
+#define DUNGEONGENERATOR_HPP
+
+#include "Rooms.hpp"
+#include "GameConfig.hpp"
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// Sobe sempre que a mesma seed passar a dar outra planta (invalida a cache em disco)
+constexpr std::uint32_t kDungeonGeneratorVersion = 1;
+
+// Sala do layout; o id da sala e o indice no vetor (0 = sala inicial)
+struct LayoutRoom {
+    sf::Vector2i coord;
+    RoomType type = RoomType::Normal;
+    std::uint8_t cornerVariant = 0;     // Variante do chao/cantos (0..2)
+    std::uint32_t seed = 0;             // Obstaculos e roster da sala
+    std::uint16_t spawnBegin = 0;       // Roster em DungeonLayout::spawns
+    std::uint16_t spawnCount = 0;
+};
+
+// Porta nos dois sentidos entre 'from' e 'to'
+struct LayoutDoor {
+    std::uint16_t from = 0;
+    std::uint16_t to = 0;
+    DoorDirection direction = DoorDirection::None;  // Lado da porta em 'from'
+    DoorType type = DoorType::Normal;
+};
+
+// Planta de um andar, so dados: o RoomManager cria as salas a partir dela
+struct DungeonLayout {
+    std::vector<LayoutRoom> rooms;
+    std::vector<LayoutDoor> doors;
+    std::vector<EnemySpawn> spawns;     // Preenchido depois de sortear os rosters (para a cache)
+    int treasureRoom = -1;
+    int bossRoom = -1;
+    int bossDistance = 0;   // Portas no caminho mais curto da sala inicial ao boss
+    int loops = 0;          // Portas a mais do que a arvore (ciclos)
+    int attempts = 0;
+    bool satisfied = false; // Todas as restricoes cumpridas
+
+    void clear();
+};
+
+// Gerador de andares com restricoes garantidas:
+//  - exatamente o numero de salas pedido;
+//  - Tesouro e Boss em becos (uma so porta, ligada a uma sala normal);
+//  - Boss a distancia maxima da sala inicial (e pelo menos min_boss_distance);
+//  - ciclos com as probabilidades de extra_door_chances.
+// Cada tentativa falhada recomeca com o mesmo rng; esgotado generator_attempts,
+// a ultima tentativa relaxa as restricoes (satisfied fica false) para o andar
+// ser sempre jogavel. Os buffers ficam no gerador: reutilizado, nao aloca.
+class DungeonGenerator {
+public:
+    bool generate(const DungeonConfig& dungeon, const DungeonConfig::FloorConfig& floor,
+        std::uint32_t seed, DungeonLayout& layout);
+
+private:
+    bool attempt(const DungeonConfig& dungeon, int roomCount, bool relaxed, DungeonLayout& layout);
+
+    int addRoom(DungeonLayout& layout, sf::Vector2i coord, RoomType type);
+    void addDoor(DungeonLayout& layout, int from, int to, DoorDirection direction, DoorType type);
+    void addLoops(const DungeonConfig& dungeon, DungeonLayout& layout);
+    void computeDistances(const DungeonLayout& layout);
+    int placeSpecial(DungeonLayout& layout, RoomType type, bool farthest, int minDistance, bool relaxed);
+
+    int cellAt(sf::Vector2i coord) const;
+    int occupiedNeighbours(sf::Vector2i coord) const;
+
+    std::mt19937 rng;
+
+    // Grelha quadrada centrada na sala inicial: indice da sala ou -1
+    std::vector<int> cells;
+    int gridSide = 0;
+
+    std::vector<std::uint8_t> doorMasks;    // Bit por DoorDirection, por sala
+    std::vector<int> openRooms;             // Salas que ainda podem ter vizinhas novas
+    std::vector<int> distances;             // BFS a partir da sala inicial
+    std::vector<int> queue;
+
+    struct Candidate {
+        sf::Vector2i coord;
+        int parent;
+        DoorDirection direction;            // Do pai para a sala nova
+    };
+    std::vector<Candidate> candidates;
+};
+
+#endif // DUNGEONGENERATOR_HPP
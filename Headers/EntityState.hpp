@@ -0,0 +1,92 @@
+#ifndef ENTITYSTATE_HPP
+#define ENTITYSTATE_HPP
+
+#include "SFML/System/Vector2.hpp"
+#include <cstdint>
+#include <type_traits>
+
+// Registos POD com o estado de cada entidade de uma run (ver RunSave.hpp).
+// Sao copiados tal e qual para o ficheiro, por isso qualquer mudanca de
+// tamanho ou de ordem dos campos obriga a subir kRunSaveFormat.
+
+// Playhead de uma animacao; o clip e guardado pelo id (hash do nome na AnimationLibrary)
+struct AnimationState {
+    std::uint32_t clipId = 0;           // 0 = sem clip
+    float time = 0.f;
+    std::int32_t frame = 0;
+    std::uint8_t playing = 0;
+    std::uint8_t finished = 0;
+    std::uint8_t reserved[2] = {};
+};
+
+// Lagrima do Isaac ou projetil inimigo (a hitbox e recalculada ao carregar)
+struct ProjectileState {
+    sf::Vector2f position;
+    sf::Vector2f direction;
+    float distanceTraveled = 0.f;
+    float rotation = 0.f;               // Graus
+    sf::Vector2f scale{ 1.f, 1.f };
+};
+
+// Inimigo vivo. O bloco comum e da EnemyBase; 'timers', 'points' e 'values'
+// sao de cada tipo (o saveState de cada classe diz o que vai em cada posicao).
+struct EnemyState {
+    std::uint8_t kind = 0;              // SpawnKind
+    std::uint8_t flags = 0;             // EnemyState::Hit | EnemyState::Healing
+    std::uint16_t archetype = 0;        // Indice na ArchetypeTable (Chubby/Monstro)
+    std::int32_t health = 0;
+    std::uint32_t rngState = 1;
+    sf::Vector2f position;
+    float speedMultiplier = 1.f;
+    float speedStatusTimer = 0.f;
+    float hitTimer = 0.f;
+    float healFlashTimer = 0.f;
+    AnimationState animation;
+    std::uint32_t projectileBegin = 0;  // Projeteis em RunSnapshot::projectiles
+    std::uint32_t projectileCount = 0;
+
+    float timers[4] = {};
+    sf::Vector2f points[5];
+    std::int32_t values[6] = {};
+
+    static constexpr std::uint8_t Hit = 1;
+    static constexpr std::uint8_t Healing = 2;
+};
+
+struct PlayerState {
+    sf::Vector2f position;
+    std::int32_t health = 0;
+    std::uint8_t isHit = 0;
+    std::uint8_t reserved[3] = {};
+    float hitTimer = 0.f;               // Tempo desde o ultimo dano (invulnerabilidade)
+    float cooldownTimer = 0.f;          // Tempo desde a ultima lagrima
+    AnimationState animation;
+    std::uint32_t projectileBegin = 0;
+    std::uint32_t projectileCount = 0;
+};
+
+// Estado de uma sala que muda durante a run (a planta vem do DungeonLayout)
+struct RoomState {
+    std::uint8_t cleared = 0;
+    std::uint8_t doorsOpened = 0;
+    std::uint8_t trapdoorOpen = 0;
+    std::uint8_t spawned = 0;           // Os inimigos ja foram criados (os vivos vem em 'enemies')
+    std::uint16_t doorBegin = 0;        // Portas em RunSnapshot::doors, pela ordem de Room::getDoors
+    std::uint16_t doorCount = 0;
+    std::uint32_t enemyBegin = 0;
+    std::uint32_t enemyCount = 0;
+};
+
+struct DoorSaveState {
+    std::uint8_t state = 0;             // DoorState (Rooms.hpp)
+    std::uint8_t isOpen = 0;
+    std::uint8_t reserved[2] = {};
+    float animationProgress = 0.f;
+};
+
+static_assert(sizeof(AnimationState) == 16 && sizeof(ProjectileState) == 32 && sizeof(EnemyState) == 140 &&
+    sizeof(PlayerState) == 48 && sizeof(RoomState) == 16 && sizeof(DoorSaveState) == 8, "layout do save mudou");
+static_assert(std::is_trivially_copyable_v<EnemyState> && std::is_trivially_copyable_v<PlayerState>,
+    "os registos do save sao copiados com memcpy");
+
+#endif // ENTITYSTATE_HPP
@@ -0,0 +1,107 @@
+#ifndef EVENTBUS_HPP
+#define EVENTBUS_HPP
+
+#include "SFML/Graphics.hpp"
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+class EnemyBase;
+
+enum class GameEventType : std::uint8_t {
+    Damage,         // Pedido: 'amount' de dano no alvo (aplicado na fase de resolucao)
+    Heal,           // Pedido: 'amount' de vida no alvo
+    Death,          // Noticia: o alvo morreu nesta resolucao
+    ProjectileHit,  // Noticia: um projetil acertou no alvo
+    RoomClear       // Noticia: a sala 'roomId' ficou limpa
+};
+
+enum class GameEventTarget : std::uint8_t {
+    None,
+    Player,
+    Enemy
+};
+
+// Mascara para filtrar subscricoes (um bit por GameEventType)
+constexpr std::uint32_t eventBit(GameEventType type) { return 1u << static_cast<std::uint32_t>(type); }
+constexpr std::uint32_t kAllGameEvents = 0x1Fu;
+
+struct GameEvent {
+    GameEventType type = GameEventType::Damage;
+    GameEventTarget target = GameEventTarget::None;
+    EnemyBase* enemy = nullptr;     // Quando target == Enemy
+    int amount = 0;
+    int health = 0;                 // Vida do alvo depois da resolucao
+    sf::Vector2f position;
+    int roomId = -1;
+};
+
+// Fila de eventos do tick. A jogabilidade publica durante o update/colisoes; o
+// Game resolve os pedidos (dano, cura) numa so fase depois das colisoes e no fim
+// entrega o lote inteiro aos subscritores (som, UI, telemetria, consola), uma
+// chamada por subscritor e por tick. So a thread principal usa o bus.
+//
+// Simulacoes isoladas (GymEnv) tem o seu proprio bus: enquanto um EventBus::Scope
+// estiver ativo, getInstance() nessa thread devolve-o em vez do bus do jogo.
+class EventBus {
+public:
+    using Listener = std::function<void(const std::vector<GameEvent>&)>;
+
+    static EventBus& getInstance();
+
+    // So para simulacoes isoladas; o jogo usa sempre getInstance()
+    EventBus() = default;
+
+    class Scope {
+    public:
+        explicit Scope(EventBus& bus);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        EventBus* previous;
+    };
+
+    void publish(const GameEvent& event) { queue.push_back(event); }
+
+    // Eventos do tick ainda por entregar (a fase de resolucao pode acrescentar mais)
+    std::vector<GameEvent>& pending() { return queue; }
+
+    // 'listener' so e chamado nos ticks com pelo menos um evento de 'mask'
+    int subscribe(std::uint32_t mask, Listener listener);
+    void unsubscribe(int id);
+
+    // Entrega o lote aos subscritores e esvazia a fila
+    void dispatch();
+
+private:
+    EventBus(const EventBus&) = delete;
+    EventBus& operator=(const EventBus&) = delete;
+
+    struct Subscriber {
+        int id;
+        std::uint32_t mask;
+        Listener listener;
+    };
+
+    std::vector<GameEvent> queue;
+    std::vector<GameEvent> delivering;
+    std::vector<Subscriber> subscribers;
+    int nextId = 1;
+};
+
+// Subscritor opcional que passa os eventos para o Logger (escrita assincrona,
+// com o limite por segundo da categoria Combat).
+class ConsoleEventLog {
+public:
+    ConsoleEventLog();
+    ~ConsoleEventLog();
+
+private:
+    void write(const std::vector<GameEvent>& events);
+
+    int subscription = 0;
+};
+
+#endif // EVENTBUS_HPP
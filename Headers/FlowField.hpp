@@ -0,0 +1,59 @@
+#ifndef FLOWFIELD_HPP
+#define FLOWFIELD_HPP
+
+#include "SFML/Graphics.hpp"
+#include <cstdint>
+#include <vector>
+
+// Campo de direcoes de uma sala em direcao ao jogador, numa grelha grossa sobre
+// gameBounds. E recalculado (Dijkstra a partir da celula do alvo) so quando o alvo
+// muda de celula ou a grelha muda; cada inimigo le a sua direcao em O(1), por isso
+// o custo da perseguicao nao depende do numero de inimigos.
+class FlowField {
+public:
+    void configure(const sf::FloatRect& bounds, float cellSize);
+
+    // Celulas bloqueadas (rochas, buracos...). Marca o campo para recalcular.
+    void setBlocked(int column, int row, bool blocked);
+    void clearBlocked();
+    bool isBlocked(sf::Vector2f position) const;
+
+    // Atualiza o alvo. Devolve true se o campo foi recalculado.
+    bool setTarget(sf::Vector2f position);
+
+    // Direcao unitaria a seguir a partir de 'position'. Em linha de vista do alvo
+    // e a reta para o alvo; senao a da celula. Zero se nao houver caminho.
+    sf::Vector2f direction(sf::Vector2f position) const;
+
+    sf::FloatRect cellBounds(int column, int row) const;
+    int columns() const { return cols; }
+    int rows() const { return rowCount; }
+    bool empty() const { return cols == 0 || rowCount == 0; }
+
+    // Custo ate ao alvo (10 por passo reto, 14 na diagonal) ou kUnreachable
+    static constexpr std::uint16_t kUnreachable = 0xFFFF;
+    std::uint16_t costAt(sf::Vector2f position) const;
+
+private:
+    int cellIndex(sf::Vector2f position) const;
+    bool cellBlocked(int column, int row) const;
+    void rebuild();
+    bool lineOfSight(int fromColumn, int fromRow, int toColumn, int toRow) const;
+
+    sf::FloatRect area;
+    float cell = 64.f;
+    int cols = 0;
+    int rowCount = 0;
+    int blockedCount = 0;
+
+    std::vector<std::uint8_t> blocked;
+    std::vector<std::uint16_t> cost;
+    std::vector<sf::Vector2f> flow;     // Direcao para a melhor vizinha
+    std::vector<std::uint8_t> visible;  // Linha de vista ate a celula do alvo
+
+    sf::Vector2f target;
+    int targetCell = -1;
+    bool dirty = true;
+};
+
+#endif // FLOWFIELD_HPP
@@ -2,11 +2,11 @@
 #define GAME_HPP
 
 #include "SFML/Graphics.hpp"
-#include "player.hpp"
-#include "enemy.hpp"
 #include "AssetManager.hpp"
-#include "RoomsManager.hpp"
+#include "Simulation.hpp"
+#include "EventBus.hpp"
 #include <optional>
+#include <vector>
 
 enum class GameState {
     menu,
@@ -27,6 +27,13 @@ private:
     void loadGameAssets();
     void setupMenu();
 
+    // Save da run (RunSave.hpp) e fotografia em memoria (WorldSnapshot): o estado vem
+    // da Simulation, aqui so se acerta a UI que depende da sala
+    void restoreRun(const RunSnapshot& snapshot);
+    void saveRun();
+    bool resumeRun();
+    bool restoreWorld(const WorldSnapshot& snapshot);
+
     sf::RenderWindow window;
     GameState currentState;
 
@@ -36,11 +43,6 @@ private:
     sf::RectangleShape bossIntroBackground; // <-- ADICIONADO AQUI
     std::optional<sf::Sprite> bossNameSprite;
 
-    // Textures para menu e UI
-    sf::Texture playButtonTexture;
-    sf::Texture exitButtonTexture;
-    sf::Texture menuTexture;
-    sf::Texture basementCornerTexture;
 
     // Sprites opcionais para menu e UI
     std::optional<sf::Sprite> playButton;
@@ -53,20 +55,26 @@ private:
     std::optional<sf::Sprite> cornerBL;
     std::optional<sf::Sprite> cornerBR;
 
-    // Gesto de Salas
-    std::optional<RoomManager> roomManager;
-
-    // Player
-    std::optional<Player_ALL> Isaac;
+    // Isaac, salas e colises (as regras do jogo, sem janela)
+    std::optional<Simulation> simulation;
 
     // UI de Vida
     std::optional<sf::Sprite> heartSpriteF;
     std::optional<sf::Sprite> heartSpriteH;
     std::optional<sf::Sprite> heartSpriteE;
 
-    sf::FloatRect gameBounds;
+    // Subscritor opcional do bus que escreve os eventos na consola
+    std::optional<ConsoleEventLog> eventLog;
+
+    RunSnapshot runSnapshot;    // Reutilizado entre saves
+    WorldSnapshot worldSnapshot; // F6 captura, F7 volta a ele
+    bool hasWorldSnapshot = false;
+
     sf::Clock clock;
+
     AssetManager& assets;
+    TextureHandle bossTitleTexture;     // Resolvido no arranque (usado a cada entrada na sala do boss)
+    std::vector<AssetLease> pinnedAssets; // Isaac, UI e menu: nunca saem da memoria
 
     bool isMouseOver(const sf::Sprite& sprite);
 };
@@ -6,10 +6,27 @@
 #include <fstream>
 #include <iostream>
 #include <vector>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <type_traits>
 #include "nlohmann/json.hpp"
+#include "Logger.hpp"
 
 using json = nlohmann::json;
 
+// ============================================================================
+// HITBOX (comum a todas as entidades)
+// ============================================================================
+
+// Caixa de colisão relativa à posição da entidade (centro = posição + offset).
+// Independente da escala do sprite.
+struct HitboxConfig {
+    float width = 64.0f;
+    float height = 64.0f;
+    float offset_x = 0.0f;
+    float offset_y = 0.0f;
+};
 // ============================================================================
 // PLAYER
 // ============================================================================
@@ -60,6 +77,7 @@ struct PlayerSpawnConfig {
 
 // Main Player Config
 struct PlayerConfig {
+    HitboxConfig hitbox = { 60.0f, 80.0f, 1.5f, 6.0f };
     PlayerStatsConfig stats;
     PlayerAttackConfig attack;
     PlayerVisualConfig visual;
@@ -89,8 +107,7 @@ struct DemonStatsConfig {
 struct DemonAttackConfig {
     float fire_cooldown = 2.0f;
     float attack_delay = 0.5f;
-    int projectile_count = 3;
-    float projectile_spread = 20.0f;
+    std::string pattern = "demon_fan"; // Nome em "bullet_patterns"
     float projectile_speed = 700.0f;
     float projectile_max_distance = 800.0f;
 };
@@ -116,6 +133,7 @@ struct DemonSpawnConfig {
 
 // Main Demon Config
 struct DemonConfig {
+    HitboxConfig hitbox = { 120.0f, 90.0f, 45.0f, 10.0f };
     DemonStatsConfig stats;
     DemonAttackConfig attack;
     DemonVisualConfig visual;
@@ -149,10 +167,21 @@ struct BishopMovementConfig {
     float lateral_bias_strength = 0.5f;
 };
 
-// Bishop Heal Config
+// Filtro de alvos das auras (um bit por tipo de inimigo)
+namespace AuraTargets {
+    constexpr std::uint8_t Demon = 1 << 0;
+    constexpr std::uint8_t Bishop = 1 << 1;
+    constexpr std::uint8_t Chubby = 1 << 2;
+    constexpr std::uint8_t Monstro = 1 << 3;
+    constexpr std::uint8_t All = Demon | Bishop | Chubby | Monstro;
+}
+
+// Bishop Heal Config (aura de cura emitida no evento do cântico)
 struct BishopHealConfig {
     float cooldown = 7.0f;
     int amount = 3;
+    float radius = 0.0f;                // 0 = sala inteira
+    std::uint8_t targets = AuraTargets::Demon | AuraTargets::Chubby;
 };
 
 // Bishop Visual Config
@@ -171,6 +200,7 @@ struct BishopSpawnConfig {
 
 // Main Bishop Config
 struct BishopConfig {
+    HitboxConfig hitbox = { 110.0f, 140.0f, 57.0f, 45.0f };
     BishopStatsConfig stats;
     BishopMovementConfig movement;
     BishopHealConfig heal;
@@ -178,6 +208,253 @@ struct BishopConfig {
     BishopSpawnConfig spawn;
 };
 
+// ============================================================================
+// BULLET PATTERNS (padrões de disparo partilhados pelos inimigos)
+// ============================================================================
+
+enum class BulletPatternKind : std::uint8_t {
+    Ring,           // 'count' projéteis com ângulos iguais à volta
+    Fan,            // 'count' projéteis espalhados uniformemente em 'spread' graus
+    Spiral,         // Anel que roda 'spiral_step' graus a cada rajada
+    RandomSpread    // 'count' projéteis com ângulo aleatório (passos de 1 grau) em 'spread'
+};
+
+struct BulletPatternConfig {
+    std::string name;
+    BulletPatternKind kind = BulletPatternKind::Fan;
+    int count = 1;
+    float spread = 0.0f;
+    float spiral_step = 0.0f;
+    bool aimed = true;              // Roda o padrão na direção do alvo
+    float speed_min = 1.0f;         // Multiplicador de velocidade aleatório (passos de 0.01)
+    float speed_max = 1.0f;
+    float projectile_scale = 0.0f;  // 0 = mantém a escala do protótipo
+    float offset_y = 0.0f;          // Altura de onde saem os projéteis
+    bool orient_sprites = false;    // Roda o sprite para a direção do disparo
+    float sprite_rotation = 0.0f;   // Rotação extra do sprite (graus)
+};
+
+inline int findBulletPattern(const std::vector<BulletPatternConfig>& patterns, const std::string& name) {
+    for (std::size_t i = 0; i < patterns.size(); ++i)
+        if (patterns[i].name == name) return static_cast<int>(i);
+    return -1;
+}
+
+// ============================================================================
+// BOSS TIMELINES (máquina de estados dos bosses definida em dados)
+// ============================================================================
+
+// Como o corpo se mexe durante um segmento
+enum class BossMotion : std::uint8_t {
+    None,    // Não mexe
+    Ground,  // Corpo assente na posição do chão
+    Hop,     // Salto em arco: o chão avança 'speed' na direção do movimento, arco de 'height'
+    Rise,    // Corpo sobe a 'speed' px/s (o chão fica)
+    Chase,   // Chão persegue o alvo a 'speed' px/s (corpo no ar)
+    Drop     // Corpo cai de 'height' acima do chão até ao chão
+};
+
+enum class BossEventKind : std::uint8_t {
+    Aim,      // Alvo = posição do jogador
+    AimMove,  // Direção do movimento = para o jogador
+    Land,     // Corpo volta ao chão
+    Attack    // Dispara o ataque 'attack' do arquétipo
+};
+
+// Intervalo [start, end) do estado com clip, escala e movimento
+struct BossSegmentConfig {
+    float start = 0.0f;
+    float end = 0.0f;               // 0 = até ao fim do estado
+    std::string clip;               // Vazio = mantém o clip atual
+    bool set_scale = false;
+    bool face_player = true;        // Vira o sprite para o jogador (só com escala)
+    float scale_x = 1.0f, scale_y = 1.0f;         // Multiplicador no início do segmento
+    float scale_to_x = 1.0f, scale_to_y = 1.0f;   // ... e no fim (interpolado)
+    BossMotion motion = BossMotion::None;
+    float speed = 0.0f;
+    float height = 0.0f;
+    int id = -1;                    // Índice global na timeline (resolvido no load)
+};
+
+struct BossEventConfig {
+    float time = 0.0f;
+    BossEventKind kind = BossEventKind::Aim;
+    std::string attack;             // Nome do ataque no arquétipo (só para Attack)
+    int id = -1;                    // Índice global na timeline (resolvido no load)
+};
+
+// Avaliadas por ordem no fim do estado; a primeira que passa ganha
+struct BossTransitionConfig {
+    std::string to;
+    int to_index = -1;
+    float health_below = 0.0f;      // Fração da vida máxima (0 = sem condição)
+    int chance = 100;               // Percentagem (só se sorteia se as outras condições passarem)
+    std::string last_action;        // Último estado de ação tem de ser este (vazio = qualquer)
+    int last_action_index = -1;
+};
+
+struct BossStateConfig {
+    std::string name;
+    float duration = 1.0f;
+    bool action = false;            // Conta como "última ação" para as transições
+    int contact_damage = 1;         // Dano de contacto ao jogador neste estado
+    std::vector<BossSegmentConfig> segments;
+    std::vector<BossEventConfig> events; // Ordenados por tempo
+    std::vector<BossTransitionConfig> transitions;
+};
+
+struct BossTimelineConfig {
+    std::string name;
+    int initial = 0;
+    std::vector<BossStateConfig> states;
+    int segment_count = 0;
+    int event_count = 0;
+
+    int findState(const std::string& stateName) const {
+        for (std::size_t i = 0; i < states.size(); ++i)
+            if (states[i].name == stateName) return static_cast<int>(i);
+        return -1;
+    }
+};
+
+inline int findBossTimeline(const std::vector<BossTimelineConfig>& timelines, const std::string& name) {
+    for (std::size_t i = 0; i < timelines.size(); ++i)
+        if (timelines[i].name == name) return static_cast<int>(i);
+    return -1;
+}
+
+// ============================================================================
+// ARCHETYPES (Chubby, Monstro e variantes definidas só no config.json)
+// ============================================================================
+// Os registos são POD de tamanho fixo, resolvidos (incluindo "base") no load.
+// No spawn a entidade copia o registo inteiro: um memcpy, sem lookups de config.
+
+enum class ArchetypeKind : std::uint8_t {
+    Chubby,
+    Monstro
+};
+
+constexpr std::size_t kArchetypeNameSize = 32;
+constexpr std::size_t kArchetypeClipNameSize = 20;
+constexpr std::size_t kMaxClipFrames = 8;
+constexpr std::size_t kMaxArchetypeClips = 20;
+constexpr std::size_t kMaxArchetypeAttacks = 4;
+
+// Retângulo na spritesheet (x, y, largura, altura)
+struct ArchetypeRect {
+    int x = 0;
+    int y = 0;
+    int width = 0;
+    int height = 0;
+};
+
+// Clip de animação com nome: lista de frames + duração de cada frame
+struct ArchetypeClip {
+    char name[kArchetypeClipNameSize] = {};
+    float frame_duration = 0.0f;
+    std::uint8_t frame_count = 0;
+    ArchetypeRect frames[kMaxClipFrames] = {};
+};
+
+// Ataque com nome -> padrão de "bullet_patterns" (índice resolvido no load)
+struct ArchetypeAttack {
+    char name[kArchetypeClipNameSize] = {};
+    char pattern[kArchetypeNameSize] = {};
+    int pattern_id = -1;
+};
+
+struct ArchetypeStats {
+    int health = 1;
+    int max_health = 1;
+    float speed = 0.0f;
+    float scale = 1.0f;
+};
+
+struct ArchetypeTiming {
+    float idle_time = 0.4f;
+    float recover_time = 0.25f;
+    float windup_start = 0.1f;
+    float windup_end = 0.2f;
+    float throw_time = 0.35f;
+};
+
+struct ArchetypeMovement {
+    float walk_distance = 200.0f;
+    float aggro_range = 300.0f;
+    float aggro_band = 150.0f;
+};
+
+struct ArchetypeProjectile {
+    float speed = 480.0f;
+    float range = 980.0f;
+    float return_speed = 1100.0f;   // Bumerangue: velocidade de regresso
+    float deceleration = 2.2f;      // Bumerangue: travagem na ida
+    float return_threshold = 150.0f; // Bumerangue: velocidade a partir da qual volta
+    float catch_distance = 65.0f;   // Bumerangue: distância para apanhar
+    HitboxConfig hitbox = { 26.0f, 26.0f, 0.0f, 0.0f };
+};
+
+struct EnemyArchetype {
+    char name[kArchetypeNameSize] = {};
+    char base[kArchetypeNameSize] = {};
+    ArchetypeKind kind = ArchetypeKind::Chubby;
+    int spawn_weight = 1;
+    ArchetypeStats stats;
+    HitboxConfig hitbox;
+    ArchetypeTiming timing;
+    ArchetypeMovement movement;
+    ArchetypeProjectile projectile;
+    std::uint8_t attack_count = 0;
+    ArchetypeAttack attacks[kMaxArchetypeAttacks] = {};
+    std::uint8_t clip_count = 0;
+    ArchetypeClip clips[kMaxArchetypeClips] = {};
+    char timeline[kArchetypeNameSize] = {}; // Nome em "boss_timelines" (só bosses)
+    int timeline_id = -1;
+
+    // Índice do clip/ataque com este nome, ou -1 (resolver uma vez, no spawn)
+    int findClip(const char* clipName) const {
+        for (int i = 0; i < clip_count; ++i) if (std::strcmp(clips[i].name, clipName) == 0) return i;
+        return -1;
+    }
+    int findAttack(const char* attackName) const {
+        for (int i = 0; i < attack_count; ++i) if (std::strcmp(attacks[i].name, attackName) == 0) return i;
+        return -1;
+    }
+};
+
+static_assert(std::is_trivially_copyable_v<EnemyArchetype>, "EnemyArchetype tem de ser copiável com memcpy");
+
+// Tabela com todos os arquétipos já resolvidos
+struct ArchetypeTable {
+    std::vector<EnemyArchetype> records;
+
+    int find(const std::string& name) const {
+        for (std::size_t i = 0; i < records.size(); ++i)
+            if (name == records[i].name) return static_cast<int>(i);
+        return -1;
+    }
+
+    const EnemyArchetype& at(int id) const { return records.at(static_cast<std::size_t>(id)); }
+
+    // Soma dos spawn_weight de um tipo (0 = nenhum arquétipo desse tipo pode nascer)
+    int totalWeight(ArchetypeKind kind) const {
+        int total = 0;
+        for (const auto& r : records) if (r.kind == kind && r.spawn_weight > 0) total += r.spawn_weight;
+        return total;
+    }
+
+    // Escolha por peso: 'roll' em [0, totalWeight(kind))
+    int pick(ArchetypeKind kind, int roll) const {
+        for (std::size_t i = 0; i < records.size(); ++i) {
+            const auto& r = records[i];
+            if (r.kind != kind || r.spawn_weight <= 0) continue;
+            if (roll < r.spawn_weight) return static_cast<int>(i);
+            roll -= r.spawn_weight;
+        }
+        return -1;
+    }
+};
+
 // ============================================================================
 // GAME
 // ============================================================================
@@ -204,6 +481,38 @@ struct DungeonConfig {
         std::vector<int> chances = { 70, 50, 30, 15, 5 };
     };
     std::vector<ExtraDoorChance> extra_door_chances;
+
+    // Gerador (DungeonGenerator): tentativas até cumprir as restrições e a
+    // distância mínima (em portas) entre a sala inicial e a do boss
+    int generator_attempts = 16;
+    int min_boss_distance = 3;
+
+    // Seed fixa da run (desafio diário, benchmarks); 0 = aleatória. Com a cache
+    // ligada, plantas já geradas (versão do gerador + andar + seed) vêm do disco.
+    std::uint32_t fixed_seed = 0;
+    bool layout_cache = false;
+    std::string layout_cache_dir = "dungeon_cache";
+
+    // Dificuldade por andar (o último bloco repete-se nos andares seguintes)
+    struct FloorConfig {
+        int min_rooms = 6;
+        int max_rooms = 16;
+        float enemy_health_multiplier = 1.0f;   // Vida inicial dos inimigos
+        int extra_enemies = 0;                  // Inimigos a mais por sala normal
+        int chubby_room_chance = 40;            // % de salas de Chubbies (o resto é de Demons)
+    };
+    std::vector<FloorConfig> floors;
+
+    // Bloco do andar 'index' (0 = primeiro); sem "floors" usa min/max_rooms
+    FloorConfig floor(int index) const {
+        if (floors.empty()) {
+            FloorConfig fallback;
+            fallback.min_rooms = min_rooms;
+            fallback.max_rooms = max_rooms;
+            return fallback;
+        }
+        return floors[std::min<std::size_t>(static_cast<std::size_t>(std::max(index, 0)), floors.size() - 1)];
+    }
 };
 
 // UI Config
@@ -272,6 +581,103 @@ struct MinimapConfig {
     float cleared_room_outline_thickness = 1.0f;
 };
 
+// Collision Config
+struct CollisionConfig {
+    bool swept_projectiles = true; // Colisão contínua (não depende do FPS)
+    HitboxConfig isaac_tear_hitbox = { 22.0f, 22.0f, 0.0f, 0.0f };
+    HitboxConfig enemy_tear_hitbox = { 26.0f, 26.0f, 0.0f, 0.0f };
+};
+
+// Parallel Config (job system e IA dos inimigos)
+struct ParallelConfig {
+    int worker_threads = 0;         // 0 = número de núcleos - 1
+    bool parallel_ai = true;        // Update dos inimigos em blocos nos workers
+    int ai_chunk_size = 4;          // Inimigos por bloco
+    int ai_min_parallel_enemies = 8; // Abaixo disto o update fica em série
+};
+
+// Room Scheduler Config (salas vizinhas simuladas em segundo plano)
+struct RoomSchedulerConfig {
+    bool background_rooms = false;      // Modo "inimigos errantes"
+    float background_hz = 10.0f;        // Frequência do tier de fundo
+    int max_rooms_per_tick = 4;         // Orçamento de salas por tick de fundo
+    float time_slice_ms = 2.0f;         // Tempo máximo de um tick de fundo (no worker)
+    float max_catchup_seconds = 0.5f;   // Tempo simulado máximo acumulado por sala
+};
+
+// Navigation Config (flow field por sala para os inimigos que perseguem)
+struct NavigationConfig {
+    bool flow_field = true;             // false = perseguição em linha reta
+    float cell_size = 64.0f;            // Tamanho da célula da grelha (px)
+};
+
+// Obstacle Config (rochas e buracos gerados com cada sala normal)
+struct ObstacleConfig {
+    bool enabled = true;
+    float tile_size = 64.0f;            // Tamanho do tile (px), igual ao da navegação
+    int clusters_min = 3;               // Grupos de obstáculos por sala
+    int clusters_max = 7;
+    int cluster_tiles_max = 4;          // Tiles por grupo
+    float pit_chance = 0.25f;           // Probabilidade de um grupo ser de buracos
+    int corridor_tiles = 3;             // Largura da cruz livre entre as portas (tiles)
+};
+
+// Steering Config (separação, chegada e desvio de paredes dos inimigos)
+struct SteeringConfig {
+    bool enabled = true;
+    float cell_size = 128.0f;           // Célula do spatial hash (px)
+    float separation_scale = 1.0f;      // Alcance = (raio + raio do vizinho) * escala
+    float separation_weight = 1.5f;
+    int max_neighbors = 8;              // Vizinhos considerados por inimigo
+    float arrival_radius = 100.0f;      // Para a esta distância do alvo
+    float slowing_radius = 220.0f;      // Começa a travar aqui
+    float wall_probe = 48.0f;           // Alcance das antenas à frente (px, além do raio)
+    float wall_weight = 1.0f;
+};
+
+// Events Config (bus de eventos de jogo)
+struct EventsConfig {
+    bool console_log = false;           // Escreve os eventos de cada tick na consola
+};
+
+// Logging Config (logger assincrono, ver Logger.hpp)
+struct LoggingConfig {
+    std::string level = "info";         // trace, debug, info, warn, error, off (acima do nivel compilado)
+    bool console = true;
+    std::string file = "game.log";      // Vazio = sem ficheiro
+    int queue_capacity = 1024;          // Mensagens em espera (arredondado a potencia de 2)
+    int flush_interval_ms = 5;          // Intervalo da thread de escrita
+    // Mensagens por segundo de cada categoria abaixo de Warn (0 = sem limite)
+    std::vector<std::pair<std::string, int>> rate_limits = { { "combat", 30 }, { "ai", 10 } };
+};
+
+// Assets Config (pack gerado com --pack; sem ele lê os PNG soltos de Images/)
+struct AssetsConfig {
+    bool use_pack = true;
+    std::string pack_file = "assets.pak";
+    int texture_budget_mb = 256;        // Acima disto despeja as texturas sem uso (0 = sem limite)
+};
+
+// Save Config (run guardada ao fechar a janela, ver RunSave.hpp)
+struct SaveConfig {
+    bool enabled = true;
+    std::string file = "run.sav";
+    bool resume = true;                 // O botao Play continua a run guardada, se houver
+};
+
+// Gym Config (ambiente headless para agentes, ver GymEnv.hpp)
+struct GymConfig {
+    float step_dt = 1.f / 60.f;         // Tempo simulado por tick
+    int frame_skip = 4;                 // Ticks por step (a acao repete-se)
+    int max_steps = 3000;               // Episodio truncado ao fim de tantos steps
+    float reward_hit = 0.1f;            // Por ponto de dano num inimigo
+    float reward_kill = 1.f;
+    float reward_room_clear = 5.f;
+    float reward_hurt = -1.f;           // Por ponto de dano no Isaac
+    float reward_death = -10.f;
+    float reward_step = -0.001f;        // Custo do tempo (nao ficar parado)
+};
+
 // Main Game Config
 struct GameConfig_General {
     int window_width = 1920;
@@ -285,6 +691,17 @@ struct GameConfig_General {
     DoorVisualConfig door_boss; // NOVO
     DoorVisualConfig door_treasure; // NOVO
     MinimapConfig minimap;
+    CollisionConfig collision;
+    ParallelConfig parallel;
+    RoomSchedulerConfig room_scheduler;
+    NavigationConfig navigation;
+    ObstacleConfig obstacles;
+    SteeringConfig steering;
+    EventsConfig events;
+    LoggingConfig logging;
+    AssetsConfig assets;
+    SaveConfig save;
+    GymConfig gym;
 };
 
 // ============================================================================
@@ -329,6 +746,9 @@ struct GameConfig {
     PlayerConfig player;
     DemonConfig demon;
     BishopConfig bishop;
+    std::vector<BulletPatternConfig> bullet_patterns;
+    std::vector<BossTimelineConfig> boss_timelines;
+    ArchetypeTable archetypes;
     GameConfig_General game;
     CornerTextureConfig corners;
     ProjectileTexturesConfig projectile_textures;
@@ -338,6 +758,13 @@ struct GameConfig {
 // JSON DESERIALIZATION (with defaults)
 // ============================================================================
 
+// Hitbox: os defaults vêm do valor atual (cada tipo de entidade tem os seus)
+inline void from_json(const json& j, HitboxConfig& c) {
+    c.width = j.value("width", c.width);
+    c.height = j.value("height", c.height);
+    c.offset_x = j.value("offset_x", c.offset_x);
+    c.offset_y = j.value("offset_y", c.offset_y);
+}
 // Player Animation
 inline void from_json(const json& j, PlayerAnimationConfig& c) {
     c.frame_duration = j.value("frame_duration", 0.1f);
@@ -384,6 +811,7 @@ inline void from_json(const json& j, PlayerSpawnConfig& c) {
 
 // Player
 inline void from_json(const json& j, PlayerConfig& c) {
+    if (j.contains("hitbox")) from_json(j["hitbox"], c.hitbox);
     if (j.contains("stats")) c.stats = j["stats"].get<PlayerStatsConfig>();
     if (j.contains("attack")) c.attack = j["attack"].get<PlayerAttackConfig>();
     if (j.contains("visual")) c.visual = j["visual"].get<PlayerVisualConfig>();
@@ -409,8 +837,7 @@ inline void from_json(const json& j, DemonStatsConfig& c) {
 inline void from_json(const json& j, DemonAttackConfig& c) {
     c.fire_cooldown = j.value("fire_cooldown", 2.0f);
     c.attack_delay = j.value("attack_delay", 0.5f);
-    c.projectile_count = j.value("projectile_count", 3);
-    c.projectile_spread = j.value("projectile_spread", 20.0f);
+    c.pattern = j.value("pattern", std::string("demon_fan"));
     c.projectile_speed = j.value("projectile_speed", 700.0f);
     c.projectile_max_distance = j.value("projectile_max_distance", 800.0f);
 }
@@ -436,6 +863,7 @@ inline void from_json(const json& j, DemonSpawnConfig& c) {
 
 // Demon
 inline void from_json(const json& j, DemonConfig& c) {
+    if (j.contains("hitbox")) from_json(j["hitbox"], c.hitbox);
     if (j.contains("stats")) c.stats = j["stats"].get<DemonStatsConfig>();
     if (j.contains("attack")) c.attack = j["attack"].get<DemonAttackConfig>();
     if (j.contains("visual")) c.visual = j["visual"].get<DemonVisualConfig>();
@@ -466,9 +894,27 @@ inline void from_json(const json& j, BishopMovementConfig& c) {
 }
 
 // Bishop Heal
+// Lista de nomes ("demon", "bishop", "chubby", "monstro" ou "all") -> mascara AuraTargets
+inline std::uint8_t auraTargetsFromJson(const json& j, std::uint8_t fallback) {
+    if (!j.is_array()) return fallback;
+    std::uint8_t mask = 0;
+    for (const auto& entry : j) {
+        const std::string name = entry.get<std::string>();
+        if (name == "demon") mask |= AuraTargets::Demon;
+        else if (name == "bishop") mask |= AuraTargets::Bishop;
+        else if (name == "chubby") mask |= AuraTargets::Chubby;
+        else if (name == "monstro") mask |= AuraTargets::Monstro;
+        else if (name == "all") mask |= AuraTargets::All;
+        else LOG_ERROR(LogCategory::Config, "alvo de aura desconhecido: ", name);
+    }
+    return mask;
+}
+
 inline void from_json(const json& j, BishopHealConfig& c) {
     c.cooldown = j.value("cooldown", 7.0f);
     c.amount = j.value("amount", 3);
+    c.radius = j.value("radius", 0.0f);
+    if (j.contains("targets")) c.targets = auraTargetsFromJson(j["targets"], c.targets);
 }
 
 // Bishop Visual
@@ -487,6 +933,7 @@ inline void from_json(const json& j, BishopSpawnConfig& c) {
 
 // Bishop
 inline void from_json(const json& j, BishopConfig& c) {
+    if (j.contains("hitbox")) from_json(j["hitbox"], c.hitbox);
     if (j.contains("stats")) c.stats = j["stats"].get<BishopStatsConfig>();
     if (j.contains("movement")) c.movement = j["movement"].get<BishopMovementConfig>();
     if (j.contains("heal")) c.heal = j["heal"].get<BishopHealConfig>();
@@ -494,6 +941,308 @@ inline void from_json(const json& j, BishopConfig& c) {
     if (j.contains("spawn")) c.spawn = j["spawn"].get<BishopSpawnConfig>();
 }
 
+// Bullet Patterns
+inline void from_json(const json& j, BulletPatternConfig& c) {
+    std::string kind = j.value("kind", std::string("fan"));
+    if (kind == "ring") c.kind = BulletPatternKind::Ring;
+    else if (kind == "fan") c.kind = BulletPatternKind::Fan;
+    else if (kind == "spiral") c.kind = BulletPatternKind::Spiral;
+    else if (kind == "random_spread") c.kind = BulletPatternKind::RandomSpread;
+    else LOG_ERROR(LogCategory::Config, "tipo de padrao desconhecido '", kind, "'");
+
+    c.count = j.value("count", 1);
+    c.spread = j.value("spread", 0.0f);
+    c.spiral_step = j.value("spiral_step", 0.0f);
+    c.aimed = j.value("aimed", c.kind == BulletPatternKind::Fan || c.kind == BulletPatternKind::RandomSpread);
+    c.speed_min = j.value("speed_min", 1.0f);
+    c.speed_max = j.value("speed_max", c.speed_min);
+    c.projectile_scale = j.value("projectile_scale", 0.0f);
+    c.offset_y = j.value("offset_y", 0.0f);
+    c.orient_sprites = j.value("orient_sprites", false);
+    c.sprite_rotation = j.value("sprite_rotation", 0.0f);
+}
+
+// Boss Timelines
+inline void from_json(const json& j, BossSegmentConfig& c) {
+    c.start = j.value("start", 0.0f);
+    c.end = j.value("end", 0.0f);
+    c.clip = j.value("clip", std::string());
+    c.face_player = j.value("face_player", true);
+    if (j.contains("scale")) {
+        c.set_scale = true;
+        c.scale_x = j["scale"].at(0).get<float>();
+        c.scale_y = j["scale"].at(1).get<float>();
+        c.scale_to_x = c.scale_x;
+        c.scale_to_y = c.scale_y;
+        if (j.contains("scale_to")) {
+            c.scale_to_x = j["scale_to"].at(0).get<float>();
+            c.scale_to_y = j["scale_to"].at(1).get<float>();
+        }
+    }
+    std::string motion = j.value("motion", std::string("none"));
+    if (motion == "none") c.motion = BossMotion::None;
+    else if (motion == "ground") c.motion = BossMotion::Ground;
+    else if (motion == "hop") c.motion = BossMotion::Hop;
+    else if (motion == "rise") c.motion = BossMotion::Rise;
+    else if (motion == "chase") c.motion = BossMotion::Chase;
+    else if (motion == "drop") c.motion = BossMotion::Drop;
+    else LOG_ERROR(LogCategory::Config, "movimento de boss desconhecido '", motion, "'");
+    c.speed = j.value("speed", 0.0f);
+    c.height = j.value("height", 0.0f);
+}
+
+inline void from_json(const json& j, BossEventConfig& c) {
+    c.time = j.value("time", 0.0f);
+    std::string type = j.value("type", std::string("aim"));
+    if (type == "aim") c.kind = BossEventKind::Aim;
+    else if (type == "aim_move") c.kind = BossEventKind::AimMove;
+    else if (type == "land") c.kind = BossEventKind::Land;
+    else if (type == "attack") c.kind = BossEventKind::Attack;
+    else LOG_ERROR(LogCategory::Config, "evento de boss desconhecido '", type, "'");
+    c.attack = j.value("attack", std::string());
+}
+
+inline void from_json(const json& j, BossTransitionConfig& c) {
+    c.to = j.value("to", std::string());
+    c.health_below = j.value("health_below", 0.0f);
+    c.chance = j.value("chance", 100);
+    c.last_action = j.value("last_action", std::string());
+}
+
+inline void from_json(const json& j, BossStateConfig& c) {
+    c.duration = j.value("duration", 1.0f);
+    c.action = j.value("action", false);
+    c.contact_damage = j.value("contact_damage", 1);
+    if (j.contains("segments")) c.segments = j["segments"].get<std::vector<BossSegmentConfig>>();
+    if (j.contains("events")) c.events = j["events"].get<std::vector<BossEventConfig>>();
+    if (j.contains("transitions")) c.transitions = j["transitions"].get<std::vector<BossTransitionConfig>>();
+
+    for (auto& segment : c.segments) if (segment.end <= 0.0f) segment.end = c.duration;
+    std::stable_sort(c.events.begin(), c.events.end(),
+        [](const BossEventConfig& a, const BossEventConfig& b) { return a.time < b.time; });
+}
+
+inline void from_json(const json& j, BossTimelineConfig& c) {
+    c.states.clear();
+    if (j.contains("states")) {
+        for (auto& [stateName, stateJson] : j["states"].items()) {
+            BossStateConfig state = stateJson.get<BossStateConfig>();
+            state.name = stateName;
+            c.states.push_back(std::move(state));
+        }
+    }
+
+    // Nomes -> índices, e ids globais para quem precisa de tabelas por segmento/evento
+    std::string initial = j.value("initial", std::string());
+    c.initial = std::max(0, c.findState(initial));
+    if (c.findState(initial) < 0) LOG_ERROR(LogCategory::Config, "timeline sem estado inicial '", initial, "'");
+    c.segment_count = 0;
+    c.event_count = 0;
+    for (auto& state : c.states) {
+        for (auto& segment : state.segments) segment.id = c.segment_count++;
+        for (auto& event : state.events) event.id = c.event_count++;
+        for (auto& transition : state.transitions) {
+            transition.to_index = c.findState(transition.to);
+            if (transition.to_index < 0)
+                LOG_ERROR(LogCategory::Config, "transicao de '", state.name, "' para estado inexistente '", transition.to, "'");
+            if (!transition.last_action.empty()) transition.last_action_index = c.findState(transition.last_action);
+        }
+        if (state.transitions.empty())
+            LOG_ERROR(LogCategory::Config, "estado '", state.name, "' nao tem transicoes");
+    }
+}
+
+// Archetypes
+inline void copyArchetypeName(char* dst, std::size_t size, const std::string& src) {
+    std::strncpy(dst, src.c_str(), size - 1);
+    dst[size - 1] = '\0';
+}
+
+inline void from_json(const json& j, ArchetypeRect& c) {
+    // Aceita [x, y, w, h] ou { "x", "y", "width", "height" }
+    if (j.is_array() && j.size() == 4) {
+        c = { j[0].get<int>(), j[1].get<int>(), j[2].get<int>(), j[3].get<int>() };
+        return;
+    }
+    c.x = j.value("x", c.x);
+    c.y = j.value("y", c.y);
+    c.width = j.value("width", c.width);
+    c.height = j.value("height", c.height);
+}
+
+inline void from_json(const json& j, ArchetypeClip& c) {
+    c.frame_duration = j.value("frame_duration", c.frame_duration);
+    if (j.contains("frames")) {
+        const auto& frames = j["frames"];
+        c.frame_count = static_cast<std::uint8_t>(std::min(frames.size(), kMaxClipFrames));
+        for (std::size_t i = 0; i < c.frame_count; ++i) from_json(frames[i], c.frames[i]);
+        if (frames.size() > kMaxClipFrames)
+            LOG_ERROR(LogCategory::Config, "clip '", c.name, "' tem mais de ", kMaxClipFrames, " frames");
+    }
+}
+
+inline void from_json(const json& j, ArchetypeAttack& c) {
+    copyArchetypeName(c.pattern, kArchetypeNameSize, j.get<std::string>());
+    c.pattern_id = -1;
+}
+
+inline void from_json(const json& j, ArchetypeStats& c) {
+    c.health = j.value("health", c.health);
+    c.max_health = j.value("max_health", std::max(c.max_health, c.health));
+    c.speed = j.value("speed", c.speed);
+    c.scale = j.value("scale", c.scale);
+}
+
+inline void from_json(const json& j, ArchetypeTiming& c) {
+    c.idle_time = j.value("idle_time", c.idle_time);
+    c.recover_time = j.value("recover_time", c.recover_time);
+    c.windup_start = j.value("windup_start", c.windup_start);
+    c.windup_end = j.value("windup_end", c.windup_end);
+    c.throw_time = j.value("throw_time", c.throw_time);
+}
+
+inline void from_json(const json& j, ArchetypeMovement& c) {
+    c.walk_distance = j.value("walk_distance", c.walk_distance);
+    c.aggro_range = j.value("aggro_range", c.aggro_range);
+    c.aggro_band = j.value("aggro_band", c.aggro_band);
+}
+
+inline void from_json(const json& j, ArchetypeProjectile& c) {
+    c.speed = j.value("speed", c.speed);
+    c.range = j.value("range", c.range);
+    c.return_speed = j.value("return_speed", c.return_speed);
+    c.deceleration = j.value("deceleration", c.deceleration);
+    c.return_threshold = j.value("return_threshold", c.return_threshold);
+    c.catch_distance = j.value("catch_distance", c.catch_distance);
+    if (j.contains("hitbox")) from_json(j["hitbox"], c.hitbox);
+}
+
+// Aplica 'j' por cima de 'c' (que pode já ter os valores do arquétipo base)
+inline void from_json(const json& j, EnemyArchetype& c) {
+    if (j.contains("kind")) {
+        std::string kind = j["kind"].get<std::string>();
+        if (kind == "chubby") c.kind = ArchetypeKind::Chubby;
+        else if (kind == "monstro") c.kind = ArchetypeKind::Monstro;
+        else LOG_ERROR(LogCategory::Config, "kind desconhecido '", kind, "' no arquetipo '", c.name, "'");
+    }
+    c.spawn_weight = j.value("spawn_weight", c.spawn_weight);
+    if (j.contains("timeline")) copyArchetypeName(c.timeline, kArchetypeNameSize, j["timeline"].get<std::string>());
+    if (j.contains("stats")) from_json(j["stats"], c.stats);
+    if (j.contains("hitbox")) from_json(j["hitbox"], c.hitbox);
+    if (j.contains("timing")) from_json(j["timing"], c.timing);
+    if (j.contains("movement")) from_json(j["movement"], c.movement);
+    if (j.contains("projectile")) from_json(j["projectile"], c.projectile);
+
+    // Clips e ataques juntam-se por nome: o mesmo nome substitui o do base
+    if (j.contains("clips")) {
+        for (auto& [clipName, clipJson] : j["clips"].items()) {
+            int index = c.findClip(clipName.c_str());
+            if (index < 0) {
+                if (c.clip_count >= kMaxArchetypeClips) {
+                    LOG_ERROR(LogCategory::Config, "arquetipo '", c.name, "' tem demasiados clips");
+                    continue;
+                }
+                index = c.clip_count++;
+                c.clips[index] = ArchetypeClip();
+                copyArchetypeName(c.clips[index].name, kArchetypeClipNameSize, clipName);
+            }
+            from_json(clipJson, c.clips[index]);
+        }
+    }
+    if (j.contains("attacks")) {
+        for (auto& [attackName, attackJson] : j["attacks"].items()) {
+            int index = c.findAttack(attackName.c_str());
+            if (index < 0) {
+                if (c.attack_count >= kMaxArchetypeAttacks) {
+                    LOG_ERROR(LogCategory::Config, "arquetipo '", c.name, "' tem demasiados ataques");
+                    continue;
+                }
+                index = c.attack_count++;
+                c.attacks[index] = ArchetypeAttack();
+                copyArchetypeName(c.attacks[index].name, kArchetypeClipNameSize, attackName);
+            }
+            from_json(attackJson, c.attacks[index]);
+        }
+    }
+}
+
+// Clips e ataques que o código de cada tipo procura pelo nome
+inline bool validateArchetype(const EnemyArchetype& a) {
+    static const char* chubbyClips[] = { "idle", "walk",
+        "windup_side", "windup_down", "windup_up", "throw_side", "throw_down", "throw_up",
+        "boomerang_side", "boomerang_down", "boomerang_up", "return_side", "return_down", "return_up" };
+    // Os restantes clips e ataques do Monstro vêm da timeline (validateBossTimeline)
+    static const char* monstroClips[] = { "idle" };
+
+    bool ok = true;
+    auto require = [&](bool present, const char* what, const char* item) {
+        if (present) return;
+        LOG_ERROR(LogCategory::Config, "arquetipo '", a.name, "' sem ", what, " '", item, "'");
+        ok = false;
+        };
+    if (a.kind == ArchetypeKind::Chubby) {
+        for (const char* clip : chubbyClips) require(a.findClip(clip) >= 0 && a.clips[a.findClip(clip)].frame_count > 0, "clip", clip);
+    }
+    else {
+        for (const char* clip : monstroClips) require(a.findClip(clip) >= 0 && a.clips[a.findClip(clip)].frame_count > 0, "clip", clip);
+        require(a.timeline[0] != '\0', "campo", "timeline");
+    }
+    return ok;
+}
+
+// Clips e ataques que a timeline pede têm de existir no arquétipo
+inline bool validateBossTimeline(const EnemyArchetype& a, const BossTimelineConfig& timeline) {
+    bool ok = true;
+    for (const auto& state : timeline.states) {
+        for (const auto& segment : state.segments) {
+            if (segment.clip.empty() || a.findClip(segment.clip.c_str()) >= 0) continue;
+            LOG_ERROR(LogCategory::Config, "timeline '", timeline.name, "' pede o clip '", segment.clip, "' que o arquetipo '", a.name, "' nao tem");
+            ok = false;
+        }
+        for (const auto& event : state.events) {
+            if (event.kind != BossEventKind::Attack || a.findAttack(event.attack.c_str()) >= 0) continue;
+            LOG_ERROR(LogCategory::Config, "timeline '", timeline.name, "' pede o ataque '", event.attack, "' que o arquetipo '", a.name, "' nao tem");
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+// Resolve 'name' (e o seu "base", recursivamente) e devolve o índice na tabela, ou -1
+inline int resolveArchetype(const json& all, const std::string& name, ArchetypeTable& table, int depth = 0) {
+    int existing = table.find(name);
+    if (existing >= 0) return existing;
+    if (!all.contains(name)) {
+        LOG_ERROR(LogCategory::Config, "arquetipo '", name, "' nao existe");
+        return -1;
+    }
+    if (depth > 8) {
+        LOG_ERROR(LogCategory::Config, "cadeia de 'base' demasiado longa (ciclo?) em '", name, "'");
+        return -1;
+    }
+
+    const json& entry = all[name];
+    EnemyArchetype record;
+    if (entry.contains("base")) {
+        std::string baseName = entry["base"].get<std::string>();
+        int baseIndex = resolveArchetype(all, baseName, table, depth + 1);
+        if (baseIndex < 0) return -1;
+        record = table.records[baseIndex];
+        copyArchetypeName(record.base, kArchetypeNameSize, baseName);
+    }
+    copyArchetypeName(record.name, kArchetypeNameSize, name);
+    from_json(entry, record);
+
+    if (!validateArchetype(record)) return -1;
+    table.records.push_back(record);
+    return static_cast<int>(table.records.size()) - 1;
+}
+
+inline void from_json(const json& j, ArchetypeTable& c) {
+    c.records.clear();
+    for (auto& [name, entry] : j.items()) resolveArchetype(j, name, c);
+}
+
 // Game Bounds
 inline void from_json(const json& j, GameBoundsConfig& c) {
     c.left = j.value("left", 213.33f);
@@ -510,6 +1259,14 @@ inline void from_json(const json& j, DungeonConfig::ExtraDoorChance& c) {
     }
 }
 
+inline void from_json(const json& j, DungeonConfig::FloorConfig& c) {
+    c.min_rooms = j.value("min_rooms", 6);
+    c.max_rooms = std::max(c.min_rooms, j.value("max_rooms", 16));
+    c.enemy_health_multiplier = j.value("enemy_health_multiplier", 1.0f);
+    c.extra_enemies = std::max(0, j.value("extra_enemies", 0));
+    c.chubby_room_chance = std::clamp(j.value("chubby_room_chance", 40), 0, 100);
+}
+
 // Dungeon - ATUALIZADO COM MIN/MAX ROOMS
 inline void from_json(const json& j, DungeonConfig& c) {
     c.min_rooms = j.value("min_rooms", 6);
@@ -521,6 +1278,14 @@ inline void from_json(const json& j, DungeonConfig& c) {
     if (j.contains("extra_door_chances") && j["extra_door_chances"].is_array()) {
         c.extra_door_chances = j["extra_door_chances"].get<std::vector<DungeonConfig::ExtraDoorChance>>();
     }
+    c.generator_attempts = std::max(1, j.value("generator_attempts", 16));
+    c.min_boss_distance = std::max(1, j.value("min_boss_distance", 3));
+    c.fixed_seed = j.value("fixed_seed", 0u);
+    c.layout_cache = j.value("layout_cache", false);
+    c.layout_cache_dir = j.value("layout_cache_dir", std::string("dungeon_cache"));
+    if (j.contains("floors") && j["floors"].is_array()) {
+        c.floors = j["floors"].get<std::vector<DungeonConfig::FloorConfig>>();
+    }
 }
 
 // UI
@@ -590,6 +1355,98 @@ inline void from_json(const json& j, MinimapConfig& c) {
     c.cleared_room_outline_thickness = j.value("cleared_room_outline_thickness", 1.0f);
 }
 
+// Collision
+inline void from_json(const json& j, CollisionConfig& c) {
+    c.swept_projectiles = j.value("swept_projectiles", true);
+    if (j.contains("isaac_tear_hitbox")) from_json(j["isaac_tear_hitbox"], c.isaac_tear_hitbox);
+    if (j.contains("enemy_tear_hitbox")) from_json(j["enemy_tear_hitbox"], c.enemy_tear_hitbox);
+}
+
+// Parallel
+inline void from_json(const json& j, ParallelConfig& c) {
+    c.worker_threads = j.value("worker_threads", 0);
+    c.parallel_ai = j.value("parallel_ai", true);
+    c.ai_chunk_size = j.value("ai_chunk_size", 4);
+    c.ai_min_parallel_enemies = j.value("ai_min_parallel_enemies", 8);
+}
+
+// Room Scheduler
+inline void from_json(const json& j, RoomSchedulerConfig& c) {
+    c.background_rooms = j.value("background_rooms", false);
+    c.background_hz = j.value("background_hz", 10.0f);
+    c.max_rooms_per_tick = j.value("max_rooms_per_tick", 4);
+    c.time_slice_ms = j.value("time_slice_ms", 2.0f);
+    c.max_catchup_seconds = j.value("max_catchup_seconds", 0.5f);
+}
+
+// Navigation
+inline void from_json(const json& j, NavigationConfig& c) {
+    c.flow_field = j.value("flow_field", true);
+    c.cell_size = j.value("cell_size", 64.0f);
+}
+
+inline void from_json(const json& j, ObstacleConfig& c) {
+    c.enabled = j.value("enabled", true);
+    c.tile_size = j.value("tile_size", 64.0f);
+    c.clusters_min = j.value("clusters_min", 3);
+    c.clusters_max = j.value("clusters_max", 7);
+    c.cluster_tiles_max = j.value("cluster_tiles_max", 4);
+    c.pit_chance = j.value("pit_chance", 0.25f);
+    c.corridor_tiles = j.value("corridor_tiles", 3);
+}
+
+inline void from_json(const json& j, SteeringConfig& c) {
+    c.enabled = j.value("enabled", true);
+    c.cell_size = j.value("cell_size", 128.0f);
+    c.separation_scale = j.value("separation_scale", 1.0f);
+    c.separation_weight = j.value("separation_weight", 1.5f);
+    c.max_neighbors = j.value("max_neighbors", 8);
+    c.arrival_radius = j.value("arrival_radius", 100.0f);
+    c.slowing_radius = j.value("slowing_radius", 220.0f);
+    c.wall_probe = j.value("wall_probe", 48.0f);
+    c.wall_weight = j.value("wall_weight", 1.0f);
+}
+
+inline void from_json(const json& j, EventsConfig& c) {
+    c.console_log = j.value("console_log", false);
+}
+
+inline void from_json(const json& j, LoggingConfig& c) {
+    c.level = j.value("level", std::string("info"));
+    c.console = j.value("console", true);
+    c.file = j.value("file", std::string("game.log"));
+    c.queue_capacity = j.value("queue_capacity", 1024);
+    c.flush_interval_ms = j.value("flush_interval_ms", 5);
+    if (j.contains("rate_limits")) {
+        c.rate_limits.clear();
+        for (const auto& [name, perSecond] : j["rate_limits"].items()) c.rate_limits.emplace_back(name, perSecond.get<int>());
+    }
+}
+
+inline void from_json(const json& j, AssetsConfig& c) {
+    c.use_pack = j.value("use_pack", true);
+    c.pack_file = j.value("pack_file", std::string("assets.pak"));
+    c.texture_budget_mb = j.value("texture_budget_mb", 256);
+}
+
+inline void from_json(const json& j, SaveConfig& c) {
+    c.enabled = j.value("enabled", true);
+    c.file = j.value("file", std::string("run.sav"));
+    c.resume = j.value("resume", true);
+}
+
+inline void from_json(const json& j, GymConfig& c) {
+    c.step_dt = j.value("step_dt", 1.f / 60.f);
+    c.frame_skip = j.value("frame_skip", 4);
+    c.max_steps = j.value("max_steps", 3000);
+    c.reward_hit = j.value("reward_hit", 0.1f);
+    c.reward_kill = j.value("reward_kill", 1.f);
+    c.reward_room_clear = j.value("reward_room_clear", 5.f);
+    c.reward_hurt = j.value("reward_hurt", -1.f);
+    c.reward_death = j.value("reward_death", -10.f);
+    c.reward_step = j.value("reward_step", -0.001f);
+}
+
 // Game
 inline void from_json(const json& j, GameConfig_General& c) {
     c.window_width = j.value("window_width", 1920);
@@ -604,6 +1461,17 @@ inline void from_json(const json& j, GameConfig_General& c) {
     if (j.contains("door_boss")) c.door_boss = j["door_boss"].get<DoorVisualConfig>(); // NOVO
     if (j.contains("door_treasure")) c.door_treasure = j["door_treasure"].get<DoorVisualConfig>(); // NOVO
     if (j.contains("minimap")) c.minimap = j["minimap"].get<MinimapConfig>();
+    if (j.contains("collision")) c.collision = j["collision"].get<CollisionConfig>();
+    if (j.contains("parallel")) c.parallel = j["parallel"].get<ParallelConfig>();
+    if (j.contains("room_scheduler")) c.room_scheduler = j["room_scheduler"].get<RoomSchedulerConfig>();
+    if (j.contains("navigation")) c.navigation = j["navigation"].get<NavigationConfig>();
+    if (j.contains("obstacles")) c.obstacles = j["obstacles"].get<ObstacleConfig>();
+    if (j.contains("steering")) c.steering = j["steering"].get<SteeringConfig>();
+    if (j.contains("events")) c.events = j["events"].get<EventsConfig>();
+    if (j.contains("logging")) c.logging = j["logging"].get<LoggingConfig>();
+    if (j.contains("assets")) c.assets = j["assets"].get<AssetsConfig>();
+    if (j.contains("save")) c.save = j["save"].get<SaveConfig>();
+    if (j.contains("gym")) c.gym = j["gym"].get<GymConfig>();
 }
 
 // Corner Textures Option
@@ -643,6 +1511,41 @@ inline void from_json(const json& j, GameConfig& c) {
     if (j.contains("player")) c.player = j["player"].get<PlayerConfig>();
     if (j.contains("demon")) c.demon = j["demon"].get<DemonConfig>();
     if (j.contains("bishop")) c.bishop = j["bishop"].get<BishopConfig>();
+    if (j.contains("bullet_patterns")) {
+        c.bullet_patterns.clear();
+        for (auto& [name, entry] : j["bullet_patterns"].items()) {
+            BulletPatternConfig pattern = entry.get<BulletPatternConfig>();
+            pattern.name = name;
+            c.bullet_patterns.push_back(pattern);
+        }
+    }
+    if (j.contains("boss_timelines")) {
+        c.boss_timelines.clear();
+        for (auto& [name, entry] : j["boss_timelines"].items()) {
+            BossTimelineConfig timeline = entry.get<BossTimelineConfig>();
+            timeline.name = name;
+            c.boss_timelines.push_back(std::move(timeline));
+        }
+    }
+    if (j.contains("archetypes")) c.archetypes = j["archetypes"].get<ArchetypeTable>();
+    else LOG_ERROR(LogCategory::Config, "config sem 'archetypes' (Chubby e Monstro nao vao aparecer)");
+
+    // Os ataques dos arquetipos apontam para padroes pelo nome: resolve os indices uma vez
+    for (auto& record : c.archetypes.records) {
+        for (int i = 0; i < record.attack_count; ++i) {
+            ArchetypeAttack& attack = record.attacks[i];
+            attack.pattern_id = findBulletPattern(c.bullet_patterns, attack.pattern);
+            if (attack.pattern_id < 0)
+                LOG_ERROR(LogCategory::Config, "arquetipo '", record.name, "' usa o padrao '", attack.pattern, "' que nao existe");
+        }
+        if (record.timeline[0] != '\0') {
+            record.timeline_id = findBossTimeline(c.boss_timelines, record.timeline);
+            if (record.timeline_id < 0)
+                LOG_ERROR(LogCategory::Config, "arquetipo '", record.name, "' usa a timeline '", record.timeline, "' que nao existe");
+            else if (!validateBossTimeline(record, c.boss_timelines[record.timeline_id]))
+                record.timeline_id = -1;
+        }
+    }
     if (j.contains("game")) c.game = j["game"].get<GameConfig_General>();
     if (j.contains("corners")) c.corners = j["corners"].get<CornerTextureConfig>();
     if (j.contains("projectile_textures")) {
@@ -0,0 +1,117 @@
+#ifndef GYMENV_HPP
+#define GYMENV_HPP
+
+#include "Simulation.hpp"
+#include "EventBus.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Acoes discretas: 9 movimentos (parado + 8 direcoes) x 5 tiros (nenhum + 4 direcoes).
+// acao = movimento * kGymShootActions + tiro
+constexpr int kGymMoveActions = 9;
+constexpr int kGymShootActions = 5;
+constexpr int kGymActionCount = kGymMoveActions * kGymShootActions;
+
+// Observacao de tamanho fixo (floats). Posicoes do Isaac em [0, 1] dentro dos limites
+// da sala; inimigos e projeteis relativos ao Isaac, divididos pelo tamanho da sala.
+// Os lugares que sobram ficam a zero (o ultimo campo de cada um diz se esta ocupado).
+//   Isaac:     x, y, vida
+//   Sala:      limpa, andar, em transicao, porta N, S, E, W
+//   Inimigos:  kGymObservedEnemies x (dx, dy, vida, ocupado), pela ordem das listas da sala
+//   Projeteis: kGymObservedProjectiles x (dx, dy, ocupado), dos inimigos e boomerangs
+constexpr int kGymObservedEnemies = 8;
+constexpr int kGymObservedProjectiles = 16;
+constexpr int kGymObservationSize = 3 + 7 + kGymObservedEnemies * 4 + kGymObservedProjectiles * 3;
+
+// Texturas vazias partilhadas por todas as simulacoes headless (GymEnv e benchmarks).
+// Os clips da AnimationLibrary apontam para elas, por isso quem cria inimigos sem
+// janela tem de usar estas. Criadas no primeiro pedido (a config ja carregada).
+struct HeadlessTextures {
+    HeadlessTextures();
+
+    std::vector<sf::Texture> frames;
+    sf::Texture sheet;
+    EnemyTextures enemies;
+    PlayerTextures player;
+};
+
+HeadlessTextures& headlessTextures();
+
+struct GymStep {
+    float reward = 0.f;
+    bool done = false;          // O Isaac morreu ou o episodio chegou ao max_steps
+    bool truncated = false;     // done por causa do max_steps
+};
+
+// Uma run headless com a interface dos ambientes de RL: reset(seed) e step(acao) ->
+// observacao, recompensa, fim. A recompensa sai dos eventos do tick (config "gym"),
+// por isso cada ambiente tem o seu EventBus. Um step dentro de uma sala nao aloca
+// (entrar numa sala nova constroi os inimigos; o reset constroi o andar).
+//
+// Como no Game, a config e o BulletPatternLibrary tem de estar carregados antes. Para
+// correr ambientes noutras threads e preciso GymEnv::prepare() na thread principal
+// (o VecEnv chama-o): a AnimationLibrary so e escrita nessa altura.
+class GymEnv {
+public:
+    GymEnv();
+    ~GymEnv();
+    GymEnv(const GymEnv&) = delete;
+    GymEnv& operator=(const GymEnv&) = delete;
+
+    // Texturas vazias partilhadas e clips de todos os inimigos. Idempotente.
+    static void prepare();
+
+    void reset(std::uint32_t seed, float* observation);
+    GymStep step(int action, float* observation);
+
+    Simulation& simulation() { return sim; }
+    int steps() const { return stepCount; }
+
+private:
+    void observe(float* observation);
+    void onEvents(const std::vector<GameEvent>& events);
+
+    EventBus bus;
+    int subscription = 0;
+    Simulation sim;
+    PlayerInput input;
+    int stepCount = 0;
+    float pendingReward = 0.f;
+};
+
+// N ambientes com buffers contiguos (observacoes N x kGymObservationSize). Um ambiente
+// que acaba recomeca logo com a seed seguinte dele (seed + N): a observacao devolvida
+// ja e a do episodio novo.
+class VecEnv {
+public:
+    explicit VecEnv(std::size_t count);
+
+    std::size_t size() const { return envs.size(); }
+
+    // O ambiente i comeca com seed + i
+    void reset(std::uint32_t seed);
+    // 'actions' tem size() entradas
+    void step(const int* actions);
+    // O mesmo, repartido pelo JobSystem (um bloco de ambientes por job)
+    void stepParallel(const int* actions);
+
+    const float* observations() const { return observationBuffer.data(); }
+    const float* rewards() const { return rewardBuffer.data(); }
+    const std::uint8_t* dones() const { return doneBuffer.data(); }
+    const std::uint8_t* truncations() const { return truncatedBuffer.data(); }
+    GymEnv& env(std::size_t index) { return *envs[index]; }
+
+private:
+    void stepRange(const int* actions, std::size_t begin, std::size_t end);
+
+    std::vector<std::unique_ptr<GymEnv>> envs;
+    std::vector<std::uint32_t> seeds;
+    std::vector<float> observationBuffer;
+    std::vector<float> rewardBuffer;
+    std::vector<std::uint8_t> doneBuffer;
+    std::vector<std::uint8_t> truncatedBuffer;
+};
+
+#endif // GYMENV_HPP
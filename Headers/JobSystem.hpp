@@ -0,0 +1,92 @@
+#ifndef JOBSYSTEM_HPP
+#define JOBSYSTEM_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Quem pode executar o job. WorkersOnly e para trabalho de fundo que nunca deve
+// correr na thread principal (nem quando ela ajuda num wait/parallelFor).
+enum class JobLane {
+    Any,
+    WorkersOnly
+};
+
+// Contador de um grupo de jobs. O wait() termina quando chega a zero.
+class JobCounter {
+public:
+    bool done() const { return pending.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class JobSystem;
+    std::atomic<int> pending{ 0 };
+    std::mutex errorMutex;
+    std::exception_ptr error;
+};
+
+// Pool de threads com work stealing: cada worker tem a sua fila, tira jobs do fim
+// da propria fila e, quando fica sem trabalho, rouba do inicio das filas dos outros.
+// A thread que espera (wait/parallelFor) tambem executa jobs em vez de ficar parada.
+class JobSystem {
+public:
+    static JobSystem& getInstance();
+
+    // 0 = numero de nucleos - 1 (a thread principal tambem trabalha)
+    void start(int workerThreads);
+    void stop();
+
+    std::size_t workerCount() const { return workers.size(); }
+
+    // Agenda 'job' e incrementa 'counter'. Sem workers o job corre logo aqui
+    // (quem usa JobLane::WorkersOnly deve verificar workerCount() antes).
+    void submit(std::function<void()> job, JobCounter& counter, JobLane lane = JobLane::Any);
+
+    // Espera pelo grupo, ajudando a executar jobs. Relanca a primeira excecao do grupo.
+    void wait(JobCounter& counter);
+
+    // Divide [0, count) em blocos de 'grain' e chama fn(begin, end, blockIndex) para cada um.
+    // O indice do bloco permite a quem chama ter buffers por bloco e junta-los por ordem.
+    void parallelFor(std::size_t count, std::size_t grain,
+        const std::function<void(std::size_t, std::size_t, std::size_t)>& fn);
+
+    static std::size_t blockCount(std::size_t count, std::size_t grain);
+
+    ~JobSystem();
+
+private:
+    JobSystem() = default;
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    struct Job {
+        std::function<void()> fn;
+        JobCounter* counter = nullptr;
+        JobLane lane = JobLane::Any;
+    };
+
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Job> queue;
+        std::thread thread;
+    };
+
+    void workerLoop(std::size_t index);
+    bool tryRunOne(std::size_t preferred);
+    static void execute(Job& job);
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<std::size_t> nextQueue{ 0 };
+    std::atomic<int> queued{ 0 };
+    std::atomic<bool> running{ false };
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+};
+
+#endif // JOBSYSTEM_HPP
@@ -0,0 +1,186 @@
+#ifndef LOGGER_HPP
+#define LOGGER_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+
+struct LoggingConfig;
+
+enum class LogLevel : std::uint8_t {
+    Trace,
+    Debug,
+    Info,
+    Warn,
+    Error,
+    Off
+};
+
+// Categorias com limite de mensagens por segundo proprio (ver LoggingConfig::rate_limits)
+enum class LogCategory : std::uint8_t {
+    General,
+    Assets,
+    Config,
+    Combat,
+    AI,
+    Rooms,
+    Count
+};
+
+// Nivel minimo compilado: as chamadas abaixo dele desaparecem do executavel (os
+// argumentos nem sao avaliados). Pode ser definido no projeto (0 = Trace ... 5 = Off).
+#ifndef GAME_LOG_LEVEL
+#ifdef NDEBUG
+#define GAME_LOG_LEVEL 2
+#else
+#define GAME_LOG_LEVEL 1
+#endif
+#endif
+
+constexpr LogLevel kCompiledLogLevel = static_cast<LogLevel>(GAME_LOG_LEVEL);
+constexpr std::size_t kLogCategoryCount = static_cast<std::size_t>(LogCategory::Count);
+
+const char* logLevelName(LogLevel level);
+const char* logCategoryName(LogCategory category);
+bool logLevelFromName(std::string_view name, LogLevel& level);
+bool logCategoryFromName(std::string_view name, LogCategory& category);
+
+// Uma mensagem ja formatada, de tamanho fixo (o texto e cortado se nao couber)
+struct LogRecord {
+    static constexpr std::size_t kTextSize = 232;
+
+    float time = 0.f;                   // Segundos desde o arranque do logger
+    LogLevel level = LogLevel::Info;
+    LogCategory category = LogCategory::General;
+    std::uint16_t length = 0;
+    char text[kTextSize];
+
+    void append(std::string_view value) {
+        std::size_t n = std::min(value.size(), kTextSize - length);
+        std::memcpy(text + length, value.data(), n);
+        length = static_cast<std::uint16_t>(length + n);
+    }
+    void append(const char* value) { append(std::string_view(value ? value : "(null)")); }
+    void append(const std::string& value) { append(std::string_view(value)); }
+    void append(char value) { append(std::string_view(&value, 1)); }
+    void append(bool value) { append(value ? "true" : "false"); }
+
+    template <typename T>
+    std::enable_if_t<std::is_arithmetic_v<T>> append(T value) {
+        char* end = text + kTextSize;
+        std::to_chars_result result;
+        if constexpr (std::is_floating_point_v<T>) result = std::to_chars(text + length, end, value, std::chars_format::fixed, 2);
+        else result = std::to_chars(text + length, end, value);
+        if (result.ec == std::errc()) length = static_cast<std::uint16_t>(result.ptr - text);
+    }
+
+    template <typename T>
+    std::enable_if_t<std::is_enum_v<T>> append(T value) { append(static_cast<std::underlying_type_t<T>>(value)); }
+};
+
+// Logger assincrono: quem regista formata a mensagem num LogRecord e mete-o numa
+// fila circular sem locks (varios produtores); uma thread de escrita esvazia a
+// fila e escreve na consola e no ficheiro com um flush por lote. Fila cheia ou
+// categoria acima do limite por segundo = a mensagem e descartada e contada,
+// nunca se bloqueia o frame. Antes de start() (e depois de stop()) escreve logo.
+class Logger {
+public:
+    static Logger& getInstance();
+
+    void start(const LoggingConfig& config);
+    void stop();
+
+    void setLevel(LogLevel level) { runtimeLevel.store(level, std::memory_order_relaxed); }
+    // 0 = sem limite. Warn e Error nunca sao limitados.
+    void setRateLimit(LogCategory category, int perSecond);
+
+    template <typename... Args>
+    void log(LogLevel level, LogCategory category, const Args&... args) {
+        if (!accept(level, category)) return;
+        LogRecord record;
+        record.level = level;
+        record.category = category;
+        (record.append(args), ...);
+        push(record);
+    }
+
+    std::uint64_t droppedCount() const { return dropped.load(std::memory_order_relaxed); }
+
+    ~Logger();
+
+private:
+    Logger();
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    // Fila MPSC limitada: cada celula tem um numero de sequencia que diz se esta
+    // livre para o produtor da volta atual ou pronta para o consumidor
+    struct Cell {
+        std::atomic<std::size_t> sequence{ 0 };
+        LogRecord record;
+    };
+
+    struct alignas(64) CategoryLimit {
+        std::atomic<int> perSecond{ 0 };
+        std::atomic<std::int64_t> windowStart{ 0 };
+        std::atomic<int> count{ 0 };
+        std::atomic<int> suppressed{ 0 };
+    };
+
+    bool accept(LogLevel level, LogCategory category);
+    void push(LogRecord& record);
+    bool pop(LogRecord& record);
+    void writerLoop();
+    void drain();
+    void writeNow(const LogRecord& record);
+    void format(const LogRecord& record, std::string& out) const;
+    std::int64_t elapsedMs() const;
+
+    std::unique_ptr<Cell[]> cells;
+    std::size_t mask = 0;
+    alignas(64) std::atomic<std::size_t> enqueuePos{ 0 };
+    alignas(64) std::size_t dequeuePos = 0;
+
+    std::atomic<LogLevel> runtimeLevel{ kCompiledLogLevel };
+    std::array<CategoryLimit, kLogCategoryCount> limits;
+    std::atomic<std::uint64_t> dropped{ 0 };
+    std::uint64_t reportedDropped = 0;
+
+    std::chrono::steady_clock::time_point startTime;
+    std::atomic<bool> running{ false };
+    std::thread writer;
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    std::chrono::milliseconds flushInterval{ 5 };
+
+    // Sinks (so a thread de escrita lhes toca enquanto o logger corre)
+    std::mutex sinkMutex;
+    bool console = true;
+    std::ofstream file;
+    std::string outBatch;
+    std::string errBatch;
+    std::string fileBatch;
+};
+
+#define GAME_LOG(level, category, ...) \
+    do { if constexpr ((level) >= kCompiledLogLevel) Logger::getInstance().log((level), (category), __VA_ARGS__); } while (0)
+
+#define LOG_TRACE(category, ...) GAME_LOG(LogLevel::Trace, category, __VA_ARGS__)
+#define LOG_DEBUG(category, ...) GAME_LOG(LogLevel::Debug, category, __VA_ARGS__)
+#define LOG_INFO(category, ...) GAME_LOG(LogLevel::Info, category, __VA_ARGS__)
+#define LOG_WARN(category, ...) GAME_LOG(LogLevel::Warn, category, __VA_ARGS__)
+#define LOG_ERROR(category, ...) GAME_LOG(LogLevel::Error, category, __VA_ARGS__)
+
+#endif // LOGGER_HPP
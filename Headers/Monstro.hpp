@@ -2,49 +2,55 @@
 #define MONSTRO_HPP
 
 #include "enemy.hpp"
-#include <map>
+#include "BossTimeline.hpp"
 #include <vector>
-
-enum class MonstroState {
-    Idle,
-    Walking,
-    Attacking,
-    MegaJumping,
-    Falling,
-    Cooldown
-};
+#include <optional>
 
 class Monstro : public EnemyBase {
 public:
-    Monstro(sf::Texture& texture, sf::Texture& projectileTex, sf::Vector2f startPos);
+    // 'archetype' e copiado para a entidade (registo POD, sem lookups depois do spawn)
+    Monstro(const EnemyArchetype& archetype, sf::Texture& texture, sf::Texture& projectileTex, sf::Vector2f startPos);
     void update(float deltaTime, sf::Vector2f playerPosition, const sf::FloatRect& gameBounds) override;
+    std::uint8_t getAuraTargetBit() const override { return AuraTargets::Monstro; }
     void draw(sf::RenderWindow& window) override;
     void setPosition(sf::Vector2f pos);
+    void scaleHealth(float multiplier) override;
 
-    // Adicionado para o Game.cpp conseguir ler o estado
-    MonstroState getState() const { return state; }
+    // timers[1] = vida maxima, values[5] = volleyCount; o resto dos slots e do BossBrain
+    void saveState(EnemyState& state, std::vector<ProjectileState>& projectiles) const override;
+    void loadState(const EnemyState& state, const ProjectileState* projectiles) override;
+
+    // Dano de contacto do estado atual da timeline (a queda tira mais)
+    int getContactDamage() const;
+    // Deslocamento do corpo no ultimo tick (colisao continua na queda)
+    sf::Vector2f getBodyMotion() const { return bodyStep; }
 
 private:
-    MonstroState state;
-    float stateTimer;
-    int animStep;
+    EnemyArchetype archetype;
+
+    // Comportamento vem da timeline do arquetipo ("boss_timelines")
+    std::optional<BossBrain> brain;
+    std::vector<BossOutput> brainOutput;
+
+    // Clips e padroes resolvidos no spawn, indexados pelo id do segmento/evento
+    const AnimationClip* clipIdle = nullptr;
+    std::vector<const AnimationClip*> segmentClips;
+    std::vector<const BulletPattern*> eventPatterns;
+    int volleyCount = 0;
+
     float baseScale = 3.1f;
-    bool lastActionWasAttack = false;
     float maxHealth;
 
-    sf::Vector2f groundPos;
-    sf::Vector2f groundPosTarget;
-    sf::Vector2f moveDir;
+    sf::Vector2f bodyStep;
 
     sf::CircleShape shadow;
     sf::Texture* projTex;
 
-    std::map<int, std::map<int, sf::IntRect>> frames;
-
-    void initFrames();
-    void setFrame(int coluna, int id);
+    void setClip(const AnimationClip* clip);
+    // Frame atual do playhead no sprite, com a origem nos pes
+    void applyFrame();
     void handleStates(float deltaTime, sf::Vector2f playerPos);
-    void spawnTears(int count, bool circular);
+    void spawnTears(const BulletPattern* pattern);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,81 @@
+#ifndef OBSTACLEGRID_HPP
+#define OBSTACLEGRID_HPP
+
+#include "SFML/Graphics.hpp"
+#include "GameConfig.hpp"
+#include <cstdint>
+#include <vector>
+
+enum class ObstacleKind : std::uint8_t {
+    None,
+    Rock,   // Bloqueia movimento e projeteis
+    Pit     // Bloqueia so o movimento (as lagrimas passam por cima)
+};
+
+// Que camada a consulta testa
+enum class ObstacleLayer : std::uint8_t {
+    Movement,
+    Projectiles
+};
+
+// Camada de obstaculos de uma sala: grelha de tiles sobre gameBounds guardada
+// como dois bitsets (um bit por tile e por camada, cada linha em palavras de 64).
+// Consultas de ponto, AABB e raio leem so os bits, sem percorrer listas de objetos.
+class ObstacleGrid {
+public:
+    void configure(const sf::FloatRect& bounds, float tileSize);
+
+    // Gera grupos de obstaculos com o rng da sala. Mantem livre a cruz entre as
+    // portas e garante que todos os tiles livres ficam ligados entre si.
+    void generate(const ObstacleConfig& config, std::uint32_t seed);
+
+    void set(int column, int row, ObstacleKind kind);
+    void clear();
+    ObstacleKind kindAt(int column, int row) const;
+
+    // Tile na posicao 'position' bloqueia a camada?
+    bool blocksPoint(sf::Vector2f position, ObstacleLayer layer) const;
+
+    // Algum tile bloqueado da camada intersecta 'rect'?
+    bool overlaps(const sf::FloatRect& rect, ObstacleLayer layer) const;
+
+    // Percorre os tiles entre 'from' e 'to' (DDA). Devolve true no primeiro tile
+    // bloqueado e escreve em 'hitFraction' a fracao [0, 1] do segmento ate ele.
+    bool raycast(sf::Vector2f from, sf::Vector2f to, ObstacleLayer layer, float& hitFraction) const;
+
+    // Deslocamento permitido para 'box' dentro de 'motion', eixo a eixo: o eixo
+    // bloqueado para encostado ao tile e o outro continua (desliza na parede).
+    sf::Vector2f resolveMotion(const sf::FloatRect& box, sf::Vector2f motion, ObstacleLayer layer) const;
+
+    sf::FloatRect tileBounds(int column, int row) const;
+    int columns() const { return cols; }
+    int rows() const { return rowCount; }
+    float tileSize() const { return tile; }
+    int solidCount() const { return solidTiles; }
+    bool empty() const { return solidTiles == 0; }
+
+private:
+    const std::vector<std::uint64_t>& bitsFor(ObstacleLayer layer) const;
+    bool testBit(const std::vector<std::uint64_t>& bits, int column, int row) const;
+    bool rowRangeBlocked(const std::vector<std::uint64_t>& bits, int row, int firstColumn, int lastColumn) const;
+    bool columnRangeBlocked(const std::vector<std::uint64_t>& bits, int column, int firstRow, int lastRow) const;
+    bool tileRange(const sf::FloatRect& rect, int& c0, int& r0, int& c1, int& r1) const;
+    bool freeTilesConnected(int requiredColumn, int requiredRow) const;
+
+    sf::FloatRect area;
+    float tile = 64.f;
+    int cols = 0;
+    int rowCount = 0;
+    int wordsPerRow = 0;
+    int solidTiles = 0;
+
+    std::vector<std::uint64_t> solid;   // Rochas + buracos (movimento)
+    std::vector<std::uint64_t> opaque;  // So rochas (projeteis)
+};
+
+// Rotina de movimento partilhada pelo jogador e pelos inimigos: leva a entidade de
+// 'from' para 'to' respeitando as bordas da sala e os obstaculos (pode ser nullptr).
+sf::Vector2f resolveMovement(sf::Vector2f from, sf::Vector2f to, const HitboxConfig& shape,
+    const sf::FloatRect& bounds, const ObstacleGrid* obstacles);
+
+#endif // OBSTACLEGRID_HPP
@@ -10,6 +10,10 @@
 #include "enemy.hpp"
 #include "Chubby.hpp"
 #include "Monstro.hpp" // Adicionado para reconhecer a classe Monstro
+#include "FlowField.hpp"
+#include "ObstacleGrid.hpp"
+#include "CrowdSteering.hpp"
+#include "EntityState.hpp"
 
 enum class DoorDirection {
     North,
@@ -39,6 +43,34 @@ enum class DoorState {
     Opening
 };
 
+// Inimigo sorteado quando o andar é gerado (pode ser num worker); o spawn na
+// thread principal só cria as entidades a partir disto
+enum class SpawnKind : std::uint8_t {
+    Demon,
+    Bishop,
+    Chubby,
+    Monstro
+};
+
+struct EnemySpawn {
+    SpawnKind kind = SpawnKind::Demon;
+    std::uint16_t archetype = 0;    // Índice na ArchetypeTable (Chubby/Monstro)
+    sf::Vector2f position;
+};
+
+// Texturas com que os inimigos são criados (resolvidas pelo RoomManager a cada spawn)
+struct EnemyTextures {
+    std::vector<sf::Texture>* demonDown = nullptr;
+    std::vector<sf::Texture>* demonUp = nullptr;
+    std::vector<sf::Texture>* demonLeft = nullptr;
+    std::vector<sf::Texture>* demonRight = nullptr;
+    sf::Texture* demonProjectile = nullptr;
+    std::vector<sf::Texture>* bishop = nullptr;
+    sf::Texture* chubbySheet = nullptr;
+    sf::Texture* chubbyProjectile = nullptr;
+    sf::Texture* monstroSheet = nullptr;
+};
+
 struct Door {
     DoorDirection direction = DoorDirection::None;
     DoorType type = DoorType::Normal;
@@ -53,32 +85,50 @@ struct Door {
     DoorState state = DoorState::Open;
     float animationProgress = 0.0f;
     int leadsToRoomID = -1;
+    sf::Vector2f position;      // Centro do sprite (os sprites só são criados no primeiro draw)
+    float rotation = 0.f;
 
     Door() = default;
 };
 
 class Room {
 public:
-    Room(int id, RoomType type, const sf::FloatRect& gameBounds);
+    // 'seed' decide os obstáculos; não usa rand() para poder ser construída num worker
+    Room(int id, RoomType type, const sf::FloatRect& gameBounds, std::uint32_t seed);
 
-    // Gestão de Portas
+    // Gestão de Portas. addDoor só guarda a posição e a hitbox; os sprites são
+    // criados quando a sala é desenhada pela primeira vez.
     void addDoor(DoorDirection direction, DoorType doorType, sf::Texture& doorSpritesheet);
     void connectDoor(DoorDirection direction, int targetRoomID);
 
-    // Spawn de Inimigos (Agora inclui Monstro)
-    void spawnEnemies(
-        std::vector<sf::Texture>& demonWalkDown,
-        std::vector<sf::Texture>& demonWalkUp,
-        std::vector<sf::Texture>& demonWalkLeft,
-        std::vector<sf::Texture>& demonWalkRight,
-        sf::Texture& demonProjectileTexture,
-        std::vector<sf::Texture>& bishopTextures,
-        sf::Texture& chubbySheet,
-        sf::Texture& chubbyProjSheet
-    );
+    // Sorteia os inimigos da sala com a dificuldade do andar (só dados, seguro num worker)
+    void rollRoster(std::mt19937& rng, const DungeonConfig::FloorConfig& floor);
+    // Roster já sorteado (planta em cache)
+    void setRoster(std::vector<EnemySpawn> spawns, float enemyHealthMultiplier);
+    const std::vector<EnemySpawn>& getRoster() const { return roster; }
+
+    // Spawn de Inimigos (Agora inclui Monstro): cria o roster sorteado
+    void spawnEnemies(const EnemyTextures& textures);
+
+    // Portas e inimigos, acrescentados aos vetores do snapshot. 'liveOnly' para o save
+    // da run; o WorldSnapshot guarda também os mortos (as listas ficam com o mesmo tamanho).
+    void captureState(RoomState& state, std::vector<DoorSaveState>& doorStates,
+        std::vector<EnemyState>& enemies, std::vector<ProjectileState>& projectiles, bool liveOnly) const;
+    // Repõe o que captureState guardou (a sala tem de ter sido criada da mesma planta).
+    // Os ponteiros apontam para o início dos vetores do snapshot. Se as listas já têm
+    // os mesmos inimigos, o estado é escrito por cima; senão são criados de novo.
+    void restoreState(const RoomState& state, const DoorSaveState* doorStates,
+        const EnemyState* enemies, const ProjectileState* projectiles, const EnemyTextures& textures);
+    // true se o restoreState não precisa de construir nada (nem das texturas)
+    bool restoresInPlace(const RoomState& state, const EnemyState* enemies) const;
 
     // Ciclo de Vida
     void update(float deltaTime, sf::Vector2f playerPosition);
+    // Tier de fundo: só a IA, em série (já corre num worker). 'cleared' e as portas
+    // continuam a ser só da thread principal.
+    void updateBackground(float deltaTime, sf::Vector2f targetPosition);
+    // false = a IA da sala ativa nunca usa os workers (simulações que já correm num)
+    void setParallelAI(bool enabled) { parallelAI = enabled; }
     void draw(sf::RenderWindow& window);
 
     // Getters Básicos
@@ -88,6 +138,7 @@ public:
     bool hasDoor(DoorDirection direction) const;
     int getDoorLeadsTo(DoorDirection direction) const;
     const std::vector<Door>& getDoors() const { return doors; }
+    const ObstacleGrid& getObstacles() const { return obstacles; }
 
     // GETTERS PARA O GAME.CPP
     std::vector<std::unique_ptr<Demon_ALL>>& getDemons() { return demons; }
@@ -101,13 +152,23 @@ public:
     void openDoors();
     void closeDoors();
 
+    // Alçapão para o andar seguinte (aparece quando a sala do boss fica limpa)
+    bool hasTrapdoor() const { return trapdoorOpen; }
+    sf::FloatRect getTrapdoorBounds() const;
+
     // Visual da Sala
     void setCornerTextureRect(const sf::IntRect& rect) { cornerTextureRect = rect; }
     sf::IntRect getCornerTextureRect() const { return cornerTextureRect; }
 
 private:
     void updateDoorAnimations(float deltaTime);
+    void buildDoorSprites();
+    EnemyBase* createEnemy(const EnemySpawn& spawn, const EnemyTextures& textures);
+    // 'foreground' = sala ativa na thread principal (pode usar os workers e o bus de eventos)
+    void updateEnemies(float deltaTime, sf::Vector2f playerPosition, bool foreground);
     void drawDoor(sf::RenderWindow& window, const Door& door) const;
+    void drawObstacles(sf::RenderWindow& window) const;
+    void drawTrapdoor(sf::RenderWindow& window) const;
     sf::Vector2f getDoorPosition(DoorDirection direction) const;
     float getDoorRotation(DoorDirection direction) const;
 
@@ -115,6 +176,8 @@ private:
     RoomType type;
     sf::FloatRect gameBounds;
     std::vector<Door> doors;
+    sf::Texture* doorSheet = nullptr;
+    bool doorSpritesReady = false;
 
     // LISTAS DE INIMIGOS
     std::vector<std::unique_ptr<Demon_ALL>> demons;
@@ -122,8 +185,33 @@ private:
     std::vector<std::unique_ptr<Chubby>> chubbies;
     std::vector<std::unique_ptr<Monstro>> monstros; // Adicionado
 
+    // Sorteado com o andar; consumido por spawnEnemies
+    std::vector<EnemySpawn> roster;
+    float healthMultiplier = 1.f;
+    bool enemiesSpawned = false;    // Mesmo que morram todos, o roster não volta a nascer
+    std::uint32_t seed;             // Também dá o RNG de cada inimigo do roster
+
+    // Scratch do update da IA (inimigos vivos pela ordem do update em série + um buffer por bloco)
+    std::vector<EnemyBase*> aiTargets;
+    std::vector<EnemyCommandBuffer> aiCommands;
+    std::vector<AuraEffect> pendingAuras;
+    std::vector<AnimationPlayhead*> animationTargets;
+    bool parallelAI = true;
+
+    // Rochas e buracos, gerados com a sala e fixos depois disso
+    ObstacleGrid obstacles;
+
+    // Direções para o jogador partilhadas por todos os perseguidores da sala
+    FlowField flowField;
+    bool useFlowField = false;
+
+    // Fotografia das posições dos inimigos (refeita a cada update): separação/chegada e auras
+    CrowdSteering crowd;
+    bool useSteering = false;
+
     bool cleared;
     bool doorsOpened;
+    bool trapdoorOpen = false;
     sf::IntRect cornerTextureRect;
 };
 
@@ -3,8 +3,13 @@
 
 #include "Rooms.hpp"
 #include "AssetManager.hpp"
+#include "JobSystem.hpp"
+#include "DungeonGenerator.hpp"
+#include "RunSave.hpp"
+#include "WorldSnapshot.hpp"
 #include <vector>
 #include <map>
+#include <memory>
 #include <set>
 #include <SFML/System/Vector2.hpp>
 
@@ -30,20 +35,51 @@ enum class TransitionState {
     FadingIn
 };
 
+// Um andar completo. O seguinte é gerado num worker enquanto se joga o atual e
+// trocado inteiro quando o jogador desce pelo alçapão.
+struct Floor {
+    int index = 0;
+    std::uint32_t seed = 0;
+    DungeonLayout layout;       // Planta com os rosters já sorteados (vai para o save)
+    std::map<int, Room> rooms;
+    std::map<sf::Vector2i, int, Vector2iComparator> coordToRoomID;
+};
+
 // Classe que gerencia o labirinto de salas
 class RoomManager {
 public:
     RoomManager(AssetManager& assetManager, const sf::FloatRect& gameBounds);
-
-    // Gera o labirinto
-    void generateDungeon(int numRooms);
+    // Sem janela nem AssetManager (GymEnv): texturas fixas, sem tier de fundo, sem
+    // cache de plantas e com o andar seguinte gerado na descida. Não usa os workers,
+    // por isso várias instâncias podem correr em threads diferentes.
+    RoomManager(const EnemyTextures& textures, sf::Texture& doorTexture, const sf::FloatRect& gameBounds);
+    ~RoomManager();
+
+    // Gera o labirinto (novo jogo: andar 0) e começa a preparar o andar seguinte
+    void generateDungeon();
+    // Run com seed dada: os andares seguintes derivam dela (como com fixed_seed)
+    void generateDungeon(std::uint32_t seed);
+
+    // Save da run: o andar atual inteiro (planta, salas, inimigos vivos, minimapa)
+    void captureState(RunSnapshot& snapshot);
+    // Reconstrói o andar do snapshot e repõe o estado das salas; a transição em curso é descartada
+    void restoreState(const RunSnapshot& snapshot);
+
+    // Fotografia em memória para "e se" (ver WorldSnapshot): as salas do andar são
+    // repostas no sítio. false se o andar mudou desde a captura.
+    void captureWorld(WorldSnapshot& snapshot);
+    bool restoreWorld(const WorldSnapshot& snapshot);
 
     // Transição entre salas
     void requestTransition(DoorDirection direction);
+    // Descida pelo alçapão (o mesmo fade, com a troca de andar a meio)
+    void requestFloorTransition();
     void updateTransition(float deltaTime, sf::Vector2f& playerPosition);
     bool isTransitioning() const { return transitionState != TransitionState::None; }
 
     // Update e Draw
+    // Tier ativo: a sala atual, todos os frames na thread principal.
+    // Tier de fundo: vizinhas por limpar, a 'background_hz' num worker (ver room_scheduler).
     void update(float deltaTime, sf::Vector2f playerPosition);
     void draw(sf::RenderWindow& window);
     void drawTransitionOverlay(sf::RenderWindow& window);
@@ -51,22 +87,44 @@ public:
     // Getters
     Room* getCurrentRoom() { return currentRoom; }
     int getCurrentRoomID() const { return currentRoomID; }
+    int getFloorIndex() const { return floorIndex; }
 
     // Verifica se player está numa porta
     DoorDirection checkPlayerAtDoor(const sf::FloatRect& playerBounds);
+    bool checkPlayerAtTrapdoor(const sf::FloatRect& playerBounds) const;
 
     // NOVO: Métodos para o minimapa
     void drawMiniMap(sf::RenderWindow& window);
     sf::Vector2i getCurrentRoomCoord() const;
 
 private:
-    AssetManager& assets;
+    AssetManager* assets;       // nullptr = headless
+    bool headless = false;
+    EnemyTextures fixedTextures;
+    sf::Texture* fixedDoorTexture = nullptr;
+    sf::Texture& doorTexture();
+
+    // Handles resolvidos uma vez no construtor: entrar numa sala não procura nomes
+    struct AssetHandles {
+        TextureHandle door, tears, chubby, monstro;
+        AnimationHandle demonDown, demonUp, demonLeft, demonRight, bishop;
+    } handles;
+
+    // Texturas de que a sala atual e as de fundo precisam; o resto pode ser despejado
+    std::vector<AssetLease> roomAssets;
+    void appendRoomAssets(RoomType type, std::vector<AssetLease>& leases);
+    void retainRoomAssets();
     sf::FloatRect gameBounds;
 
     std::map<int, Room> rooms;
     Room* currentRoom;
     int currentRoomID;
     int nextRoomID;
+    int floorIndex = 0;
+    std::uint32_t runSeed = 0;  // Seed do andar 0; com fixed_seed, os seguintes derivam dela
+    std::uint32_t currentFloorSeed = 0;
+    bool seededRun = false;     // generateDungeon(seed) ou fixed_seed
+    DungeonLayout layout;       // Do andar atual
 
     // NOVO: Usa o comparador personalizado Vector2iComparator
     std::map<sf::Vector2i, int, Vector2iComparator> coordToRoomID;
@@ -81,21 +139,57 @@ private:
     // Transição
     TransitionState transitionState;
     DoorDirection transitionDirection;
+    bool descending = false;   // A transição em curso é a do alçapão
     float transitionProgress;
     const float transitionDuration = 0.5f;  // 0.5 segundos
 
     sf::RectangleShape transitionOverlay;
 
-    // Geração do labirinto
-    void createRoom(int id, RoomType type);
-    void connectRooms(int roomA, int roomB, DoorDirection directionFromA);
-    DoorDirection getOppositeDirection(DoorDirection direction);
+    // Geração do labirinto (planta do DungeonGenerator). buildFloor só lê a config,
+    // gameBounds e a textura das portas (fixada em memória), por isso pode correr num worker.
+    void buildFloor(Floor& floor, int index, std::uint32_t seed, sf::Texture& doorTexture) const;
+    // Salas e portas de floor.layout; applyRosters dá a cada sala o seu roster da planta
+    void assembleFloor(Floor& floor, sf::Texture& doorTexture) const;
+    void applyRosters(Floor& floor) const;
+    void createRoom(Floor& floor, int id, const LayoutRoom& layoutRoom) const;
+    static void connectRooms(Floor& floor, int roomA, int roomB, DoorDirection directionFromA);
+    static DoorDirection getOppositeDirection(DoorDirection direction);
+
+    std::uint32_t floorSeed(int index);
+
+    // Troca para o andar gerado e entra na sala inicial
+    void enterFloor(Floor& floor);
+    void swapInFloor(Floor& floor);
+
+    // Andar seguinte, gerado num worker durante o andar atual
+    std::unique_ptr<Floor> nextFloor;
+    JobCounter nextFloorJob;
+    void prepareNextFloor();
+    void waitForNextFloor();
 
     // Helper
     sf::Vector2f getTransitionOffset(DoorDirection direction, float progress);
-
+    void spawnRoomEnemies(Room& room);
+    EnemyTextures enemyTextures();
+
+    // Tier de fundo
+    struct BackgroundSlot {
+        Room* room = nullptr;
+        sf::Vector2f target;      // Centro da sala: alvo neutro, longe do ponto onde o jogador entra
+        float pendingTime = 0.f;  // Tempo simulado ainda por aplicar
+    };
+    std::vector<BackgroundSlot> backgroundSlots;
+    std::size_t backgroundCursor = 0;   // Round-robin entre ticks (só o job mexe)
+    float backgroundAccumulator = 0.f;
+    JobCounter backgroundJob;
+
+    void scheduleBackgroundTier(float deltaTime);
+    void runBackgroundTick();
+    void rebuildBackgroundTier();
+    void waitForBackgroundTier();
+
+    std::random_device rd; // Seed para inicializar o motor (declarado antes do rng, que o usa)
     std::mt19937 rng; // Motor de geração
-    std::random_device rd; // Seed para inicializar o motor
 };
 
 #endif // ROOMMANAGER_HPP
@@ -0,0 +1,69 @@
+#ifndef RUNSAVE_HPP
+#define RUNSAVE_HPP
+
+#include "DungeonCache.hpp"
+#include "DungeonGenerator.hpp"
+#include "EntityState.hpp"
+#include "GameConfig.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Formato do save (little-endian, sem parsing: cada bloco e um array de registos POD):
+//   RunSaveHeader | planta (CachedRoom/CachedDoor/CachedSpawn) | RoomState[] | DoorSaveState[]
+//   | uint16 visitedRooms[] | EnemyState[] | ProjectileState[]
+constexpr char kRunSaveMagic[4] = { 'I', 'S', 'A', 'V' };
+constexpr std::uint32_t kRunSaveFormat = 1;
+
+// Tudo o que e preciso para continuar uma run a meio. Serve tambem para montar
+// cenarios de benchmark: capturar uma vez, repor quantas vezes for preciso.
+struct RunSnapshot {
+    std::uint32_t runSeed = 0;
+    std::uint32_t floorSeed = 0;
+    int floorIndex = 0;
+    int currentRoom = 0;
+    DungeonLayout layout;                       // Planta e rosters do andar atual
+    std::vector<RoomState> rooms;               // Indexado pelo id da sala
+    std::vector<DoorSaveState> doors;
+    std::vector<std::uint16_t> visitedRooms;
+    std::vector<EnemyState> enemies;
+    std::vector<ProjectileState> projectiles;   // Dos inimigos e as lagrimas do Isaac
+    PlayerState player;
+
+    // Mantem a capacidade dos vetores (capturar de novo nao aloca)
+    void clear();
+};
+
+struct RunSaveHeader {
+    char magic[4];
+    std::uint32_t format;
+    std::uint32_t generatorVersion;
+    std::uint32_t fingerprint;      // layoutFingerprint do andar: arquetipos e rosters tem de bater certo
+    std::uint32_t runSeed;
+    std::uint32_t floorSeed;
+    std::int32_t floorIndex;
+    std::int32_t currentRoom;
+    CachedLayoutCounts layout;
+    std::uint32_t roomCount;
+    std::uint32_t doorCount;
+    std::uint32_t visitedCount;
+    std::uint32_t enemyCount;
+    std::uint32_t projectileCount;
+    std::uint32_t reserved;
+    PlayerState player;
+};
+
+static_assert(sizeof(RunSaveHeader) == 120, "layout do save mudou");
+
+// Serializacao em memoria; o ficheiro e exatamente este buffer
+void writeRunSnapshot(const RunSnapshot& snapshot, const GameConfig& config, std::vector<char>& out);
+// Valida versao, config e todos os indices antes de tocar em 'snapshot'
+bool readRunSnapshot(const std::vector<char>& data, const GameConfig& config, RunSnapshot& snapshot);
+
+bool saveRunSnapshot(const std::string& path, const RunSnapshot& snapshot, const GameConfig& config);
+// false (sem mexer em 'snapshot') se nao houver save ou for de outra versao/config
+bool loadRunSnapshot(const std::string& path, const GameConfig& config, RunSnapshot& snapshot);
+// A run acabou (morte): o save deixa de valer
+void deleteRunSnapshot(const std::string& path);
+
+#endif // RUNSAVE_HPP
@@ -0,0 +1,74 @@
+#ifndef SIMULATION_HPP
+#define SIMULATION_HPP
+
+#include "player.hpp"
+#include "RoomsManager.hpp"
+#include "Collision.hpp"
+#include "RunSave.hpp"
+#include "WorldSnapshot.hpp"
+#include <optional>
+#include <vector>
+#include <cstdint>
+
+// Texturas com que o Isaac e criado
+struct PlayerTextures {
+    std::vector<sf::Texture>* walkDown = nullptr;
+    std::vector<sf::Texture>* walkUp = nullptr;
+    std::vector<sf::Texture>* walkLeft = nullptr;
+    std::vector<sf::Texture>* walkRight = nullptr;
+    sf::Texture* tears = nullptr;
+};
+
+// As regras do jogo sem nada de janela: o Isaac, o RoomManager, as colisoes e a
+// resolucao dos eventos de cada tick. O Game desenha por cima disto; o GymEnv corre
+// varias em paralelo, headless.
+class Simulation {
+public:
+    // Jogo normal: as salas pedem as texturas ao AssetManager
+    Simulation(AssetManager& assets, const PlayerTextures& player, const sf::FloatRect& gameBounds);
+    // Headless (ver o construtor do RoomManager): pode correr em qualquer thread
+    Simulation(const PlayerTextures& player, const EnemyTextures& enemies, sf::Texture& doorTexture, const sf::FloatRect& gameBounds);
+
+    // Run nova: Isaac acabado de criar e andar 0. Sem seed segue o fixed_seed da config.
+    void newRun();
+    void newRun(std::uint32_t seed);
+
+    // Um tick: a transicao em curso, ou o Isaac, as salas, as portas e as colisoes.
+    // No fim aplica sempre os pedidos de dano/cura e entrega o lote ao EventBus.
+    void update(float deltaTime);
+
+    Player_ALL& player() { return *isaac; }
+    const Player_ALL& player() const { return *isaac; }
+    RoomManager& rooms() { return roomManager; }
+    const sf::FloatRect& bounds() const { return gameBounds; }
+    bool isOver() const { return isaac->getHealth() <= 0; }
+
+    // Save da run e fotografias: o RoomManager guarda as salas, aqui junta-se o Isaac.
+    // Repor descarta os eventos ainda por resolver.
+    void captureRun(RunSnapshot& snapshot);
+    void restoreRun(const RunSnapshot& snapshot);
+    void captureWorld(WorldSnapshot& snapshot);
+    bool restoreWorld(const WorldSnapshot& snapshot);
+
+private:
+    void createPlayer();
+    // Corpo do update, sem a fase de eventos (pode sair cedo numa porta ou no alcapao)
+    void simulate(float deltaTime);
+    void resolveEvents();
+    // Apaga os projeteis marcados como 'expiring' (do Isaac e da sala atual)
+    void dropExpiredProjectiles();
+
+    PlayerTextures playerTextures;
+    sf::FloatRect gameBounds;
+    RoomManager roomManager;
+    std::optional<Player_ALL> isaac;
+
+    // Buffers reutilizados pelas colisoes em lote (evita alocar a cada frame)
+    RectBatch enemyHitboxes;
+    std::vector<EnemyBase*> enemyTargets;
+    RectBatch projectileHitboxes;
+    std::vector<std::uint8_t> hitMask;
+    std::vector<int> enemyPendingDamage;  // Dano ainda por resolver de cada alvo (por indice)
+};
+
+#endif // SIMULATION_HPP
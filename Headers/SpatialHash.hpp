@@ -0,0 +1,74 @@
+#ifndef SPATIALHASH_HPP
+#define SPATIALHASH_HPP
+
+#include "SFML/Graphics.hpp"
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// Indice espacial de pontos: cada ponto cai numa celula de 'cellSize' e as celulas
+// sao espalhadas numa tabela por hash. O build e um counting sort (O(n)) e uma
+// consulta so visita as celulas a volta do raio, por isso procurar vizinhos para
+// todos os pontos custa O(n) em vez de O(n^2).
+class SpatialHash {
+public:
+    void build(const std::vector<sf::Vector2f>& points, float cellSize);
+
+    // Chama fn(index) para cada ponto das celulas que tocam o quadrado de lado 2*radius
+    // em volta de 'center' (quem chama testa a distancia exata). Cada ponto aparece
+    // no maximo uma vez. Ordem deterministica: celulas por linha e, dentro de cada
+    // bucket, pelo indice do ponto; raios muito grandes passam por todos os pontos.
+    template <typename Fn>
+    void query(sf::Vector2f center, float radius, Fn&& fn) const;
+
+    std::size_t size() const { return count; }
+    float cellSize() const { return cell; }
+
+private:
+    static constexpr int kMaxQueryBuckets = 64;
+
+    std::size_t bucketOf(int cellX, int cellY) const {
+        std::uint32_t h = static_cast<std::uint32_t>(cellX) * 73856093u ^ static_cast<std::uint32_t>(cellY) * 19349663u;
+        return h & mask;
+    }
+    int cellCoord(float v) const { return static_cast<int>(std::floor(v * inverseCell)); }
+
+    float cell = 64.f;
+    float inverseCell = 1.f / 64.f;
+    std::size_t count = 0;
+    std::uint32_t mask = 0;
+
+    std::vector<std::uint32_t> bucketStart;  // Inicio de cada bucket em 'entries' (+1 no fim)
+    std::vector<std::uint32_t> entries;      // Indices dos pontos ordenados por bucket
+    std::vector<std::uint32_t> pointBucket;  // Scratch do build
+};
+
+template <typename Fn>
+void SpatialHash::query(sf::Vector2f center, float radius, Fn&& fn) const {
+    if (count == 0) return;
+    const int x0 = cellCoord(center.x - radius), x1 = cellCoord(center.x + radius);
+    const int y0 = cellCoord(center.y - radius), y1 = cellCoord(center.y + radius);
+
+    // Mais celulas do que o registo de buckets aguenta: percorre tudo pela ordem dos indices
+    if (static_cast<long long>(x1 - x0 + 1) * (y1 - y0 + 1) > kMaxQueryBuckets) {
+        for (std::size_t i = 0; i < count; ++i) fn(static_cast<std::uint32_t>(i));
+        return;
+    }
+
+    // Duas celulas podem cair no mesmo bucket: cada bucket so e lido uma vez
+    std::size_t visited[kMaxQueryBuckets];
+    int visitedCount = 0;
+    for (int cy = y0; cy <= y1; ++cy) {
+        for (int cx = x0; cx <= x1; ++cx) {
+            const std::size_t bucket = bucketOf(cx, cy);
+            bool seen = false;
+            for (int v = 0; v < visitedCount && !seen; ++v) seen = visited[v] == bucket;
+            if (seen) continue;
+            visited[visitedCount++] = bucket;
+
+            for (std::uint32_t e = bucketStart[bucket]; e < bucketStart[bucket + 1]; ++e) fn(entries[e]);
+        }
+    }
+}
+
+#endif // SPATIALHASH_HPP
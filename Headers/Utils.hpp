@@ -3,6 +3,7 @@
 
 #include "SFML/Graphics.hpp"
 #include <cmath>
+#include <cstdint>
 
 #ifndef M_PI
 // Define M_PI globalmente para todos que incluírem este header
@@ -12,6 +13,20 @@
 // DECLARAÇÕES GLOBAIS
 bool checkCollision(const sf::FloatRect& a, const sf::FloatRect& b);
 
+// Gerador xorshift32: cada dono guarda o seu estado (determinístico e sem partilha entre threads)
+inline std::uint32_t nextRandom(std::uint32_t& state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+// Inteiro em [0, maxExclusive) (0 se maxExclusive <= 0; o estado avança sempre)
+inline int randomBelow(std::uint32_t& state, int maxExclusive) {
+    std::uint32_t value = nextRandom(state);
+    return maxExclusive > 0 ? static_cast<int>(value % static_cast<std::uint32_t>(maxExclusive)) : 0;
+}
+
 // NOVO: Sobrecarga do operador == para sf::Vector2i
 inline bool operator==(const sf::Vector2i& left, const sf::Vector2i& right) {
     return left.x == right.x && left.y == right.y;
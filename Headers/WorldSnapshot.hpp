@@ -0,0 +1,53 @@
+#ifndef WORLDSNAPSHOT_HPP
+#define WORLDSNAPSHOT_HPP
+
+#include "EntityState.hpp"
+#include <cstdint>
+#include <vector>
+
+// Fotografia da simulacao em memoria, para avaliar varias sequencias de acoes a
+// partir do mesmo estado (capturar, experimentar, repor). Usa os mesmos registos
+// do save, mas guarda todos os inimigos (mortos incluidos) pela ordem das listas
+// de cada sala: o restore escreve por cima dos objetos que ja existem em vez de os
+// construir. O RNG de cada inimigo vai no EnemyState (rngState).
+//
+// So vale dentro do mesmo andar: depois de descer pelo alcapao as salas antigas ja
+// nao existem e o restore falha (ai e preciso o RunSnapshot).
+struct WorldSnapshot {
+    int floorIndex = 0;
+    std::uint32_t floorSeed = 0;
+    int currentRoom = 0;
+
+    // Transicao em curso (RoomManager)
+    std::uint8_t transitionState = 0;
+    std::uint8_t transitionDirection = 0;
+    std::uint8_t descending = 0;
+    std::uint8_t overlayAlpha = 0;
+    float transitionProgress = 0.f;
+    int nextRoom = 0;
+
+    // Tier de fundo: tempo acumulado e ainda por simular em cada sala vizinha
+    float backgroundAccumulator = 0.f;
+    std::uint32_t backgroundCursor = 0;
+    std::vector<float> backgroundPending;
+
+    std::vector<RoomState> rooms;               // Indexado pelo id da sala
+    std::vector<DoorSaveState> doors;
+    std::vector<std::uint16_t> visitedRooms;
+    std::vector<EnemyState> enemies;
+    std::vector<ProjectileState> projectiles;   // Dos inimigos e as lagrimas do Isaac
+    PlayerState player;
+
+    // Mantem a capacidade dos vetores: a partir da segunda captura nada e alocado
+    void clear() {
+        backgroundPending.clear();
+        rooms.clear();
+        doors.clear();
+        visitedRooms.clear();
+        enemies.clear();
+        projectiles.clear();
+        player = PlayerState();
+    }
+};
+
+#endif // WORLDSNAPSHOT_HPP
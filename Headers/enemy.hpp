@@ -5,13 +5,33 @@
 #include <vector>
 #include <optional>
 #include <cmath>
+#include <cstdint>
 #include "ConfigManager.hpp"
 #include "Utils.hpp"
+#include "Animation.hpp"
+#include "FlowField.hpp"
+#include "ObstacleGrid.hpp"
+#include "CrowdSteering.hpp"
+#include "Aura.hpp"
+#include "EntityState.hpp"
 
 struct EnemyProjectile {
     sf::Sprite sprite;
     sf::Vector2f direction;
     float distanceTraveled;
+    sf::Vector2f lastStep{}; // Deslocamento do último tick (colisão contínua)
+    sf::FloatRect hitbox{};  // Calculada uma vez por tick, depois do movimento
+    bool expiring = false;   // Acabou neste tick: ainda entra nas colisões, sai depois delas
+};
+
+class BulletPattern;
+
+// Efeitos do update que mexem noutros inimigos. O update pode correr em paralelo,
+// por isso ficam aqui e são aplicados depois, na thread principal, pela ordem dos inimigos.
+struct EnemyCommandBuffer {
+    std::vector<AuraEffect> auras;
+
+    void clear() { auras.clear(); }
 };
 
 // --- CLASSE BASE ---
@@ -23,26 +43,81 @@ public:
     virtual void takeDamage(int amount);
     virtual void heal(int amount); // Adicionado aqui como virtual
 
+    // Dificuldade do andar: multiplica a vida inicial (chamado logo a seguir ao spawn)
+    virtual void scaleHealth(float multiplier);
+    // Semente do RNG próprio (a sala deriva-a da sua seed no spawn: o mesmo roster
+    // joga sempre igual, o que um rollback do WorldSnapshot precisa)
+    void seedRandom(std::uint32_t seed) { rngState = seed ? seed : 1; }
+
     int getHealth() const { return health; }
 
+    // Bit AuraTargets deste tipo de inimigo (filtro das auras)
+    virtual std::uint8_t getAuraTargetBit() const = 0;
+
+    // Efeito de uma aura já filtrada (chamado na thread principal, depois da IA)
+    void applyAura(const AuraEffect& aura);
+
+    // Avança os estados temporários (haste/slow). A sala chama antes da IA.
+    void updateStatus(float deltaTime);
+
     virtual sf::FloatRect getGlobalBounds() const;
 
+    // Hitbox de gameplay (calculada uma vez por tick, depois do movimento)
+    const sf::FloatRect& getHitbox() const { return hitbox; }
+
     std::vector<EnemyProjectile>& getProjectiles();
 
+    // Playhead avançado em lote pela sala antes do update (advanceAnimations)
+    AnimationPlayhead& getAnimation() { return animation; }
+
+    // Flow field da sala (só leitura durante o update; nullptr = linha reta)
+    void setFlowField(const FlowField* field) { flowField = field; }
+
+    // Obstáculos da sala (só leitura durante o update; nullptr = sala vazia)
+    void setObstacles(const ObstacleGrid* grid) { obstacles = grid; }
+
+    // Fotografia da multidão da sala e o índice deste inimigo nela (nullptr = sem steering)
+    void setCrowd(const CrowdSteering* steering, int agentIndex) { crowd = steering; crowdIndex = agentIndex; }
+
     virtual void setPosition(const sf::Vector2f& pos) {
         if (sprite) sprite->setPosition(pos);
+        refreshHitbox();
     }
 
     virtual void update(float deltaTime, sf::Vector2f playerPosition, const sf::FloatRect& gameBounds) = 0;
     virtual void draw(sf::RenderWindow& window);
 
+    // Chamado logo a seguir ao update (na mesma thread) para registar pedidos pendentes
+    virtual void emitCommands(EnemyCommandBuffer& /*commands*/) {}
+
+    // Save da run. A base guarda o bloco comum e acrescenta os projéteis a 'projectiles';
+    // cada tipo guarda os seus timers nos slots do EnemyState. loadState é chamado
+    // logo a seguir ao construtor, ou por cima de um inimigo já em jogo (WorldSnapshot),
+    // com os projéteis do inimigo em [projectiles, +projectileCount).
+    virtual void saveState(EnemyState& state, std::vector<ProjectileState>& projectiles) const;
+    virtual void loadState(const EnemyState& state, const ProjectileState* projectiles);
+
 protected:
     EnemyBase();
 
     std::optional<sf::Sprite> sprite;
+    AnimationPlayhead animation;
+    const FlowField* flowField = nullptr;
+    const ObstacleGrid* obstacles = nullptr;
+    const CrowdSteering* crowd = nullptr;
+    int crowdIndex = -1;
     int health = 1;
     float speed = 0.f;
 
+    // Multiplicador das auras Haste/Slow (1 = normal) e o tempo que falta
+    float speedMultiplier = 1.f;
+    float speedStatusTimer = 0.f;
+
+    // Hitbox configurada por tipo de inimigo (não depende da escala do sprite)
+    HitboxConfig hitboxShape;
+    HitboxConfig projectileHitboxShape;
+    sf::FloatRect hitbox;
+
     sf::Texture* projectileTexture = nullptr;
     sf::IntRect projectileTextureRect;
 
@@ -51,20 +126,31 @@ protected:
 
     std::vector<EnemyProjectile> projectiles;
 
+    // Projétil já configurado (textura, rect, origem, escala) copiado por cada disparo
+    std::optional<EnemyProjectile> projectilePrototype;
+    void buildProjectilePrototype(const sf::Texture& texture, const sf::IntRect& rect, sf::Vector2f origin, float scale);
+
     // Flash de Dano (Vermelho)
-    sf::Clock hitClock;
-    sf::Time hitFlashDuration;
+    // Os timers avançam com o deltaTime (e não com sf::Clock) para o update
+    // dar o mesmo resultado em série ou em paralelo
+    float hitTimer = 0.f;
+    float hitFlashDuration = 0.f;
     bool isHit = false;
 
     // Flash de Cura (Verde)
-    sf::Clock healFlashClock;
-    const sf::Time healFlashDuration = sf::seconds(0.5f); // Reduzi para 0.5s para ser um feedback rápido
+    float healFlashTimer = 0.f;
+    const float healFlashDuration = 0.5f; // Reduzi para 0.5s para ser um feedback rápido
     bool isHealing = false; // Corrigido de isHealed para isHealing conforme o padrão
 
+    // Gerador aleatório próprio (o rand() global não é thread-safe nem determinístico em paralelo)
+    std::uint32_t rngState = 1;
+    int randomInt(int maxExclusive);
+
     // Funções de utilidade
-    void handleHealFlash();
+    void refreshHitbox();
+    void handleHealFlash(float deltaTime);
     void updateProjectiles(float deltaTime, const sf::FloatRect& gameBounds);
-    void handleHitFlash();
+    void handleHitFlash(float deltaTime);
 };
 
 // --- CLASSE DEMON ---
@@ -78,6 +164,7 @@ public:
         sf::Texture& projectileTextureRef);
 
     void update(float deltaTime, sf::Vector2f playerPosition, const sf::FloatRect& gameBounds) override;
+    std::uint8_t getAuraTargetBit() const override { return AuraTargets::Demon; }
 
     // override garante que o compilador verifique se a assinatura bate com a base
     void heal(int amount) override;
@@ -85,25 +172,27 @@ public:
     void setHealth(int newHealth);
     void setProjectileTextureRect(const sf::IntRect& rect);
 
+    void saveState(EnemyState& state, std::vector<ProjectileState>& projectiles) const override;
+    void loadState(const EnemyState& state, const ProjectileState* projectiles) override;
+
 private:
-    std::vector<sf::Texture>* textures_walk_down = nullptr;
-    std::vector<sf::Texture>* textures_walk_up = nullptr;
-    std::vector<sf::Texture>* textures_walk_left = nullptr;
-    std::vector<sf::Texture>* textures_walk_right = nullptr;
-    std::vector<sf::Texture>* last_animation_set = nullptr;
-    int current_frame = 0;
-    float animation_time = 0.0f;
-    float frame_duration = 0.f;
-
-    sf::Clock cooldownClock;
-    sf::Time cooldownTime;
-    sf::Clock attackDelayClock;
-    sf::Time attackDelayTime;
+    const AnimationClip* clipWalkDown = nullptr;
+    const AnimationClip* clipWalkUp = nullptr;
+    const AnimationClip* clipWalkLeft = nullptr;
+    const AnimationClip* clipWalkRight = nullptr;
+
+    float cooldownTimer = 0.f;
+    float cooldownTime = 0.f;
+    float attackDelayTimer = 0.f;
+    float attackDelayTime = 0.f;
     bool isPreparingAttack = false;
     sf::Vector2f targetPositionAtStartOfAttack;
 
+    const BulletPattern* attackPattern = nullptr;
+    int volleyCount = 0;
+
     void handleMovementAndAnimation(float deltaTime, sf::Vector2f playerPosition, bool isAttacking);
-    void handleAttack(sf::Vector2f playerPosition);
+    void handleAttack(float deltaTime, sf::Vector2f playerPosition);
 };
 
 // --- CLASSE BISHOP ---
@@ -111,23 +200,26 @@ class Bishop_ALL : public EnemyBase {
 public:
     Bishop_ALL(std::vector<sf::Texture>& walkTextures);
     void update(float deltaTime, sf::Vector2f playerPosition, const sf::FloatRect& gameBounds) override;
+    std::uint8_t getAuraTargetBit() const override { return AuraTargets::Bishop; }
 
     // Bishop geralmente não se autocura, mas precisa implementar a interface virtual
     void heal(int amount) override { /* Opcional: Bishop se curar também */ }
 
     bool shouldHealDemon() const;
-    void resetHealFlag();
+
+    void emitCommands(EnemyCommandBuffer& commands) override;
+
+    void saveState(EnemyState& state, std::vector<ProjectileState>& projectiles) const override;
+    void loadState(const EnemyState& state, const ProjectileState* projectiles) override;
 
 private:
-    std::vector<sf::Texture>* textures_idle = nullptr;
-    int current_frame = 0;
-    float animation_time = 0.0f;
-    float frame_duration = 0.f;
-    int FRAME_B7_INDEX = 0;
-
-    sf::Clock healClock;
-    sf::Time healCooldown;
+    // Clip do cântico; o evento do clip é o heal_trigger_frame
+    const AnimationClip* clipChant = nullptr;
+
+    float healTimer = 0.f;
+    float healCooldown = 0.f;
     bool canHealDemon = false;
+    AuraEffect healAura;        // Raio, quantidade e alvos do config; o centro muda a cada emissão
     bool isChanting = false;
 
     float center_pull_weight = 0.0f;
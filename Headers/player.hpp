@@ -7,11 +7,26 @@
 #include <iostream>
 #include "ConfigManager.hpp" 
 #include "Utils.hpp" 
+#include "Animation.hpp"
+#include "ObstacleGrid.hpp"
+#include "EntityState.hpp"
 
 struct Projectile {
     sf::Sprite sprite;
     sf::Vector2f direction;
     float distanceTraveled;
+    sf::Vector2f lastStep{}; // Deslocamento do ultimo tick (colisao continua)
+    sf::FloatRect hitbox{};  // Calculada uma vez por tick, depois do movimento
+    bool expiring = false;   // Acabou neste tick: ainda entra nas colisoes, sai depois delas
+};
+
+// Comandos de um tick. Por defeito vem do teclado; um agente (GymEnv) pode
+// substitui-los com setInput.
+enum class ShootDirection : std::uint8_t { None, Up, Down, Left, Right };
+
+struct PlayerInput {
+    sf::Vector2f move;                  // Cada eixo em [-1, 1] (normalizado se passar de 1)
+    ShootDirection shoot = ShootDirection::None;
 };
 
 class Player_ALL {
@@ -26,6 +41,10 @@ public:
     // --- NOVOS MTODOS PARA O ROOMMANAGER ---
     void setPosition(const sf::Vector2f& newPosition);
     void setSpeedMultiplier(float multiplier);
+    // Obstaculos da sala atual (nullptr = sala vazia)
+    void setObstacles(const ObstacleGrid* grid) { obstacles = grid; }
+    // Comandos fixos em vez do teclado (nullptr = teclado); lidos a cada update
+    void setInput(const PlayerInput* input) { scriptedInput = input; }
     // ----------------------------------------
 
     void setProjectileTextureRect(const sf::IntRect& rect);
@@ -38,6 +57,12 @@ public:
     int getHealth() const;
     std::vector<Projectile>& getProjectiles();
     sf::FloatRect getGlobalBounds() const;
+    // Hitbox de gameplay (calculada uma vez por tick, depois do movimento)
+    const sf::FloatRect& getHitbox() const { return hitbox; }
+
+    // Save da run: as lagrimas sao acrescentadas a 'projectiles'
+    void saveState(PlayerState& state, std::vector<ProjectileState>& projectiles) const;
+    void loadState(const PlayerState& state, const ProjectileState* projectiles);
 
     std::vector<sf::Texture>* textures_walk_up = nullptr;
     std::vector<sf::Texture>* textures_walk_left = nullptr;
@@ -47,6 +72,12 @@ private:
     std::optional<sf::Sprite> Isaac;
     float invulTimer = 0.f;
 
+    HitboxConfig hitboxShape;
+    HitboxConfig tearHitboxShape;
+    sf::FloatRect hitbox;
+    const ObstacleGrid* obstacles = nullptr;
+    const PlayerInput* scriptedInput = nullptr;
+
     // VARIVEIS CARREGADAS DA CONFIGURAO
     int health = 0;
     float speed = 0.f; // Velocidade base
@@ -71,20 +102,26 @@ private:
     sf::Texture* hitTexture = nullptr;
     sf::IntRect projectileTextureRect;
 
-    std::vector<sf::Texture>* last_animation_set = nullptr;
-    int current_frame = 0;
-    float animation_time = 0.0f;
+    // Clips partilhados (AnimationLibrary) e o playhead do Isaac
+    const AnimationClip* clipWalkDown = nullptr;
+    const AnimationClip* clipWalkUp = nullptr;
+    const AnimationClip* clipWalkLeft = nullptr;
+    const AnimationClip* clipWalkRight = nullptr;
+    AnimationPlayhead animation;
 
-    sf::Clock cooldownClock;
-    sf::Clock hitClock;
+    // Avancam com o deltaTime (e nao com sf::Clock) para poderem ser guardados no save
+    float cooldownTimer = 0.f;  // Desde a ultima lagrima
+    float hitTimer = 0.f;       // Desde o ultimo dano
     bool isHit = false;
 
     std::vector<Projectile> projectiles;
 
-    void handleMovementAndAnimation(float deltaTime);
-    void handleAttack();
+    static PlayerInput readKeyboard();
+    void handleMovementAndAnimation(float deltaTime, const PlayerInput& input);
+    void handleAttack(const PlayerInput& input);
     void updateProjectiles(float deltaTime, const sf::FloatRect& gameBounds);
     void handleHitFlash(float deltaTime);
+    void refreshHitbox();
 };
 
 #endif // PLAYER_HPP
\ No newline at end of file
@@ -0,0 +1,186 @@
+#include "Animation.hpp"
+#include "Logger.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+    // FNV-1a, o mesmo do assetHash (0 fica reservado para "sem clip")
+    std::uint32_t clipId(const std::string& name) {
+        std::uint32_t hash = 2166136261u;
+        for (unsigned char c : name) {
+            hash ^= c;
+            hash *= 16777619u;
+        }
+        return hash ? hash : 1u;
+    }
+
+    bool sameSettings(const AnimationClip& clip, float frameDuration, bool loop, int eventFrame) {
+        return clip.frameDuration == frameDuration && clip.loop == loop && clip.eventFrame == eventFrame;
+    }
+
+    // Um nome so pode ter uma origem: pedir o mesmo clip com outras texturas ou
+    // frames deixaria o chamador com ponteiros para as texturas de outro
+    [[noreturn]] void clipConflict(const std::string& name) {
+        throw std::runtime_error("Clip '" + name + "' ja registado com outra origem");
+    }
+}
+
+// --- AnimationClip ---
+
+void AnimationClip::apply(sf::Sprite& sprite, int index) const {
+    if (frames.empty()) return;
+    const AnimationFrame& f = frame(index);
+    if (f.texture) sprite.setTexture(*f.texture);
+    if (f.rect.size.x > 0 && f.rect.size.y > 0) sprite.setTextureRect(f.rect);
+}
+
+// --- AnimationPlayhead ---
+
+void AnimationPlayhead::play(const AnimationClip* newClip, bool restart) {
+    if (newClip == clip && !restart) {
+        playing = !finished;
+        return;
+    }
+    clip = newClip;
+    time = 0.f;
+    frame = 0;
+    playing = clip != nullptr;
+    finished = false;
+}
+
+void AnimationPlayhead::stop() {
+    time = 0.f;
+    frame = 0;
+    playing = false;
+    finished = false;
+}
+
+void AnimationPlayhead::apply(sf::Sprite& sprite) const {
+    if (clip) clip->apply(sprite, frame);
+}
+
+void AnimationPlayhead::save(AnimationState& state) const {
+    state.clipId = clip ? clip->id : 0;
+    state.time = time;
+    state.frame = frame;
+    state.playing = playing ? 1 : 0;
+    state.finished = finished ? 1 : 0;
+}
+
+void AnimationPlayhead::load(const AnimationState& state) {
+    clip = state.clipId ? AnimationLibrary::getInstance().find(state.clipId) : nullptr;
+    time = state.time;
+    frame = clip && clip->frameCount() > 0 ? state.frame % clip->frameCount() : 0;
+    playing = clip && state.playing;
+    finished = state.finished != 0;
+    frameChanged = false;
+    eventFired = false;
+}
+
+// --- Avanco em lote ---
+
+void advanceAnimation(AnimationPlayhead& p, float deltaTime) {
+    p.frameChanged = false;
+    p.eventFired = false;
+    if (!p.clip || !p.playing || p.clip->frames.empty() || p.clip->frameDuration <= 0.f) return;
+
+    const AnimationClip& clip = *p.clip;
+    p.time += deltaTime;
+    while (p.time >= clip.frameDuration) {
+        p.time -= clip.frameDuration;
+        int next = p.frame + 1;
+        if (next >= clip.frameCount()) {
+            if (!clip.loop) {
+                p.finished = true;
+                p.playing = false;
+                p.time = 0.f;
+                return;
+            }
+            next = 0;
+        }
+        p.frame = next;
+        p.frameChanged = true;
+        if (p.frame == clip.eventFrame) p.eventFired = true;
+    }
+}
+
+void advanceAnimations(const std::vector<AnimationPlayhead*>& playheads, float deltaTime) {
+    for (AnimationPlayhead* p : playheads) advanceAnimation(*p, deltaTime);
+}
+
+// --- AnimationLibrary ---
+
+AnimationLibrary& AnimationLibrary::getInstance() {
+    static AnimationLibrary instance;
+    return instance;
+}
+
+const AnimationClip* AnimationLibrary::fromTextures(const std::string& name, const std::vector<sf::Texture>& textures,
+    int frames, float frameDuration, bool loop, int eventFrame) {
+    const int count = std::min(frames, static_cast<int>(textures.size()));
+    auto it = clips.find(name);
+    if (it != clips.end()) {
+        const AnimationClip& stored = it->second;
+        bool same = stored.frameCount() == count && sameSettings(stored, frameDuration, loop, eventFrame);
+        for (int i = 0; same && i < count; ++i) same = stored.frames[i].texture == &textures[i];
+        if (!same) clipConflict(name);
+        return &stored;
+    }
+
+    AnimationClip clip;
+    clip.name = name;
+    clip.frameDuration = frameDuration;
+    clip.loop = loop;
+    clip.eventFrame = eventFrame;
+    for (int i = 0; i < count; ++i) clip.frames.push_back({ &textures[i], {} });
+    if (clip.frames.empty()) LOG_ERROR(LogCategory::Assets, "clip '", name, "' sem frames");
+
+    return add(std::move(clip));
+}
+
+const AnimationClip* AnimationLibrary::fromArchetype(const EnemyArchetype& archetype, int clipIndex) {
+    if (clipIndex < 0 || clipIndex >= archetype.clip_count) return nullptr;
+    const ArchetypeClip& source = archetype.clips[clipIndex];
+    const std::string name = std::string(archetype.name) + "/" + source.name;
+
+    auto it = clips.find(name);
+    if (it != clips.end()) {
+        const AnimationClip& stored = it->second;
+        bool same = stored.frameCount() == source.frame_count && sameSettings(stored, source.frame_duration, true, -1);
+        for (int i = 0; same && i < source.frame_count; ++i) {
+            const ArchetypeRect& r = source.frames[i];
+            same = stored.frames[i].texture == nullptr && stored.frames[i].rect == sf::IntRect({ r.x, r.y }, { r.width, r.height });
+        }
+        if (!same) clipConflict(name);
+        return &stored;
+    }
+
+    AnimationClip clip;
+    clip.name = name;
+    clip.frameDuration = source.frame_duration;
+    for (int i = 0; i < source.frame_count; ++i) {
+        const ArchetypeRect& r = source.frames[i];
+        clip.frames.push_back({ nullptr, sf::IntRect({ r.x, r.y }, { r.width, r.height }) });
+    }
+
+    return add(std::move(clip));
+}
+
+const AnimationClip* AnimationLibrary::find(const std::string& name) const {
+    auto it = clips.find(name);
+    return it != clips.end() ? &it->second : nullptr;
+}
+
+const AnimationClip* AnimationLibrary::find(std::uint32_t id) const {
+    auto it = clipsById.find(id);
+    return it != clipsById.end() ? it->second : nullptr;
+}
+
+const AnimationClip* AnimationLibrary::add(AnimationClip&& clip) {
+    clip.id = clipId(clip.name);
+    const std::string name = clip.name;
+    const AnimationClip* stored = &clips.emplace(name, std::move(clip)).first->second;
+    auto [it, inserted] = clipsById.emplace(stored->id, stored);
+    if (!inserted) LOG_ERROR(LogCategory::Assets, "clips '", it->second->name, "' e '", stored->name, "' com o mesmo id");
+    return stored;
+}
@@ -1,60 +1,388 @@
 // Source/AssetManager.cpp
 
 #include "AssetManager.hpp"
+#include "JobSystem.hpp"
+#include "Logger.hpp"
+#include <chrono>
 #include <utility>
 
-// Inicializao da varivel static fora da classe
-std::map<std::string, std::vector<sf::Texture>> AssetManager::animationSets;
+namespace {
+    using LoadClock = std::chrono::steady_clock;
 
+    double elapsedMs(LoadClock::time_point start) {
+        return std::chrono::duration<double, std::milli>(LoadClock::now() - start).count();
+    }
+
+    std::uint64_t textureBytes(const sf::Texture& texture) {
+        const sf::Vector2u size = texture.getSize();
+        return static_cast<std::uint64_t>(size.x) * size.y * 4;
+    }
+}
+
+// Poucas dezenas de entradas: uma procura linear nos hashes chega (e s corre ao resolver)
+std::uint32_t AssetManager::indexOf(const std::vector<std::uint32_t>& hashes, std::uint32_t hash) {
+    for (std::size_t i = 0; i < hashes.size(); ++i) {
+        if (hashes[i] == hash) return static_cast<std::uint32_t>(i);
+    }
+    return kInvalidAsset;
+}
+
+// Dois nomes diferentes com o mesmo hash: erro de registo, tem de ser corrigido j
+void AssetManager::checkCollision(const std::vector<std::string>& names, std::uint32_t index, AssetId id) {
+    if (names[index] == id.name) return;
+    LOG_ERROR(LogCategory::Assets, "Colisao de hash entre '", names[index], "' e '", id.name, "'");
+    throw std::runtime_error("Colisao de hash de asset: " + std::string(id.name));
+}
+
+bool AssetManager::mountPack(const std::string& path) {
+    if (!pack.open(path)) {
+        LOG_WARN(LogCategory::Assets, "pack '", path, "' indisponivel, a usar ficheiros soltos");
+        return false;
+    }
+    LOG_INFO(LogCategory::Assets, "pack '", path, "' montado: ", pack.size(), " imagens");
+    return true;
+}
 
-bool AssetManager::loadTexture(const std::string& name, const std::string& filename) {
+bool AssetManager::loadTextureFile(const std::string& filename, sf::Texture& texture) {
+    if (const PackEntry* entry = pack.find(filename)) {
+        if (pack.loadTexture(*entry, texture, decodeBuffer)) {
+            ++packLoads;
+            return true;
+        }
+        LOG_WARN(LogCategory::Assets, "entrada do pack corrompida, a ler do disco: ", filename);
+    }
+    if (!texture.loadFromFile(filename)) return false;
+    ++fileLoads;
+    return true;
+}
+
+TextureHandle AssetManager::loadTexture(AssetId id, const std::string& filename) {
     sf::Texture texture;
-    if (!texture.loadFromFile(filename)) {
-        std::cerr << "ERRO: Falha ao carregar textura: " << filename << std::endl;
+    if (!loadTextureFile(filename, texture)) {
+        LOG_ERROR(LogCategory::Assets, "Falha ao carregar textura: ", filename);
         // Lanar exceo para debug imediato.
         throw std::runtime_error("Asset Not Found: " + filename);
     }
-    textures[name] = std::move(texture);
-    return true;
+
+    const std::uint64_t bytes = textureBytes(texture);
+    TextureHandle handle{ indexOf(textureHashes, id.hash) };
+    if (handle) {
+        checkCollision(textureNames, handle.index, id);
+        // Recarregar: o contedo passa para o objeto que j existe (os sprites apontam para ele)
+        textures[handle.index] = std::move(texture);
+    }
+    else {
+        handle.index = static_cast<std::uint32_t>(textures.size());
+        textures.push_back(std::move(texture));
+        textureHashes.push_back(id.hash);
+        textureNames.emplace_back(id.name);
+    }
+    track(textureResidency, handle.index, { filename }, bytes);
+    return handle;
 }
 
-void AssetManager::loadAnimation(
-    const std::string& setPrefix,
+AnimationHandle AssetManager::loadAnimation(
+    AssetId id,
     const std::string& folderName,
     const std::string& prefix,
     int totalFrames,
     const std::string& suffix)
 {
-    std::string base_path = "Images/";
-    std::vector<sf::Texture> newSet;
-    newSet.resize(totalFrames);
+    return loadAnimations({ { id, folderName, prefix, totalFrames, suffix } }).front();
+}
 
-    for (int i = 0; i < totalFrames; ++i) {
-        std::string filename = base_path + folderName + "/" + prefix + std::to_string(i + 1) + suffix;
+// Cada frame  independente: o PNG (ou a entrada do pack)  lido e descodificado
+// num worker; nada aqui toca em contexto OpenGL nem no estado do AssetManager
+void AssetManager::decodeFrames(const std::vector<std::string>& files, std::vector<DecodedFrame>& decoded) {
+    decoded.clear();
+    decoded.resize(files.size());
+    std::vector<unsigned char> fromPack(files.size(), 0);
 
-        if (!newSet[i].loadFromFile(filename)) {
-            std::cerr << "ERRO FATAL DE ASSET: Falha ao carregar frame: " << filename << std::endl;
-            // LANAR EXCEO PARA PARAR O PROGRAMA IMEDIATAMENTE NO DEBUG
-            throw std::runtime_error("Asset Not Found: " + filename);
+    JobSystem::getInstance().parallelFor(files.size(), 1, [&](std::size_t begin, std::size_t end, std::size_t) {
+        for (std::size_t i = begin; i < end; ++i) {
+            DecodedFrame& frame = decoded[i];
+            const auto start = LoadClock::now();
+            if (const PackEntry* entry = pack.find(files[i])) {
+                if (pack.decode(*entry, frame.rgba)) {
+                    frame.pixels = frame.rgba.data();
+                    frame.size = { entry->width, entry->height };
+                    frame.ok = true;
+                    fromPack[i] = 1;
+                }
+                else LOG_WARN(LogCategory::Assets, "entrada do pack corrompida, a ler do disco: ", files[i]);
+            }
+            if (!frame.ok && frame.image.loadFromFile(files[i])) {
+                frame.pixels = frame.image.getPixelsPtr();
+                frame.size = frame.image.getSize();
+                frame.ok = true;
+            }
+            frame.decodeMs = elapsedMs(start);
         }
+        });
+
+    // Os contadores no so atmicos: somam-se aqui, j fora dos workers
+    for (std::size_t i = 0; i < files.size(); ++i) {
+        if (!decoded[i].ok) continue;
+        if (fromPack[i]) ++packLoads;
+        else ++fileLoads;
+    }
+}
+
+void AssetManager::uploadFrame(const std::string& filename, DecodedFrame& frame, sf::Texture& texture) {
+    if (!frame.ok || !texture.resize(frame.size)) {
+        LOG_ERROR(LogCategory::Assets, "Falha ao carregar frame: ", filename);
+        // LANAR EXCEO PARA PARAR O PROGRAMA IMEDIATAMENTE NO DEBUG
+        throw std::runtime_error("Asset Not Found: " + filename);
     }
+    texture.update(frame.pixels);
 
-    // Move o vetor de texturas carregado para o mapa esttico
-    animationSets[setPrefix] = std::move(newSet);
+    // Liberta j a memria do frame (o lote inteiro pode ter dezenas de MB)
+    frame.image = sf::Image();
+    frame.rgba = std::vector<std::uint8_t>();
+    frame.pixels = nullptr;
+}
+
+AnimationHandle AssetManager::storeAnimation(AssetId id, std::vector<sf::Texture>&& frames, std::vector<std::string>&& sources, std::uint64_t bytes) {
+    // Move o vetor de texturas carregado para o array denso
+    AnimationHandle handle{ indexOf(animationHashes, id.hash) };
+    if (handle) {
+        checkCollision(animationNames, handle.index, id);
+        // Recarregar: os frames que j existem recebem o contedo um a um, como no
+        // reloadAnimation. Trocar o vetor destrua as texturas para onde os clips e
+        // os sprites apontam, por isso o nmero de frames tem de ser o mesmo.
+        std::vector<sf::Texture>& existing = animationSets[handle.index];
+        if (existing.size() != frames.size()) {
+            LOG_ERROR(LogCategory::Assets, "Set de Animacao '", id.name, "' ja registado com ", existing.size(), " frames");
+            throw std::runtime_error("Set de Animacao ja registado com outro numero de frames: " + std::string(id.name));
+        }
+        for (std::size_t i = 0; i < frames.size(); ++i) existing[i] = std::move(frames[i]);
+    }
+    else {
+        handle.index = static_cast<std::uint32_t>(animationSets.size());
+        animationSets.push_back(std::move(frames));
+        animationHashes.push_back(id.hash);
+        animationNames.emplace_back(id.name);
+    }
+    track(animationResidency, handle.index, std::move(sources), bytes);
+    return handle;
 }
 
-sf::Texture& AssetManager::getTexture(const std::string& name) {
-    if (textures.find(name) == textures.end()) {
-        std::cerr << "ERRO: Textura nao encontrada: " << name << std::endl;
-        throw std::runtime_error("Textura nao encontrada: " + name);
+std::vector<AnimationHandle> AssetManager::loadAnimations(const std::vector<AnimationRequest>& requests) {
+    const std::string base_path = "Images/";
+
+    // Todos os frames de todos os sets numa s lista, para o parallelFor os repartir
+    std::vector<std::string> files;
+    std::vector<std::size_t> firstFrame;
+    firstFrame.reserve(requests.size() + 1);
+    for (const AnimationRequest& request : requests) {
+        firstFrame.push_back(files.size());
+        for (int i = 0; i < request.totalFrames; ++i) {
+            files.push_back(base_path + request.folderName + "/" + request.prefix + std::to_string(i + 1) + request.suffix);
+        }
     }
-    return textures.at(name);
+    firstFrame.push_back(files.size());
+
+    const auto start = LoadClock::now();
+    std::vector<DecodedFrame> decoded;
+    decodeFrames(files, decoded);
+    const double decodeWallMs = elapsedMs(start);
+
+    // Upload pela ordem dos pedidos; o primeiro frame em falta interrompe o lote
+    std::vector<AnimationHandle> handles;
+    handles.reserve(requests.size());
+    double decodeCpuMs = 0.0;
+    for (std::size_t r = 0; r < requests.size(); ++r) {
+        std::vector<sf::Texture> newSet(firstFrame[r + 1] - firstFrame[r]);
+        std::vector<std::string> sources;
+        sources.reserve(newSet.size());
+        std::uint64_t bytes = 0;
+        double setMs = 0.0;
+
+        for (std::size_t i = 0; i < newSet.size(); ++i) {
+            const std::size_t frame = firstFrame[r] + i;
+            setMs += decoded[frame].decodeMs;
+            uploadFrame(files[frame], decoded[frame], newSet[i]);
+            bytes += textureBytes(newSet[i]);
+            sources.push_back(std::move(files[frame]));
+        }
+
+        decodeCpuMs += setMs;
+        LOG_INFO(LogCategory::Assets, requests[r].id.name, ": ", newSet.size(), " frames, descodificacao ", setMs, " ms");
+        handles.push_back(storeAnimation(requests[r].id, std::move(newSet), std::move(sources), bytes));
+    }
+
+    if (requests.size() > 1) {
+        LOG_INFO(LogCategory::Assets, requests.size(), " animacoes (", decoded.size(), " frames) descodificadas em ",
+            decodeWallMs, " ms (", decodeCpuMs, " ms de CPU em ", JobSystem::getInstance().workerCount() + 1, " threads)");
+    }
+    return handles;
 }
 
-std::vector<sf::Texture>& AssetManager::getAnimationSet(const std::string& setPrefix) {
-    if (animationSets.find(setPrefix) == animationSets.end()) {
-        std::cerr << "ERRO: Set de Animacao nao encontrado: " << setPrefix << std::endl;
-        throw std::runtime_error("Set de Animacao nao encontrado: " + setPrefix);
+TextureHandle AssetManager::findTexture(AssetId id) const {
+    TextureHandle handle{ indexOf(textureHashes, id.hash) };
+    if (!handle || textureNames[handle.index] != id.name) {
+        LOG_ERROR(LogCategory::Assets, "Textura nao encontrada: ", id.name);
+        throw std::runtime_error("Textura nao encontrada: " + std::string(id.name));
     }
-    return animationSets.at(setPrefix);
-}
\ No newline at end of file
+    return handle;
+}
+
+AnimationHandle AssetManager::findAnimation(AssetId id) const {
+    AnimationHandle handle{ indexOf(animationHashes, id.hash) };
+    if (!handle || animationNames[handle.index] != id.name) {
+        LOG_ERROR(LogCategory::Assets, "Set de Animacao nao encontrado: ", id.name);
+        throw std::runtime_error("Set de Animacao nao encontrado: " + std::string(id.name));
+    }
+    return handle;
+}
+
+// --- Residncia ---
+
+void AssetManager::track(std::vector<AssetResidency>& residency, std::uint32_t index, std::vector<std::string> sources, std::uint64_t bytes) {
+    if (residency.size() <= index) residency.resize(index + 1);
+    AssetResidency& state = residency[index];
+    if (state.resident) residentBytes -= state.bytes;
+    state.sources = std::move(sources);
+    state.bytes = bytes;
+    state.resident = true;
+    state.lastUse = ++useClock;
+    residentBytes += bytes;
+}
+
+void AssetManager::reloadTexture(std::uint32_t index) {
+    AssetResidency& state = textureResidency[index];
+    if (!loadTextureFile(state.sources.front(), textures[index])) {
+        LOG_ERROR(LogCategory::Assets, "Falha ao recarregar textura: ", state.sources.front());
+        throw std::runtime_error("Asset Not Found: " + state.sources.front());
+    }
+    state.resident = true;
+    residentBytes += state.bytes;
+    LOG_DEBUG(LogCategory::Assets, "recarregada: ", textureNames[index]);
+}
+
+void AssetManager::reloadAnimation(std::uint32_t index) {
+    AssetResidency& state = animationResidency[index];
+    std::vector<sf::Texture>& frames = animationSets[index];
+    std::vector<DecodedFrame> decoded;
+    decodeFrames(state.sources, decoded);
+    for (std::size_t i = 0; i < frames.size(); ++i) {
+        uploadFrame(state.sources[i], decoded[i], frames[i]);
+    }
+    state.resident = true;
+    residentBytes += state.bytes;
+    LOG_DEBUG(LogCategory::Assets, "recarregada: ", animationNames[index]);
+}
+
+void AssetManager::evict(bool animation, std::uint32_t index) {
+    AssetResidency& state = animation ? animationResidency[index] : textureResidency[index];
+    // Os objetos ficam no mesmo stio (vazios): quem os aponta continua vlido
+    if (animation) {
+        for (sf::Texture& frame : animationSets[index]) frame = sf::Texture();
+    }
+    else textures[index] = sf::Texture();
+    state.resident = false;
+    residentBytes -= state.bytes;
+    LOG_DEBUG(LogCategory::Assets, "despejada: ", animation ? animationNames[index] : textureNames[index]);
+}
+
+void AssetManager::retain(TextureHandle handle) {
+    ++textureResidency[handle.index].refs;
+    get(handle);
+}
+
+void AssetManager::retain(AnimationHandle handle) {
+    ++animationResidency[handle.index].refs;
+    get(handle);
+}
+
+void AssetManager::release(TextureHandle handle) {
+    AssetResidency& state = textureResidency[handle.index];
+    if (state.refs > 0) --state.refs;
+    state.lastUse = ++useClock;
+}
+
+void AssetManager::release(AnimationHandle handle) {
+    AssetResidency& state = animationResidency[handle.index];
+    if (state.refs > 0) --state.refs;
+    state.lastUse = ++useClock;
+}
+
+void AssetManager::trim() {
+    if (budgetBytes == 0) return;
+    while (residentBytes > budgetBytes) {
+        // O menos usado recentemente entre os que ningum est a usar
+        bool foundAnimation = false;
+        std::uint32_t found = kInvalidAsset;
+        std::uint64_t oldest = ~0ull;
+        auto consider = [&](const std::vector<AssetResidency>& residency, bool animation) {
+            for (std::uint32_t i = 0; i < residency.size(); ++i) {
+                const AssetResidency& state = residency[i];
+                if (!state.resident || state.refs > 0 || state.lastUse >= oldest) continue;
+                oldest = state.lastUse;
+                found = i;
+                foundAnimation = animation;
+            }
+            };
+        consider(textureResidency, false);
+        consider(animationResidency, true);
+
+        if (found == kInvalidAsset) {
+            if (!budgetWarned) {
+                LOG_WARN(LogCategory::Assets, "orcamento de texturas excedido por assets em uso: ",
+                    residentBytes / 1024, " KB de ", budgetBytes / 1024, " KB");
+                budgetWarned = true;
+            }
+            return;
+        }
+        evict(foundAnimation, found);
+    }
+}
+
+void AssetManager::logResidencyReport() const {
+    auto report = [](const std::vector<AssetResidency>& residency, const std::vector<std::string>& names, const char* kind) {
+        for (std::size_t i = 0; i < residency.size(); ++i) {
+            const AssetResidency& state = residency[i];
+            LOG_INFO(LogCategory::Assets, "  ", kind, " ", names[i], ": ", state.bytes / 1024, " KB, refs ", state.refs,
+                state.resident ? ", residente" : ", despejada");
+        }
+        };
+    if (budgetBytes) LOG_INFO(LogCategory::Assets, "Residencia: ", residentBytes / 1024, " KB de ", budgetBytes / 1024, " KB");
+    else LOG_INFO(LogCategory::Assets, "Residencia: ", residentBytes / 1024, " KB (sem orcamento)");
+    report(textureResidency, textureNames, "textura");
+    report(animationResidency, animationNames, "animacao");
+}
+
+// --- AssetLease ---
+
+AssetLease::AssetLease(AssetManager& manager, TextureHandle handle)
+    : owner(&manager), index(handle.index), animation(false) {
+    manager.retain(handle);
+}
+
+AssetLease::AssetLease(AssetManager& manager, AnimationHandle handle)
+    : owner(&manager), index(handle.index), animation(true) {
+    manager.retain(handle);
+}
+
+AssetLease::AssetLease(AssetLease&& other) noexcept
+    : owner(other.owner), index(other.index), animation(other.animation) {
+    other.owner = nullptr;
+}
+
+AssetLease& AssetLease::operator=(AssetLease&& other) noexcept {
+    if (this != &other) {
+        reset();
+        owner = other.owner;
+        index = other.index;
+        animation = other.animation;
+        other.owner = nullptr;
+    }
+    return *this;
+}
+
+void AssetLease::reset() {
+    if (!owner) return;
+    if (animation) owner->release(AnimationHandle{ index });
+    else owner->release(TextureHandle{ index });
+    owner = nullptr;
+}
@@ -0,0 +1,169 @@
+#include "AssetPack.hpp"
+#include "AssetManager.hpp"
+#include "Logger.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+    constexpr std::size_t kPixelSize = 4;
+    constexpr std::size_t kMaxBlock = 128;
+
+    // O tamanho guardado tem de poder dar width x height pixeis: cru tem de bater
+    // certo, e no RLE cada cabecalho cobre no maximo 128 pixeis. Evita alocar o que
+    // uma entrada estragada disser antes de olhar para os dados.
+    bool entrySizeMatches(const PackEntry& entry) {
+        const std::uint64_t pixelCount = static_cast<std::uint64_t>(entry.width) * entry.height;
+        switch (entry.codec) {
+        case PackCodec::Raw:
+            return entry.dataSize % kPixelSize == 0 && entry.dataSize / kPixelSize == pixelCount;
+        case PackCodec::PixelRle:
+            return (pixelCount + kMaxBlock - 1) / kMaxBlock <= entry.dataSize;
+        }
+        return false;
+    }
+
+    inline bool samePixel(const std::uint8_t* rgba, std::size_t a, std::size_t b) {
+        return std::memcmp(rgba + a * kPixelSize, rgba + b * kPixelSize, kPixelSize) == 0;
+    }
+}
+
+void encodePixelRle(const std::uint8_t* rgba, std::size_t pixelCount, std::vector<std::uint8_t>& out) {
+    std::size_t i = 0;
+    while (i < pixelCount) {
+        std::size_t run = 1;
+        while (i + run < pixelCount && run < kMaxBlock && samePixel(rgba, i, i + run)) ++run;
+        if (run >= 2) {
+            out.push_back(static_cast<std::uint8_t>(0x80 | (run - 1)));
+            out.insert(out.end(), rgba + i * kPixelSize, rgba + (i + 1) * kPixelSize);
+            i += run;
+            continue;
+        }
+
+        // Literais ate aparecer uma repeticao (ou encher o bloco)
+        const std::size_t start = i;
+        std::size_t literal = 0;
+        while (i < pixelCount && literal < kMaxBlock) {
+            if (i + 1 < pixelCount && samePixel(rgba, i, i + 1)) break;
+            ++i;
+            ++literal;
+        }
+        out.push_back(static_cast<std::uint8_t>(literal - 1));
+        out.insert(out.end(), rgba + start * kPixelSize, rgba + (start + literal) * kPixelSize);
+    }
+}
+
+bool decodePixelRle(const std::uint8_t* data, std::size_t size, std::uint8_t* rgba, std::size_t pixelCount) {
+    const std::uint8_t* src = data;
+    const std::uint8_t* srcEnd = data + size;
+    std::uint8_t* dst = rgba;
+    std::uint8_t* dstEnd = rgba + pixelCount * kPixelSize;
+
+    while (src < srcEnd) {
+        const std::uint8_t header = *src++;
+        const std::size_t pixels = (header & 0x7Fu) + 1;
+        const std::size_t bytes = pixels * kPixelSize;
+        if (static_cast<std::size_t>(dstEnd - dst) < bytes) return false;
+
+        if (header & 0x80u) {
+            if (static_cast<std::size_t>(srcEnd - src) < kPixelSize) return false;
+            for (std::size_t p = 0; p < pixels; ++p, dst += kPixelSize) std::memcpy(dst, src, kPixelSize);
+            src += kPixelSize;
+        }
+        else {
+            if (static_cast<std::size_t>(srcEnd - src) < bytes) return false;
+            std::memcpy(dst, src, bytes);
+            src += bytes;
+            dst += bytes;
+        }
+    }
+    return dst == dstEnd;
+}
+
+bool AssetPack::open(const std::string& path) {
+    close();
+    if (!file.open(path)) return false;
+
+    auto fail = [&](const char* reason) {
+        LOG_ERROR(LogCategory::Assets, "pack '", path, "' invalido: ", reason);
+        file.close();
+        return false;
+        };
+
+    if (file.size() < sizeof(PackHeader)) return fail("demasiado pequeno");
+    PackHeader header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, kAssetPackMagic, sizeof(header.magic)) != 0) return fail("assinatura errada");
+    if (header.version != kAssetPackVersion) return fail("versao diferente (refazer com --pack)");
+
+    const std::uint64_t indexBytes = static_cast<std::uint64_t>(header.entryCount) * sizeof(PackEntry);
+    if (header.indexOffset % alignof(PackEntry) != 0 || header.indexOffset > file.size() ||
+        indexBytes > file.size() - header.indexOffset) return fail("indice fora do ficheiro");
+    if (header.namesOffset > header.indexOffset) return fail("nomes fora do sitio");
+
+    const auto* index = reinterpret_cast<const PackEntry*>(file.data() + header.indexOffset);
+    const std::uint64_t namesSize = header.indexOffset - header.namesOffset;
+    for (std::uint32_t i = 0; i < header.entryCount; ++i) {
+        const PackEntry& entry = index[i];
+        // Sem somas: offsets enormes dariam a volta e passavam no teste
+        if (entry.dataOffset > header.namesOffset || entry.dataSize > header.namesOffset - entry.dataOffset)
+            return fail("dados fora do ficheiro");
+        if (!entrySizeMatches(entry)) return fail("tamanho da imagem nao bate com os dados");
+        if (static_cast<std::uint64_t>(entry.nameOffset) + entry.nameLength > namesSize) return fail("nome fora do ficheiro");
+        if (i > 0 && index[i - 1].hash > entry.hash) return fail("indice fora de ordem");
+    }
+
+    entries = index;
+    names = reinterpret_cast<const char*>(file.data() + header.namesOffset);
+    count = header.entryCount;
+    return true;
+}
+
+void AssetPack::close() {
+    file.close();
+    entries = nullptr;
+    names = nullptr;
+    count = 0;
+}
+
+std::string_view AssetPack::nameOf(const PackEntry& entry) const {
+    return std::string_view(names + entry.nameOffset, entry.nameLength);
+}
+
+const PackEntry* AssetPack::find(std::string_view name) const {
+    if (!entries) return nullptr;
+    const std::uint32_t hash = assetHash(name);
+    const PackEntry* end = entries + count;
+    const PackEntry* it = std::lower_bound(entries, end, hash,
+        [](const PackEntry& entry, std::uint32_t value) { return entry.hash < value; });
+    for (; it != end && it->hash == hash; ++it) {
+        if (nameOf(*it) == name) return it;
+    }
+    return nullptr;
+}
+
+bool AssetPack::decode(const PackEntry& entry, std::vector<std::uint8_t>& rgba) const {
+    if (!entrySizeMatches(entry)) return false;
+    const std::size_t pixelCount = static_cast<std::size_t>(entry.width) * entry.height;
+    rgba.resize(pixelCount * kPixelSize);
+    const std::uint8_t* data = file.data() + entry.dataOffset;
+    switch (entry.codec) {
+    case PackCodec::Raw:
+        if (entry.dataSize != rgba.size()) return false;
+        std::memcpy(rgba.data(), data, rgba.size());
+        return true;
+    case PackCodec::PixelRle:
+        return decodePixelRle(data, static_cast<std::size_t>(entry.dataSize), rgba.data(), pixelCount);
+    }
+    return false;
+}
+
+bool AssetPack::loadTexture(const PackEntry& entry, sf::Texture& texture, std::vector<std::uint8_t>& scratch) const {
+    const std::uint8_t* pixels = file.data() + entry.dataOffset;
+    if (entry.codec != PackCodec::Raw || entry.dataSize != static_cast<std::uint64_t>(entry.width) * entry.height * kPixelSize) {
+        if (!decode(entry, scratch)) return false;
+        pixels = scratch.data();
+    }
+    if (!texture.resize({ entry.width, entry.height })) return false;
+    texture.update(pixels);
+    return true;
+}
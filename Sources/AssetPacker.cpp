@@ -0,0 +1,180 @@
+#include "AssetPacker.hpp"
+#include "AssetPack.hpp"
+#include "AssetManager.hpp"
+#include "Logger.hpp"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+    using PackClock = std::chrono::steady_clock;
+
+    struct PackSource {
+        std::string name;       // Chave no pack, igual ao caminho que o jogo pede
+        fs::path path;
+        std::uint32_t hash = 0;
+    };
+
+    double elapsedMs(PackClock::time_point start) {
+        return std::chrono::duration<double, std::milli>(PackClock::now() - start).count();
+    }
+
+    void pad(std::ofstream& out, std::uint64_t& offset, std::uint64_t alignment) {
+        static const char zeros[16] = {};
+        const std::uint64_t padding = (alignment - offset % alignment) % alignment;
+        out.write(zeros, static_cast<std::streamsize>(padding));
+        offset += padding;
+    }
+
+    // Todos os PNG de 'root', com o nome relativo a pasta de cima
+    // ("Images/Isaac/Front_Isaac/F1V1.png"), ordenados por hash
+    bool collectSources(const fs::path& root, std::vector<PackSource>& sources) {
+        std::error_code error;
+        fs::path base = fs::absolute(root, error).lexically_normal();
+        if (base.filename().empty()) base = base.parent_path();
+        if (!fs::is_directory(base, error)) {
+            LOG_ERROR(LogCategory::Assets, "pasta de imagens '", root.string(), "' nao existe");
+            return false;
+        }
+
+        for (const auto& item : fs::recursive_directory_iterator(base, error)) {
+            if (!item.is_regular_file()) continue;
+            std::string extension = item.path().extension().string();
+            std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+            if (extension != ".png") continue;
+
+            PackSource source;
+            source.path = item.path();
+            source.name = fs::relative(item.path(), base.parent_path(), error).generic_string();
+            source.hash = assetHash(source.name);
+            sources.push_back(std::move(source));
+        }
+
+        std::sort(sources.begin(), sources.end(), [](const PackSource& a, const PackSource& b) {
+            return a.hash != b.hash ? a.hash < b.hash : a.name < b.name;
+            });
+        return true;
+    }
+
+    bool writePack(const std::vector<PackSource>& sources, const std::string& outputPath,
+        std::uint64_t& rawBytes, std::uint64_t& packedBytes) {
+        std::ofstream out(outputPath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            LOG_ERROR(LogCategory::Assets, "nao foi possivel criar '", outputPath, "'");
+            return false;
+        }
+
+        PackHeader header{};
+        std::memcpy(header.magic, kAssetPackMagic, sizeof(header.magic));
+        header.version = kAssetPackVersion;
+        header.entryCount = static_cast<std::uint32_t>(sources.size());
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        std::uint64_t offset = sizeof(header);
+
+        std::vector<PackEntry> index;
+        std::string names;
+        std::vector<std::uint8_t> encoded;
+        index.reserve(sources.size());
+
+        for (const PackSource& source : sources) {
+            sf::Image image;
+            if (!image.loadFromFile(source.path)) {
+                LOG_ERROR(LogCategory::Assets, "falha ao ler '", source.path.string(), "'");
+                return false;
+            }
+            const sf::Vector2u size = image.getSize();
+            const std::uint8_t* pixels = image.getPixelsPtr();
+            const std::size_t pixelCount = static_cast<std::size_t>(size.x) * size.y;
+            const std::size_t rgbaBytes = pixelCount * 4;
+
+            encoded.clear();
+            encodePixelRle(pixels, pixelCount, encoded);
+            const bool compress = encoded.size() < rgbaBytes;
+
+            pad(out, offset, 16);
+            PackEntry entry{};
+            entry.hash = source.hash;
+            entry.nameOffset = static_cast<std::uint32_t>(names.size());
+            entry.nameLength = static_cast<std::uint32_t>(source.name.size());
+            entry.width = size.x;
+            entry.height = size.y;
+            entry.codec = compress ? PackCodec::PixelRle : PackCodec::Raw;
+            entry.dataOffset = offset;
+            entry.dataSize = compress ? encoded.size() : rgbaBytes;
+            out.write(reinterpret_cast<const char*>(compress ? encoded.data() : pixels), static_cast<std::streamsize>(entry.dataSize));
+            offset += entry.dataSize;
+
+            names += source.name;
+            index.push_back(entry);
+            rawBytes += rgbaBytes;
+            packedBytes += entry.dataSize;
+        }
+
+        header.namesOffset = offset;
+        out.write(names.data(), static_cast<std::streamsize>(names.size()));
+        offset += names.size();
+        pad(out, offset, alignof(PackEntry));
+        header.indexOffset = offset;
+        out.write(reinterpret_cast<const char*>(index.data()), static_cast<std::streamsize>(index.size() * sizeof(PackEntry)));
+
+        out.seekp(0);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        return static_cast<bool>(out);
+    }
+}
+
+int runAssetPacker(const std::string& imagesDir, const std::string& outputPath) {
+    std::vector<PackSource> sources;
+    if (!collectSources(imagesDir, sources)) return 1;
+
+    // Dois caminhos diferentes com o mesmo hash partiriam a procura no indice
+    for (std::size_t i = 1; i < sources.size(); ++i) {
+        if (sources[i].hash == sources[i - 1].hash) {
+            LOG_ERROR(LogCategory::Assets, "colisao de hash entre '", sources[i - 1].name, "' e '", sources[i].name, "'");
+            return 1;
+        }
+    }
+
+    std::uint64_t rawBytes = 0;
+    std::uint64_t packedBytes = 0;
+    auto start = PackClock::now();
+    if (!writePack(sources, outputPath, rawBytes, packedBytes)) return 1;
+    const double buildMs = elapsedMs(start);
+
+    std::cout << "[AssetPack] " << sources.size() << " imagens -> " << outputPath << std::endl;
+    std::cout << std::fixed << std::setprecision(1)
+        << "  RGBA " << rawBytes / 1024.0 << " KB, no pack " << packedBytes / 1024.0 << " KB ("
+        << (rawBytes ? 100.0 * packedBytes / rawBytes : 0.0) << "%), gerado em " << buildMs << " ms" << std::endl;
+
+    // Arranque a frio dos dois caminhos (so CPU: ler + descodificar, sem GPU)
+    std::uint64_t checksum = 0;
+    start = PackClock::now();
+    for (const PackSource& source : sources) {
+        sf::Image image;
+        if (image.loadFromFile(source.path)) checksum += image.getSize().x;
+    }
+    const double looseMs = elapsedMs(start);
+
+    start = PackClock::now();
+    AssetPack pack;
+    std::vector<std::uint8_t> rgba;
+    if (pack.open(outputPath)) {
+        for (const PackSource& source : sources) {
+            const PackEntry* entry = pack.find(source.name);
+            if (entry && pack.decode(*entry, rgba)) checksum += entry->width;
+        }
+    }
+    const double packMs = elapsedMs(start);
+
+    std::cout << "  arranque: ficheiros soltos " << std::setprecision(2) << looseMs << " ms, pack " << packMs
+        << " ms (checksum " << checksum << ")" << std::endl;
+    return 0;
+}
@@ -0,0 +1,34 @@
+#include "Aura.hpp"
+#include "enemy.hpp"
+#include "CrowdSteering.hpp"
+#include "EventBus.hpp"
+
+void resolveAuras(const std::vector<AuraEffect>& auras, const CrowdSteering& crowd,
+    const std::vector<EnemyBase*>& agents, EventBus* events) {
+    for (const AuraEffect& aura : auras) {
+        auto apply = [&](int agent) {
+            if (agent < 0 || agent >= static_cast<int>(agents.size())) return;
+            EnemyBase* target = agents[agent];
+            if (target->getHealth() <= 0 || !(target->getAuraTargetBit() & aura.targets)) return;
+            if (target == aura.source && !aura.affectsSource) return;
+            if (events && aura.kind == AuraKind::Heal) {
+                const sf::FloatRect& box = target->getHitbox();
+                GameEvent heal;
+                heal.type = GameEventType::Heal;
+                heal.target = GameEventTarget::Enemy;
+                heal.enemy = target;
+                heal.amount = static_cast<int>(aura.magnitude);
+                heal.position = box.position + box.size / 2.f;
+                events->publish(heal);
+            }
+            else target->applyAura(aura);
+            };
+
+        if (aura.radius <= 0.f) {
+            for (int i = 0; i < static_cast<int>(agents.size()); ++i) apply(i);
+        }
+        else {
+            crowd.forEachInRadius(aura.center, aura.radius, apply);
+        }
+    }
+}
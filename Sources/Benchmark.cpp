@@ -0,0 +1,705 @@
+#include "Benchmark.hpp"
+#include "Collision.hpp"
+#include "JobSystem.hpp"
+#include "BulletPattern.hpp"
+#include "BossTimeline.hpp"
+#include "FlowField.hpp"
+#include "ObstacleGrid.hpp"
+#include "CrowdSteering.hpp"
+#include "ConfigManager.hpp"
+#include "DungeonGenerator.hpp"
+#include "RunSave.hpp"
+#include "Rooms.hpp"
+#include "EventBus.hpp"
+#include "GymEnv.hpp"
+#include "Logger.hpp"
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <cstdint>
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <cstring>
+
+namespace {
+    using BenchClock = std::chrono::steady_clock;
+
+    // Executa 'fn' e devolve o tempo gasto em nanosegundos
+    template <typename Fn>
+    double measureNs(Fn&& fn) {
+        auto start = BenchClock::now();
+        fn();
+        auto end = BenchClock::now();
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    }
+
+    sf::FloatRect randomRect(std::mt19937& rng) {
+        std::uniform_real_distribution<float> posX(0.f, 1920.f), posY(0.f, 1080.f), size(16.f, 96.f);
+        return sf::FloatRect({ posX(rng), posY(rng) }, { size(rng), size(rng) });
+    }
+
+    // Um retangulo contra um lote: mede rects/ns do kernel escalar e do SIMD
+    void benchCollision() {
+        const std::size_t batchSize = 4096;
+        const std::size_t probes = 2048;
+
+        std::mt19937 rng(1234);
+        RectBatch batch;
+        batch.reserve(batchSize);
+        for (std::size_t i = 0; i < batchSize; ++i) batch.push(randomRect(rng));
+
+        std::vector<sf::FloatRect> probeRects;
+        for (std::size_t i = 0; i < probes; ++i) probeRects.push_back(randomRect(rng));
+
+        std::vector<std::uint8_t> mask;
+        std::size_t hitsScalar = 0, hitsSimd = 0;
+        long long firstSum = 0;
+
+        double scalarNs = measureNs([&] {
+            for (const auto& r : probeRects) hitsScalar += collisionMaskScalar(r, batch, mask);
+            });
+        double simdNs = measureNs([&] {
+            for (const auto& r : probeRects) hitsSimd += collisionMask(r, batch, mask);
+            });
+        double firstNs = measureNs([&] {
+            for (const auto& r : probeRects) firstSum += firstCollision(r, batch);
+            });
+
+        const double tested = static_cast<double>(batchSize * probes);
+        std::cout << "[Collision] backend=" << collisionBackendName()
+            << " batch=" << batchSize << " probes=" << probes << std::endl;
+        std::cout << std::fixed << std::setprecision(3)
+            << "  scalar mask : " << tested / scalarNs << " rects/ns (hits " << hitsScalar << ")" << std::endl
+            << "  simd mask   : " << tested / simdNs << " rects/ns (hits " << hitsSimd << ")" << std::endl
+            << "  first hit   : " << firstNs / probes << " ns/probe (checksum " << firstSum << ")" << std::endl;
+        if (hitsScalar != hitsSimd) std::cout << "  AVISO: scalar e SIMD discordam!" << std::endl;
+    }
+
+    // Agente sintetico com o custo aproximado de um Demon/Bishop (perseguir/fugir + normalizar)
+    struct BenchAgent {
+        sf::Vector2f position;
+        float timer = 0.f;
+    };
+
+    void thinkAgent(BenchAgent& a, sf::Vector2f target, float dt) {
+        for (int step = 0; step < 16; ++step) {
+            sf::Vector2f diff = target - a.position;
+            float length = std::sqrt(diff.x * diff.x + diff.y * diff.y);
+            if (length > 0.f) diff /= length;
+            sf::Vector2f lateral = { -diff.y, diff.x };
+            a.timer += dt;
+            sf::Vector2f move = diff + lateral * std::sin(a.timer * 1.5f) * 0.5f;
+            float moveLength = std::sqrt(move.x * move.x + move.y * move.y);
+            if (moveLength > 0.f) move /= moveLength;
+            a.position += move * dt * 120.f;
+        }
+    }
+
+    // Update em serie vs parallelFor por blocos; o resultado tem de ser igual bit a bit
+    void benchJobSystem() {
+        const std::size_t agentCount = 4096;
+        const std::size_t chunkSize = 64;
+        const int ticks = 60;
+        const sf::Vector2f target(960.f, 540.f);
+        const float dt = 1.f / 60.f;
+
+        std::mt19937 rng(99);
+        std::uniform_real_distribution<float> posX(0.f, 1920.f), posY(0.f, 1080.f);
+        std::vector<BenchAgent> serial(agentCount);
+        for (auto& a : serial) a.position = { posX(rng), posY(rng) };
+        std::vector<BenchAgent> parallel = serial;
+
+        double serialNs = measureNs([&] {
+            for (int t = 0; t < ticks; ++t)
+                for (auto& a : serial) thinkAgent(a, target, dt);
+            });
+
+        JobSystem& jobs = JobSystem::getInstance();
+        if (jobs.workerCount() == 0) jobs.start(0);
+        double parallelNs = measureNs([&] {
+            for (int t = 0; t < ticks; ++t) {
+                jobs.parallelFor(agentCount, chunkSize, [&](std::size_t begin, std::size_t end, std::size_t) {
+                    for (std::size_t i = begin; i < end; ++i) thinkAgent(parallel[i], target, dt);
+                    });
+            }
+            });
+
+        bool identical = std::memcmp(serial.data(), parallel.data(), sizeof(BenchAgent) * agentCount) == 0;
+        std::cout << "[JobSystem] workers=" << jobs.workerCount() << " agents=" << agentCount
+            << " chunk=" << chunkSize << " ticks=" << ticks << std::endl;
+        std::cout << std::fixed << std::setprecision(3)
+            << "  serial   : " << serialNs / ticks / 1e6 << " ms/tick" << std::endl
+            << "  parallel : " << parallelNs / ticks / 1e6 << " ms/tick (x" << serialNs / parallelNs << ")" << std::endl
+            << "  identico : " << (identical ? "sim" : "NAO") << std::endl;
+    }
+
+    // Caminho antigo: cos/sin por projetil e sprite criado e configurado do zero
+    std::size_t emitLegacy(const sf::Texture& texture, const BulletPatternConfig& cfg, sf::Vector2f origin,
+        float aimDegrees, std::uint32_t& rngState, std::vector<EnemyProjectile>& out) {
+        const int speedSteps = std::max(1, static_cast<int>(std::lround((cfg.speed_max - cfg.speed_min) * 100.f)));
+        for (int i = 0; i < cfg.count; ++i) {
+            float angle = aimDegrees;
+            if (cfg.kind == BulletPatternKind::Ring) angle = (360.f / cfg.count) * i;
+            else if (cfg.kind == BulletPatternKind::Fan)
+                angle += -cfg.spread / 2.f + i * (cfg.count > 1 ? cfg.spread / (cfg.count - 1) : 0.f);
+            else angle += static_cast<float>(randomBelow(rngState, static_cast<int>(cfg.spread))) - cfg.spread / 2.f;
+            float rad = angle * static_cast<float>(M_PI / 180.0);
+            float speedMult = cfg.speed_min + static_cast<float>(randomBelow(rngState, speedSteps)) / 100.f;
+
+            EnemyProjectile p = { sf::Sprite(texture), { std::cos(rad) * speedMult, std::sin(rad) * speedMult }, 0.f };
+            p.sprite.setTextureRect(sf::IntRect({ 0, 0 }, { 16, 16 }));
+            p.sprite.setOrigin(sf::Vector2f(8.f, 8.f));
+            p.sprite.setPosition(origin);
+            p.sprite.setScale(sf::Vector2f(2.f, 2.f));
+            p.hitbox = makeHitbox(origin, HitboxConfig{});
+            out.push_back(p);
+        }
+        return static_cast<std::size_t>(cfg.count);
+    }
+
+    // Projeteis emitidos por ms: padrao com tabela + prototipo vs caminho antigo
+    void benchBulletPatterns() {
+        const int volleys = 2000;
+        const int volleysPerFrame = 20; // O vetor e esvaziado como se os projeteis saissem do ecra
+        const sf::Vector2f origin(960.f, 540.f);
+
+        sf::Texture texture;
+        EnemyProjectile prototype = { sf::Sprite(texture), {}, 0.f };
+        prototype.sprite.setTextureRect(sf::IntRect({ 0, 0 }, { 16, 16 }));
+        prototype.sprite.setOrigin(sf::Vector2f(8.f, 8.f));
+        prototype.sprite.setScale(sf::Vector2f(2.f, 2.f));
+
+        struct Case { const char* label; BulletPatternKind kind; int count; float spread; };
+        const Case cases[] = {
+            { "ring 55   ", BulletPatternKind::Ring, 55, 0.f },
+            { "fan 3     ", BulletPatternKind::Fan, 3, 20.f },
+            { "spiral 24 ", BulletPatternKind::Spiral, 24, 0.f },
+            { "random 18 ", BulletPatternKind::RandomSpread, 18, 60.f },
+        };
+
+        std::cout << "[BulletPatterns] volleys=" << volleys << std::endl;
+        std::vector<EnemyProjectile> out;
+        for (const Case& c : cases) {
+            BulletPatternConfig cfg;
+            cfg.kind = c.kind;
+            cfg.count = c.count;
+            cfg.spread = c.spread;
+            cfg.spiral_step = 7.5f;
+            cfg.aimed = c.kind != BulletPatternKind::Ring;
+            cfg.speed_min = 0.8f;
+            cfg.speed_max = 1.2f;
+            BulletPattern pattern(cfg);
+
+            std::uint32_t rng = 12345;
+            std::size_t emitted = 0;
+            double patternNs = measureNs([&] {
+                for (int v = 0; v < volleys; ++v) {
+                    if (v % volleysPerFrame == 0) out.clear();
+                    emitted += pattern.emit(prototype, HitboxConfig{}, origin, static_cast<float>(v % 360), v, rng, out);
+                }
+                });
+
+            rng = 12345;
+            std::size_t emittedLegacy = 0;
+            double legacyNs = measureNs([&] {
+                for (int v = 0; v < volleys; ++v) {
+                    if (v % volleysPerFrame == 0) out.clear();
+                    emittedLegacy += emitLegacy(texture, cfg, origin, static_cast<float>(v % 360), rng, out);
+                }
+                });
+
+            std::cout << std::fixed << std::setprecision(1)
+                << "  " << c.label << ": " << emitted / (patternNs / 1e6) << " bullets/ms (legacy "
+                << emittedLegacy / (legacyNs / 1e6) << ", x" << std::setprecision(2) << legacyNs / patternNs << ")" << std::endl;
+        }
+    }
+
+    // Lutas simuladas so com a timeline do boss (sem sprites nem janela), a vida fixa
+    // em varios niveis: mede a velocidade e conta os ataques por minuto de cada nivel
+    void benchBossTimeline() {
+        const auto& config = ConfigManager::getInstance().getConfig();
+        int timelineId = findBossTimeline(config.boss_timelines, "monstro");
+        if (timelineId < 0) {
+            std::cout << "[BossTimeline] sem timeline 'monstro', ignorado" << std::endl;
+            return;
+        }
+        const BossTimelineConfig& timeline = config.boss_timelines[timelineId];
+
+        const int fights = 200;
+        const float fightSeconds = 60.f;
+        const float dt = 1.f / 60.f;
+        const float healthLevels[] = { 1.0f, 0.6f, 0.4f, 0.2f };
+
+        std::cout << "[BossTimeline] timeline=monstro fights=" << fights << " x " << fightSeconds << "s por nivel de vida" << std::endl;
+        std::vector<BossOutput> out;
+        for (float health : healthLevels) {
+            std::size_t attacks = 0, ticks = 0;
+            std::uint32_t rng = 777;
+            double ns = measureNs([&] {
+                for (int f = 0; f < fights; ++f) {
+                    BossBrain brain(timeline);
+                    brain.setGroundPosition({ 960.f, 540.f });
+                    for (float t = 0.f; t < fightSeconds; t += dt) {
+                        // Jogador a circular pela sala
+                        sf::Vector2f player(960.f + std::cos(t) * 500.f, 540.f + std::sin(t) * 250.f);
+                        out.clear();
+                        brain.update(dt, player, health, rng, out);
+                        for (const BossOutput& o : out)
+                            if (o.event && o.event->kind == BossEventKind::Attack) ++attacks;
+                        ++ticks;
+                    }
+                }
+                });
+            std::cout << std::fixed << std::setprecision(2)
+                << "  vida " << health * 100.f << "% : " << attacks / (fights * fightSeconds / 60.f) << " ataques/min, "
+                << std::setprecision(0) << ticks / (ns / 1e6) << " ticks/ms" << std::endl;
+        }
+    }
+
+    // Flow field numa sala com uma parede no meio: custo do recalculo (so quando o
+    // jogador muda de celula) e da leitura por inimigo, para varios numeros de inimigos
+    void benchFlowField() {
+        const sf::FloatRect bounds({ 213.33f, 179.8f }, { 1493.34f, 720.4f });
+        FlowField field;
+        field.configure(bounds, 64.f);
+        for (int row = 2; row < field.rows() - 2; ++row) field.setBlocked(field.columns() / 2, row, true);
+
+        const int rebuilds = 500;
+        std::mt19937 rng(5);
+        std::uniform_real_distribution<float> posX(bounds.position.x, bounds.position.x + bounds.size.x);
+        std::uniform_real_distribution<float> posY(bounds.position.y, bounds.position.y + bounds.size.y);
+        std::vector<sf::Vector2f> targets;
+        for (int i = 0; i < rebuilds; ++i) targets.push_back({ posX(rng), posY(rng) });
+
+        int rebuilt = 0;
+        double rebuildNs = measureNs([&] {
+            for (const auto& t : targets) rebuilt += field.setTarget(t) ? 1 : 0;
+            });
+
+        std::cout << "[FlowField] grid=" << field.columns() << "x" << field.rows()
+            << std::fixed << std::setprecision(2) << " rebuild=" << rebuildNs / std::max(1, rebuilt) / 1e3 << " us" << std::endl;
+
+        for (int enemies : { 16, 256, 4096 }) {
+            std::vector<sf::Vector2f> positions;
+            for (int i = 0; i < enemies; ++i) positions.push_back({ posX(rng), posY(rng) });
+            sf::Vector2f sum;
+            double sampleNs = measureNs([&] {
+                for (int tick = 0; tick < 60; ++tick)
+                    for (const auto& p : positions) sum += field.direction(p);
+                });
+            std::cout << "  " << std::setw(5) << enemies << " inimigos: " << std::setprecision(1)
+                << sampleNs / (60.0 * enemies) << " ns/amostra (checksum " << std::setprecision(2) << sum.x + sum.y << ")" << std::endl;
+        }
+    }
+
+    // Rotina de movimento partilhada: so o clamp as bordas (o que havia antes) contra
+    // o resolve com uma sala cheia de obstaculos, em ns por entidade
+    void benchMovementResolve() {
+        const sf::FloatRect bounds({ 213.33f, 179.8f }, { 1493.34f, 720.4f });
+        const HitboxConfig shape{ 60.f, 80.f, 1.5f, 6.f };
+        ObstacleGrid obstacles;
+        obstacles.configure(bounds, 64.f);
+        ObstacleConfig dense;
+        dense.clusters_min = dense.clusters_max = 12;
+        obstacles.generate(dense, 1234u);
+
+        const int entities = 1024, ticks = 60;
+        std::mt19937 rng(9);
+        std::uniform_real_distribution<float> posX(bounds.position.x + 40.f, bounds.position.x + bounds.size.x - 40.f);
+        std::uniform_real_distribution<float> posY(bounds.position.y + 50.f, bounds.position.y + bounds.size.y - 50.f);
+        std::uniform_real_distribution<float> step(-6.f, 6.f);
+        std::vector<sf::Vector2f> start, motion;
+        for (int i = 0; i < entities; ++i) {
+            start.push_back({ posX(rng), posY(rng) });
+            motion.push_back({ step(rng), step(rng) });
+        }
+
+        auto run = [&](const ObstacleGrid* grid) {
+            std::vector<sf::Vector2f> positions = start;
+            double ns = measureNs([&] {
+                for (int tick = 0; tick < ticks; ++tick)
+                    for (int i = 0; i < entities; ++i)
+                        positions[i] = resolveMovement(positions[i], positions[i] + motion[i], shape, bounds, grid);
+                });
+            return ns / (static_cast<double>(ticks) * entities);
+            };
+
+        double clampNs = run(nullptr);
+        double resolveNs = run(&obstacles);
+
+        std::cout << "[MovementResolve] " << obstacles.solidCount() << " tiles solidos, " << entities << " entidades" << std::endl;
+        std::cout << std::fixed << std::setprecision(1)
+            << "  so bordas:  " << clampNs << " ns/entidade" << std::endl
+            << "  obstaculos: " << resolveNs << " ns/entidade" << std::endl;
+    }
+
+    // Steering de multidao de 10 a 1000 agentes com densidade constante (a area cresce
+    // com n): fotografia + spatial hash + steer de todos, contra a separacao ingenua O(n^2)
+    void benchCrowdSteering() {
+        SteeringConfig config;
+        CrowdSteering crowd;
+        crowd.configure(config);
+        const float radius = 50.f;
+        const float areaPerAgent = 1493.34f * 720.4f / 40.f;
+
+        std::cout << "[CrowdSteering] ns por agente (fotografia + steer)" << std::endl;
+        for (int agents : { 10, 100, 1000 }) {
+            const float side = std::sqrt(areaPerAgent * agents);
+            const sf::FloatRect bounds({ 0.f, 0.f }, { side, side });
+            std::mt19937 rng(17);
+            std::uniform_real_distribution<float> pos(0.f, side);
+            std::vector<sf::Vector2f> points;
+            for (int i = 0; i < agents; ++i) points.push_back({ pos(rng), pos(rng) });
+
+            const int ticks = 60;
+            sf::Vector2f sum;
+            double hashNs = measureNs([&] {
+                for (int tick = 0; tick < ticks; ++tick) {
+                    crowd.begin(bounds, nullptr);
+                    for (const auto& p : points) crowd.add(p, radius);
+                    crowd.finish();
+                    for (int i = 0; i < agents; ++i) sum += crowd.steer(i, { 1.f, 0.f });
+                }
+                });
+
+            double naiveNs = measureNs([&] {
+                for (int tick = 0; tick < ticks; ++tick) {
+                    for (int i = 0; i < agents; ++i) {
+                        sf::Vector2f push;
+                        for (int j = 0; j < agents; ++j) {
+                            if (i == j) continue;
+                            sf::Vector2f offset = points[i] - points[j];
+                            float distance = std::sqrt(offset.x * offset.x + offset.y * offset.y);
+                            if (distance < radius * 2.f && distance > 0.001f) push += offset / distance * (1.f - distance / (radius * 2.f));
+                        }
+                        sum += push;
+                    }
+                }
+                });
+
+            std::cout << "  " << std::setw(5) << agents << " agentes: hash=" << std::fixed << std::setprecision(1)
+                << hashNs / (static_cast<double>(ticks) * agents) << " ingenuo=" << naiveNs / (static_cast<double>(ticks) * agents)
+                << " (checksum " << std::setprecision(2) << sum.x + sum.y << ")" << std::endl;
+        }
+    }
+
+    // Custo de uma mensagem para quem a regista (formatar + entrar na fila), sem
+    // sinks: o que conta e o tempo roubado ao frame, nao a escrita em si
+    void benchLogging() {
+        LoggingConfig config;
+        config.console = false;
+        config.file.clear();
+        config.queue_capacity = 4096;
+        Logger& logger = Logger::getInstance();
+        logger.start(config);
+
+        const int messages = 200000;
+        const std::uint64_t droppedBefore = logger.droppedCount();
+        double queuedNs = measureNs([&] {
+            for (int i = 0; i < messages; ++i) LOG_INFO(LogCategory::General, "tick ", i, " vida ", 3.5f, " sala ", "boss");
+            });
+        const std::uint64_t dropped = logger.droppedCount() - droppedBefore;
+
+        // Combate limitado a 30/s: quase tudo e descartado antes de formatar
+        double limitedNs = measureNs([&] {
+            for (int i = 0; i < messages; ++i) LOG_INFO(LogCategory::Combat, "Dano: inimigo -", i, " (vida ", i, ")");
+            });
+        logger.stop();
+
+        std::cout << "[Logging] " << messages << " mensagens" << std::endl;
+        std::cout << std::fixed << std::setprecision(1)
+            << "  fila:     " << queuedNs / messages << " ns/msg (" << dropped << " descartadas com a fila cheia)\n"
+            << "  limitado: " << limitedNs / messages << " ns/msg" << std::endl;
+    }
+
+    // Gerador de andares com seeds seguidas: ms por andar e quantas plantas cumprem
+    // as restricoes sem relaxar, para cada bloco de "floors" da config
+    void benchDungeonGenerator() {
+        const auto& dungeon = ConfigManager::getInstance().getConfig().game.dungeon;
+        const int floors = 100000;
+        const int blocks = std::max<int>(1, static_cast<int>(dungeon.floors.size()));
+        DungeonGenerator generator;
+        DungeonLayout layout;
+
+        std::cout << "[DungeonGenerator] " << floors << " andares por bloco (tentativas: "
+            << dungeon.generator_attempts << ", boss a >= " << dungeon.min_boss_distance << " portas)" << std::endl;
+        for (int block = 0; block < blocks; ++block) {
+            const auto floorConfig = dungeon.floor(block);
+            int satisfied = 0;
+            std::uint64_t attempts = 0, rooms = 0, loops = 0, bossDistance = 0;
+            double ns = measureNs([&] {
+                for (int seed = 0; seed < floors; ++seed) {
+                    if (generator.generate(dungeon, floorConfig, static_cast<std::uint32_t>(seed), layout)) ++satisfied;
+                    attempts += layout.attempts;
+                    rooms += layout.rooms.size();
+                    loops += layout.loops;
+                    bossDistance += layout.bossDistance;
+                }
+                });
+            std::cout << "  andar " << block + 1 << " (" << floorConfig.min_rooms << "-" << floorConfig.max_rooms << " salas): "
+                << std::fixed << std::setprecision(4) << ns / floors / 1e6 << " ms/andar, "
+                << std::setprecision(2) << 100.0 * satisfied / floors << "% restricoes cumpridas, "
+                << static_cast<double>(attempts) / floors << " tentativas, "
+                << static_cast<double>(rooms) / floors << " salas, "
+                << static_cast<double>(loops) / floors << " ciclos, boss a "
+                << static_cast<double>(bossDistance) / floors << " portas" << std::endl;
+        }
+    }
+
+    // Save da run num andar de 16 salas: escrever e ler o buffer (o ficheiro e
+    // exatamente este buffer) com N inimigos vivos por sala, 4 projeteis cada
+    void benchRunSave() {
+        const auto& config = ConfigManager::getInstance().getConfig();
+        auto floorConfig = config.game.dungeon.floor(0);
+        floorConfig.min_rooms = 16;
+        floorConfig.max_rooms = 16;
+        DungeonGenerator generator;
+
+        RunSnapshot snapshot;
+        generator.generate(config.game.dungeon, floorConfig, 1234u, snapshot.layout);
+        const std::size_t roomCount = snapshot.layout.rooms.size();
+        std::vector<char> buffer;
+        RunSnapshot loaded;
+        const int iterations = 2000;
+
+        std::cout << "[RunSave] " << roomCount << " salas, " << iterations << " saves por linha" << std::endl;
+        for (int perRoom : { 0, 4, 16, 64 }) {
+            snapshot.rooms.assign(roomCount, RoomState());
+            snapshot.doors.clear();
+            snapshot.enemies.clear();
+            snapshot.projectiles.clear();
+            for (std::size_t id = 0; id < roomCount; ++id) {
+                RoomState& room = snapshot.rooms[id];
+                room.spawned = 1;
+                room.enemyBegin = static_cast<std::uint32_t>(snapshot.enemies.size());
+                room.enemyCount = static_cast<std::uint32_t>(perRoom);
+                for (int i = 0; i < perRoom; ++i) {
+                    EnemyState enemy;
+                    enemy.health = 10;
+                    enemy.position = { 400.f + i, 300.f + i };
+                    enemy.projectileBegin = static_cast<std::uint32_t>(snapshot.projectiles.size());
+                    enemy.projectileCount = 4;
+                    snapshot.enemies.push_back(enemy);
+                    snapshot.projectiles.resize(snapshot.projectiles.size() + 4);
+                }
+            }
+
+            double writeNs = measureNs([&] {
+                for (int i = 0; i < iterations; ++i) writeRunSnapshot(snapshot, config, buffer);
+                });
+            bool ok = true;
+            double readNs = measureNs([&] {
+                for (int i = 0; i < iterations; ++i) ok = readRunSnapshot(buffer, config, loaded) && ok;
+                });
+            std::cout << "  " << std::setw(5) << snapshot.enemies.size() << " inimigos (" << buffer.size() / 1024.0 << " KB): "
+                << std::fixed << std::setprecision(2) << writeNs / iterations / 1000.0 << " us a escrever, "
+                << readNs / iterations / 1000.0 << " us a ler" << (ok ? "" : " [LEITURA FALHOU]") << std::endl;
+        }
+    }
+
+    // WorldSnapshot numa sala com N inimigos (e os seus projeteis): capturar, repor
+    // por cima dos objetos que existem, e o caminho antigo de construir a sala e os
+    // inimigos de novo. Texturas vazias (headlessTextures): so conta o estado, nao o desenho.
+    void benchWorldSnapshot() {
+        const auto& config = ConfigManager::getInstance().getConfig();
+        const sf::FloatRect bounds({ (float)config.game.bounds.left, (float)config.game.bounds.top },
+            { (float)config.game.bounds.width, (float)config.game.bounds.height });
+        const sf::Vector2f player = bounds.position + sf::Vector2f(bounds.size.x / 2.f, bounds.size.y - 80.f);
+        BulletPatternLibrary::getInstance().build(config.bullet_patterns);
+
+        // As mesmas texturas (e portanto os mesmos clips) do GymEnv: os clips sao
+        // globais e o benchGymEnv corre a seguir
+        GymEnv::prepare();
+        const EnemyTextures& textures = headlessTextures().enemies;
+        const int chubbyType = config.archetypes.find("chubby");
+
+        const int iterations = 2000;
+        std::cout << "[WorldSnapshot] por sala, " << iterations << " capturas/restores por linha" << std::endl;
+        for (int count : { 8, 32, 128, 512 }) {
+            std::mt19937 rng(99);
+            std::uniform_real_distribution<float> x(bounds.position.x + 60.f, bounds.position.x + bounds.size.x - 60.f);
+            std::uniform_real_distribution<float> y(bounds.position.y + 60.f, bounds.position.y + bounds.size.y / 2.f);
+            std::vector<EnemySpawn> roster;
+            for (int i = 0; i < count; ++i) {
+                EnemySpawn spawn;
+                spawn.kind = i % 8 == 7 ? SpawnKind::Bishop : (i % 4 == 3 && chubbyType >= 0 ? SpawnKind::Chubby : SpawnKind::Demon);
+                spawn.archetype = static_cast<std::uint16_t>(std::max(chubbyType, 0));
+                spawn.position = { x(rng), y(rng) };
+                roster.push_back(spawn);
+            }
+
+            Room room(1, RoomType::Normal, bounds, 4242u);
+            room.setRoster(roster, 1.f);
+            room.spawnEnemies(textures);
+            // Uns segundos de jogo para haver projeteis e timers a meio
+            for (int tick = 0; tick < 120; ++tick) {
+                room.update(1.f / 60.f, player);
+                EventBus::getInstance().dispatch();
+            }
+
+            RoomState state;
+            std::vector<DoorSaveState> doors;
+            std::vector<EnemyState> enemies;
+            std::vector<ProjectileState> projectiles;
+            double captureNs = measureNs([&] {
+                for (int i = 0; i < iterations; ++i) {
+                    doors.clear();
+                    enemies.clear();
+                    projectiles.clear();
+                    room.captureState(state, doors, enemies, projectiles, false);
+                }
+                });
+            const bool inPlace = room.restoresInPlace(state, enemies.data());
+            double restoreNs = measureNs([&] {
+                for (int i = 0; i < iterations; ++i) room.restoreState(state, doors.data(), enemies.data(), projectiles.data(), textures);
+                });
+            const int rebuilds = std::max(1, iterations / 20);
+            double rebuildNs = measureNs([&] {
+                for (int i = 0; i < rebuilds; ++i) {
+                    Room fresh(1, RoomType::Normal, bounds, 4242u);
+                    fresh.restoreState(state, doors.data(), enemies.data(), projectiles.data(), textures);
+                }
+                });
+            std::cout << "  " << std::setw(4) << enemies.size() << " inimigos, " << std::setw(4) << projectiles.size() << " projeteis: "
+                << std::fixed << std::setprecision(2) << captureNs / iterations / 1000.0 << " us a capturar, "
+                << restoreNs / iterations / 1000.0 << " us a repor" << (inPlace ? "" : " [RECONSTRUIU]") << ", "
+                << rebuildNs / rebuilds / 1000.0 << " us a reconstruir a sala" << std::endl;
+        }
+    }
+
+    // A mesma sala (seed e roster) em serie e com o update dos inimigos nos workers:
+    // o modo paralelo tem de dar exatamente os mesmos registos do captureState
+    void benchParallelRoomAI() {
+        const auto& config = ConfigManager::getInstance().getConfig();
+        const sf::FloatRect bounds({ (float)config.game.bounds.left, (float)config.game.bounds.top },
+            { (float)config.game.bounds.width, (float)config.game.bounds.height });
+        const sf::Vector2f center = bounds.position + bounds.size / 2.f;
+        BulletPatternLibrary::getInstance().build(config.bullet_patterns);
+        GymEnv::prepare();
+        const EnemyTextures& textures = headlessTextures().enemies;
+        const int chubbyType = config.archetypes.find("chubby");
+        const int monstroType = config.archetypes.find("monstro");
+
+        JobSystem& jobs = JobSystem::getInstance();
+        if (jobs.workerCount() == 0) jobs.start(0);
+
+        const int enemyCount = 256;
+        const int ticks = 600;
+        std::mt19937 rng(31);
+        std::uniform_real_distribution<float> x(bounds.position.x + 60.f, bounds.position.x + bounds.size.x - 60.f);
+        std::uniform_real_distribution<float> y(bounds.position.y + 60.f, bounds.position.y + bounds.size.y - 60.f);
+        std::vector<EnemySpawn> roster;
+        for (int i = 0; i < enemyCount; ++i) {
+            EnemySpawn spawn;
+            spawn.kind = i % 8 == 7 ? SpawnKind::Bishop : (i % 4 == 3 && chubbyType >= 0 ? SpawnKind::Chubby : SpawnKind::Demon);
+            spawn.archetype = static_cast<std::uint16_t>(std::max(chubbyType, 0));
+            spawn.position = { x(rng), y(rng) };
+            roster.push_back(spawn);
+        }
+        if (monstroType >= 0) {
+            EnemySpawn boss;
+            boss.kind = SpawnKind::Monstro;
+            boss.archetype = static_cast<std::uint16_t>(monstroType);
+            boss.position = center;
+            roster.push_back(boss);
+        }
+
+        Room serial(1, RoomType::Normal, bounds, 777u);
+        Room parallel(1, RoomType::Normal, bounds, 777u);
+        serial.setParallelAI(false);
+        for (Room* room : { &serial, &parallel }) {
+            room->setRoster(roster, 1.f);
+            room->spawnEnemies(textures);
+        }
+
+        // O Isaac anda em circulo para o flow field e as auras mudarem ao longo do teste
+        auto playerAt = [&](int tick) {
+            const float angle = tick * 0.02f;
+            return center + sf::Vector2f(std::cos(angle) * bounds.size.x / 3.f, std::sin(angle) * bounds.size.y / 3.f);
+            };
+        double serialNs = 0.0, parallelNs = 0.0;
+        for (int tick = 0; tick < ticks; ++tick) {
+            const sf::Vector2f player = playerAt(tick);
+            serialNs += measureNs([&] { serial.update(1.f / 60.f, player); });
+            parallelNs += measureNs([&] { parallel.update(1.f / 60.f, player); });
+            EventBus::getInstance().dispatch();
+        }
+
+        RoomState serialRoom, parallelRoom;
+        std::vector<DoorSaveState> serialDoors, parallelDoors;
+        std::vector<EnemyState> serialEnemies, parallelEnemies;
+        std::vector<ProjectileState> serialProjectiles, parallelProjectiles;
+        serial.captureState(serialRoom, serialDoors, serialEnemies, serialProjectiles, false);
+        parallel.captureState(parallelRoom, parallelDoors, parallelEnemies, parallelProjectiles, false);
+        const bool identical = serialEnemies.size() == parallelEnemies.size() &&
+            serialProjectiles.size() == parallelProjectiles.size() &&
+            std::memcmp(serialEnemies.data(), parallelEnemies.data(), sizeof(EnemyState) * serialEnemies.size()) == 0 &&
+            std::memcmp(serialProjectiles.data(), parallelProjectiles.data(), sizeof(ProjectileState) * serialProjectiles.size()) == 0;
+
+        std::cout << "[RoomAI] workers=" << jobs.workerCount() << " inimigos=" << serialEnemies.size()
+            << " ticks=" << ticks << " projeteis=" << serialProjectiles.size() << std::endl;
+        std::cout << std::fixed << std::setprecision(3)
+            << "  serial   : " << serialNs / ticks / 1e6 << " ms/tick" << std::endl
+            << "  parallel : " << parallelNs / ticks / 1e6 << " ms/tick (x" << serialNs / parallelNs << ")" << std::endl;
+        if (!identical) std::cout << "  AVISO: serie e paralelo discordam!" << std::endl;
+    }
+
+    // VecEnv: steps por segundo em serie e repartidos pelo JobSystem. As duas copias
+    // recebem as mesmas seeds e acoes, por isso as observacoes tem de bater certo.
+    void benchGymEnv() {
+        const auto& config = ConfigManager::getInstance().getConfig();
+        BulletPatternLibrary::getInstance().build(config.bullet_patterns);
+        JobSystem& jobs = JobSystem::getInstance();
+        if (jobs.workerCount() == 0) jobs.start(0);
+
+        const std::size_t envCount = 64;
+        const int steps = 200;
+        VecEnv serial(envCount);
+        VecEnv parallel(envCount);
+        serial.reset(2024u);
+        parallel.reset(2024u);
+
+        std::mt19937 rng(7);
+        std::uniform_int_distribution<int> pick(0, kGymActionCount - 1);
+        std::vector<int> actions(envCount * steps);
+        for (int& action : actions) action = pick(rng);
+
+        double serialNs = measureNs([&] {
+            for (int t = 0; t < steps; ++t) serial.step(actions.data() + t * envCount);
+            });
+        double parallelNs = measureNs([&] {
+            for (int t = 0; t < steps; ++t) parallel.stepParallel(actions.data() + t * envCount);
+            });
+
+        const std::size_t floats = envCount * kGymObservationSize;
+        const bool same = std::equal(serial.observations(), serial.observations() + floats, parallel.observations()) &&
+            std::equal(serial.rewards(), serial.rewards() + envCount, parallel.rewards());
+        const double total = static_cast<double>(envCount) * steps;
+        std::cout << "[GymEnv] " << envCount << " ambientes x " << steps << " steps (" << config.game.gym.frame_skip
+            << " ticks/step, " << jobs.workerCount() << " workers): " << std::fixed << std::setprecision(0)
+            << total / (serialNs / 1e9) << " steps/s em serie, " << total / (parallelNs / 1e9) << " steps/s em paralelo"
+            << (same ? "" : " [DIVERGIU]") << std::endl;
+    }
+}
+
+void runBenchmarks() {
+    std::cout << "=== Benchmarks ===" << std::endl;
+    benchCollision();
+    benchJobSystem();
+    benchBulletPatterns();
+    benchFlowField();
+    benchMovementResolve();
+    benchCrowdSteering();
+
+    try { ConfigManager::getInstance().loadConfig("config.json"); }
+    catch (const std::exception& e) { LOG_ERROR(LogCategory::Config, "falha ao carregar a config: ", e.what()); }
+    benchBossTimeline();
+    benchDungeonGenerator();
+    benchRunSave();
+    benchWorldSnapshot();
+    benchParallelRoomAI();
+    benchGymEnv();
+    benchLogging();
+}
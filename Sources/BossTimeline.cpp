@@ -0,0 +1,170 @@
+#include "BossTimeline.hpp"
+#include "Utils.hpp"
+#include <algorithm>
+#include <cmath>
+
+BossBrain::BossBrain(const BossTimelineConfig& config)
+    : timeline(&config), state(config.initial) {
+}
+
+void BossBrain::setGroundPosition(sf::Vector2f position) {
+    ground = position;
+    setBody(position);
+}
+
+void BossBrain::setBody(sf::Vector2f position) {
+    if (position == body) return;
+    body = position;
+    bodyDirty = true;
+}
+
+void BossBrain::save(EnemyState& saved) const {
+    saved.timers[0] = timer;
+    saved.points[0] = ground;
+    saved.points[1] = body;
+    saved.points[2] = target;
+    saved.points[3] = moveDir;
+    saved.points[4] = scale;
+    saved.values[0] = state;
+    saved.values[1] = static_cast<std::int32_t>(nextEvent);
+    saved.values[2] = activeSegment;
+    saved.values[3] = lastAction;
+    saved.values[4] = started ? 1 : 0;
+}
+
+void BossBrain::load(const EnemyState& saved) {
+    const int stateCount = static_cast<int>(timeline->states.size());
+    state = stateCount > 0 ? std::clamp(saved.values[0], 0, stateCount - 1) : 0;
+    timer = saved.timers[0];
+    nextEvent = static_cast<std::size_t>(std::max(saved.values[1], 0));
+    activeSegment = saved.values[2];
+    lastAction = saved.values[3];
+    started = saved.values[4] != 0;
+    ground = saved.points[0];
+    body = saved.points[1];
+    target = saved.points[2];
+    moveDir = saved.points[3];
+    scale = saved.points[4];
+    bodyDirty = false;
+    scaleDirty = false;
+}
+
+void BossBrain::update(float deltaTime, sf::Vector2f playerPosition, float healthFraction,
+    std::uint32_t& rngState, std::vector<BossOutput>& out) {
+    bodyDirty = false;
+    scaleDirty = false;
+    if (timeline->states.empty()) return;
+
+    if (!started) {
+        started = true;
+        enterState(timeline->initial, playerPosition, out);
+    }
+
+    timer += deltaTime;
+    fireEvents(playerPosition, out);
+
+    const BossStateConfig& current = currentState();
+    if (timer >= current.duration) {
+        enterState(pickTransition(healthFraction, rngState), playerPosition, out);
+        return;
+    }
+
+    for (const auto& segment : current.segments) {
+        if (timer < segment.start || timer >= segment.end) continue;
+        if (segment.id != activeSegment) {
+            activeSegment = segment.id;
+            out.push_back({ &segment, nullptr });
+        }
+        applySegment(segment, deltaTime, playerPosition);
+        break;
+    }
+}
+
+void BossBrain::enterState(int index, sf::Vector2f playerPosition, std::vector<BossOutput>& out) {
+    state = index;
+    timer = 0.f;
+    nextEvent = 0;
+    activeSegment = -1;
+    if (currentState().action) lastAction = index;
+    // Eventos no instante 0 acontecem logo na entrada (ex.: apontar ao jogador)
+    fireEvents(playerPosition, out);
+}
+
+void BossBrain::fireEvents(sf::Vector2f playerPosition, std::vector<BossOutput>& out) {
+    const auto& events = currentState().events;
+    while (nextEvent < events.size() && events[nextEvent].time <= timer) {
+        const BossEventConfig& event = events[nextEvent++];
+        switch (event.kind) {
+        case BossEventKind::Aim:
+            target = playerPosition;
+            break;
+        case BossEventKind::AimMove: {
+            sf::Vector2f dir = playerPosition - ground;
+            float dist = std::sqrt(dir.x * dir.x + dir.y * dir.y);
+            moveDir = dist > 0.f ? dir / dist : sf::Vector2f(0.f, 0.f);
+            break;
+        }
+        case BossEventKind::Land:
+            setBody(ground);
+            break;
+        case BossEventKind::Attack:
+            break;
+        }
+        out.push_back({ nullptr, &event });
+    }
+}
+
+int BossBrain::pickTransition(float healthFraction, std::uint32_t& rngState) const {
+    for (const auto& transition : currentState().transitions) {
+        if (transition.to_index < 0) continue;
+        if (transition.health_below > 0.f && healthFraction >= transition.health_below) continue;
+        if (transition.last_action_index >= 0 && transition.last_action_index != lastAction) continue;
+        // O sorteio so acontece se o resto passou (mesma sequencia aleatoria do switch antigo)
+        if (transition.chance < 100 && randomBelow(rngState, 100) >= transition.chance) continue;
+        return transition.to_index;
+    }
+    return timeline->initial;
+}
+
+void BossBrain::applySegment(const BossSegmentConfig& segment, float deltaTime, sf::Vector2f playerPosition) {
+    const float length = segment.end - segment.start;
+    const float progress = length > 0.f ? (timer - segment.start) / length : 1.f;
+
+    switch (segment.motion) {
+    case BossMotion::None:
+        break;
+    case BossMotion::Ground:
+        setBody(ground);
+        break;
+    case BossMotion::Hop: {
+        ground += moveDir * segment.speed * deltaTime;
+        float arc = std::sin(progress * static_cast<float>(M_PI)) * segment.height;
+        setBody({ ground.x, ground.y - arc });
+        break;
+    }
+    case BossMotion::Rise:
+        setBody({ body.x, body.y - segment.speed * deltaTime });
+        break;
+    case BossMotion::Chase: {
+        sf::Vector2f dir = target - ground;
+        float dist = std::sqrt(dir.x * dir.x + dir.y * dir.y);
+        if (dist > 5.f) ground += (dir / dist) * segment.speed * deltaTime;
+        break;
+    }
+    case BossMotion::Drop:
+        setBody({ ground.x, ground.y - segment.height + progress * segment.height });
+        break;
+    }
+
+    if (segment.set_scale) {
+        float facing = scale.x < 0.f ? -1.f : 1.f;
+        if (segment.face_player) facing = playerPosition.x > ground.x ? -1.f : 1.f;
+        sf::Vector2f next(
+            facing * (segment.scale_x + (segment.scale_to_x - segment.scale_x) * progress),
+            segment.scale_y + (segment.scale_to_y - segment.scale_y) * progress);
+        if (next != scale) {
+            scale = next;
+            scaleDirty = true;
+        }
+    }
+}
@@ -0,0 +1,99 @@
+#include "BulletPattern.hpp"
+#include "Collision.hpp"
+#include "Utils.hpp"
+#include "Logger.hpp"
+#include <algorithm>
+#include <cmath>
+
+BulletPattern::BulletPattern(const BulletPatternConfig& cfg)
+    : config(cfg) {
+    config.count = std::max(1, config.count);
+
+    // Multiplicador de velocidade aleatorio em passos de 0.01 entre speed_min e speed_max
+    speedSteps = std::max(1, static_cast<int>(std::lround((config.speed_max - config.speed_min) * 100.f)));
+
+    switch (config.kind) {
+    case BulletPatternKind::Ring:
+    case BulletPatternKind::Spiral:
+        for (int i = 0; i < config.count; ++i) angles.push_back((360.f / config.count) * i);
+        break;
+    case BulletPatternKind::Fan: {
+        float step = config.count > 1 ? config.spread / (config.count - 1) : 0.f;
+        for (int i = 0; i < config.count; ++i) angles.push_back(-config.spread / 2.f + i * step);
+        break;
+    }
+    case BulletPatternKind::RandomSpread: {
+        // Uma entrada por grau; cada projetil escolhe uma ao acaso
+        int slots = std::max(1, static_cast<int>(config.spread));
+        for (int i = 0; i < slots; ++i) angles.push_back(static_cast<float>(i) - config.spread / 2.f);
+        break;
+    }
+    }
+
+    directions.reserve(angles.size());
+    for (float angle : angles) {
+        float rad = angle * static_cast<float>(M_PI / 180.0);
+        directions.push_back({ std::cos(rad), std::sin(rad) });
+    }
+}
+
+std::size_t BulletPattern::emit(const EnemyProjectile& prototype, const HitboxConfig& hitboxShape,
+    sf::Vector2f origin, float aimDegrees, int volley, std::uint32_t& rngState,
+    std::vector<EnemyProjectile>& out) const {
+    float rotation = config.aimed ? aimDegrees : 0.f;
+    if (config.kind == BulletPatternKind::Spiral) rotation += config.spiral_step * volley;
+
+    const float rad = rotation * static_cast<float>(M_PI / 180.0);
+    const float c = std::cos(rad);
+    const float s = std::sin(rad);
+
+    const sf::Vector2f position = origin + sf::Vector2f(0.f, config.offset_y);
+    const sf::FloatRect hitbox = makeHitbox(position, hitboxShape);
+    const bool random = config.kind == BulletPatternKind::RandomSpread;
+    const int slots = static_cast<int>(directions.size());
+
+    out.reserve(out.size() + config.count);
+    for (int i = 0; i < config.count; ++i) {
+        int slot = random ? randomBelow(rngState, static_cast<int>(config.spread)) % slots : i;
+        float speedMult = config.speed_min + static_cast<float>(randomBelow(rngState, speedSteps)) / 100.f;
+
+        const sf::Vector2f& d = directions[slot];
+        out.push_back(prototype);
+        EnemyProjectile& p = out.back();
+        p.direction = sf::Vector2f(d.x * c - d.y * s, d.x * s + d.y * c) * speedMult;
+        p.distanceTraveled = 0.f;
+        p.lastStep = {};
+        p.hitbox = hitbox;
+        p.sprite.setPosition(position);
+        if (config.projectile_scale > 0.f)
+            p.sprite.setScale(sf::Vector2f(config.projectile_scale, config.projectile_scale));
+        if (config.orient_sprites)
+            p.sprite.setRotation(sf::degrees(rotation + angles[slot] + config.sprite_rotation));
+    }
+    return static_cast<std::size_t>(config.count);
+}
+
+// --- Biblioteca ---
+
+BulletPatternLibrary& BulletPatternLibrary::getInstance() {
+    static BulletPatternLibrary instance;
+    return instance;
+}
+
+void BulletPatternLibrary::build(const std::vector<BulletPatternConfig>& configs) {
+    patterns.clear();
+    patterns.reserve(configs.size());
+    for (const auto& cfg : configs) patterns.emplace_back(cfg);
+}
+
+const BulletPattern* BulletPatternLibrary::find(const std::string& name) const {
+    for (const auto& pattern : patterns)
+        if (pattern.getConfig().name == name) return &pattern;
+    LOG_ERROR(LogCategory::Config, "padrao de disparo '", name, "' nao existe");
+    return nullptr;
+}
+
+const BulletPattern* BulletPatternLibrary::get(int id) const {
+    if (id < 0 || id >= static_cast<int>(patterns.size())) return nullptr;
+    return &patterns[id];
+}
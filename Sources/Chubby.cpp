@@ -1,29 +1,65 @@
 #include "Chubby.hpp"
+#include "Collision.hpp"
+#include "ConfigManager.hpp"
+#include <algorithm>
 #include <cmath>
 #include <random>
 #include <iostream>
-
-Chubby::Chubby(sf::Texture& sheet, sf::Texture& projSheet) : EnemyBase() {
-    scaleFactor = 2.5f;
+#include <string>
+
+Chubby::Chubby(const EnemyArchetype& type, sf::Texture& sheet, sf::Texture& projSheet)
+    : EnemyBase(), archetype(type) {
+    scaleFactor = archetype.stats.scale;
+    hitboxShape = archetype.hitbox;
+    boomerangHitboxShape = archetype.projectile.hitbox;
+
+    // O config ja foi validado no load (validateArchetype), todos os clips existem
+    auto& library = AnimationLibrary::getInstance();
+    auto clip = [&](const std::string& name) { return library.fromArchetype(archetype, archetype.findClip(name.c_str())); };
+    clipIdle = clip("idle");
+    clipWalk = clip("walk");
+    const char* dirNames[3] = { "side", "down", "up" };
+    for (int d = 0; d < 3; ++d) {
+        std::string suffix = std::string("_") + dirNames[d];
+        clipWindup[d] = clip("windup" + suffix);
+        clipThrow[d] = clip("throw" + suffix);
+        clipBoomerang[d] = clip("boomerang" + suffix);
+        clipReturn[d] = clip("return" + suffix);
+    }
 
     sprite.emplace(sheet);
-    sprite->setTextureRect({ {242, 24}, {28, 32} });
+    animation.play(clipIdle);
+    animation.apply(*sprite);
     sprite->setScale({ scaleFactor, scaleFactor });
 
     projectileSprite.emplace(projSheet);
     projectileSprite->setScale({ scaleFactor, scaleFactor });
     projectileSprite->setOrigin({ 12.f, 9.f });
     projectileSprite->setPosition({ -9999.f, -9999.f });
-    projectileSprite->setTextureRect({ {458, 12}, {24, 18} });
+    projectileSprite->setTextureRect(frameRect(clipBoomerang[0]));
 
-    health = 7;
+    health = archetype.stats.health;
     state = ChubbyState::Idle;
     faceDir = FaceDir::Down;
     stateTimer = 0.f;
-    animTimer = 0.f;
-    animFrame = 0;
     boomerangActive = false;
     distanceWalked = 0.f;
+    refreshHitbox();
+}
+
+int Chubby::dirIndex() const {
+    if (faceDir == FaceDir::Down) return 1;
+    if (faceDir == FaceDir::Up) return 2;
+    return 0;
+}
+
+sf::IntRect Chubby::frameRect(const AnimationClip* clip, int frame) const {
+    return clip->frame(frame).rect;
+}
+
+void Chubby::showClip(const AnimationClip* clip) {
+    animation.play(clip);
+    animation.apply(*sprite);
 }
 
 // Implementao do Dano
@@ -31,28 +67,27 @@ void Chubby::takeDamage(int amount) {
     if (health > 0) {
         health -= amount;
         isHit = true;
-        hitClock.restart();
+        hitTimer = 0.f;
         if (sprite) sprite->setColor(sf::Color::Red);
-        std::cout << "Chubby levou dano! Vida atual: " << health << std::endl;
     }
 }
 
-// Implementao da Cura (Corrigida com healFlashClock)
+// Implementao da Cura (Corrigida com healFlashTimer)
 void Chubby::heal(int amount) {
     if (health > 0) {
         health += amount;
         // Opcional: health = std::min(health, maxHealth);
 
         isHealing = true;             // Varivel da EnemyBase
-        healFlashClock.restart();     // Nome sincronizado com Enemy.hpp
+        healFlashTimer = 0.f;         // Nome sincronizado com Enemy.hpp
 
         if (sprite) sprite->setColor(sf::Color::Green);
-        std::cout << "Chubby curado! Vida atual: " << health << std::endl;
     }
 }
 
 void Chubby::setPosition(const sf::Vector2f& pos) {
     if (sprite) sprite->setPosition(pos);
+    refreshHitbox();
 }
 
 sf::FloatRect Chubby::getGlobalBounds() const {
@@ -61,7 +96,7 @@ sf::FloatRect Chubby::getGlobalBounds() const {
 
 sf::FloatRect Chubby::getBoomerangBounds() const {
     if (boomerangActive && projectileSprite) {
-        return projectileSprite->getGlobalBounds();
+        return boomerangHitbox;
     }
     return sf::FloatRect({ 0, 0 }, { 0, 0 });
 }
@@ -95,12 +130,12 @@ void Chubby::update(float deltaTime, sf::Vector2f playerPos, const sf::FloatRect
 
     switch (state) {
     case ChubbyState::Idle:
-        sprite->setTextureRect({ {242, 24}, {28, 32} });
-        if (stateTimer >= 0.4f) {
+        showClip(clipIdle);
+        if (stateTimer >= archetype.timing.idle_time) {
             state = ChubbyState::Moving;
             stateTimer = 0;
             distanceWalked = 0.f;
-            int r = rand() % 8;
+            int r = randomInt(8);
             if (r == 0) { moveDir = { 1, 0 }; faceDir = FaceDir::Right; }
             else if (r == 1) { moveDir = { -1, 0 }; faceDir = FaceDir::Left; }
             else if (r == 2) { moveDir = { 0, 1 }; faceDir = FaceDir::Down; }
@@ -109,7 +144,8 @@ void Chubby::update(float deltaTime, sf::Vector2f playerPos, const sf::FloatRect
         break;
 
     case ChubbyState::Moving:
-        if (!boomerangActive && distToPlayer < 300.f && (std::abs(diff.x) < 150.f || std::abs(diff.y) < 150.f)) {
+        if (!boomerangActive && distToPlayer < archetype.movement.aggro_range &&
+            (std::abs(diff.x) < archetype.movement.aggro_band || std::abs(diff.y) < archetype.movement.aggro_band)) {
             if (std::abs(diff.x) > std::abs(diff.y)) faceDir = (diff.x > 0) ? FaceDir::Right : FaceDir::Left;
             else faceDir = (diff.y > 0) ? FaceDir::Down : FaceDir::Up;
             state = ChubbyState::Attacking;
@@ -118,27 +154,25 @@ void Chubby::update(float deltaTime, sf::Vector2f playerPos, const sf::FloatRect
         }
 
         {
-            sf::Vector2f movement = moveDir * 110.f * deltaTime;
+            sf::Vector2f movement = moveDir * archetype.stats.speed * speedMultiplier * deltaTime;
             sf::Vector2f nextPos = myPos + movement;
-            float spriteW = 28.f * scaleFactor;
-            float spriteH = 32.f * scaleFactor;
-
-            bool canMove = true;
-            if (nextPos.x < gameBounds.position.x || (nextPos.x + spriteW) >(gameBounds.position.x + gameBounds.size.x)) canMove = false;
-            if (nextPos.y < gameBounds.position.y || (nextPos.y + spriteH) >(gameBounds.position.y + gameBounds.size.y)) canMove = false;
 
-            if (canMove) {
-                sprite->move(movement);
+            // Bordas e obstaculos da sala pela rotina partilhada; se nao andou tudo, bateu.
+            // Outro inimigo encostado a frente tambem conta como parede.
+            sf::Vector2f resolved = resolveMovement(myPos, nextPos, hitboxShape, gameBounds, obstacles);
+            bool crowded = crowd && crowd->blockedAhead(crowdIndex, moveDir);
+            if (resolved == nextPos && !crowded) {
+                sprite->setPosition(resolved);
                 distanceWalked += std::sqrt(movement.x * movement.x + movement.y * movement.y);
             }
-            else { distanceWalked = 201.f; }
+            else { distanceWalked = archetype.movement.walk_distance + 1.f; }
 
-            if (distanceWalked >= 200.f) {
+            if (distanceWalked >= archetype.movement.walk_distance) {
                 state = ChubbyState::Idle;
                 stateTimer = 0;
             }
         }
-        updateAnimation(deltaTime);
+        updateAnimation();
         break;
 
     case ChubbyState::Attacking:
@@ -146,11 +180,9 @@ void Chubby::update(float deltaTime, sf::Vector2f playerPos, const sf::FloatRect
         break;
 
     case ChubbyState::Recovering:
-        if (faceDir == FaceDir::Right || faceDir == FaceDir::Left) sprite->setTextureRect({ {306, 26}, {30, 31} });
-        else if (faceDir == FaceDir::Down) sprite->setTextureRect({ {272, 58}, {32, 31} });
-        else if (faceDir == FaceDir::Up)   sprite->setTextureRect({ {272, 90}, {32, 31} });
+        showClip(clipThrow[dirIndex()]);
 
-        if (stateTimer >= 0.25f) {
+        if (stateTimer >= archetype.timing.recover_time) {
             state = ChubbyState::Idle;
             stateTimer = 0;
         }
@@ -158,13 +190,15 @@ void Chubby::update(float deltaTime, sf::Vector2f playerPos, const sf::FloatRect
     }
 
     // Processamento vital dos flashes (Herdado da Base)
-    handleHitFlash();
-    handleHealFlash();
+    handleHitFlash(deltaTime);
+    handleHealFlash(deltaTime);
+    refreshHitbox();
 }
 
 void Chubby::launchBoomerang() {
     boomerangActive = true;
     boomerangReturn = false;
+    boomerangStep = { 0.f, 0.f };
 
     sf::Vector2f spawnPos = sprite->getPosition();
     float visualCenterX = (faceDir == FaceDir::Left) ? -5.f * scaleFactor : 14.f * scaleFactor;
@@ -174,15 +208,9 @@ void Chubby::launchBoomerang() {
     spawnPos.y += 18.f * scaleFactor;
     projectilePos = spawnPos;
 
-    float s = 1000.f;
+    float s = archetype.projectile.speed;
     projectileSprite->setScale({ (faceDir == FaceDir::Left ? -scaleFactor : scaleFactor), scaleFactor });
-
-    if (faceDir == FaceDir::Right || faceDir == FaceDir::Left)
-        projectileSprite->setTextureRect({ {458, 12}, {24, 18} });
-    else if (faceDir == FaceDir::Down)
-        projectileSprite->setTextureRect({ {397, 9}, {18, 24} });
-    else if (faceDir == FaceDir::Up)
-        projectileSprite->setTextureRect({ {397, 41}, {18, 24} });
+    projectileSprite->setTextureRect(frameRect(clipBoomerang[dirIndex()]));
 
     if (faceDir == FaceDir::Right) projectileVel = { s, 0 };
     else if (faceDir == FaceDir::Left) projectileVel = { -s, 0 };
@@ -190,14 +218,16 @@ void Chubby::launchBoomerang() {
     else projectileVel = { 0, s };
 
     projectileSprite->setPosition(projectilePos);
+    boomerangHitbox = makeHitbox(projectilePos, boomerangHitboxShape);
 }
 
 void Chubby::updateBoomerang(float deltaTime) {
+    sf::Vector2f previousPos = projectilePos;
     if (!boomerangReturn) {
         projectilePos += projectileVel * deltaTime;
         float speed = std::sqrt(projectileVel.x * projectileVel.x + projectileVel.y * projectileVel.y);
-        if (speed < 150.f) boomerangReturn = true;
-        else projectileVel -= (projectileVel * 2.2f * deltaTime);
+        if (speed < archetype.projectile.return_threshold) boomerangReturn = true;
+        else projectileVel -= (projectileVel * archetype.projectile.deceleration * deltaTime);
     }
     else {
         sf::Vector2f target = sprite->getPosition();
@@ -209,7 +239,7 @@ void Chubby::updateBoomerang(float deltaTime) {
         sf::Vector2f dir = target - projectilePos;
         float dist = std::sqrt(dir.x * dir.x + dir.y * dir.y);
 
-        if (dist < 65.f) {
+        if (dist < archetype.projectile.catch_distance) {
             projectilePos = target;
             boomerangActive = false;
             projectileSprite->setPosition({ -9999.f, -9999.f });
@@ -218,51 +248,81 @@ void Chubby::updateBoomerang(float deltaTime) {
             return;
         }
 
-        projectileVel = (dir / dist) * 1100.f;
+        projectileVel = (dir / dist) * archetype.projectile.return_speed;
         projectilePos += projectileVel * deltaTime;
 
-        if (faceDir == FaceDir::Right || faceDir == FaceDir::Left)
-            projectileSprite->setTextureRect({ {489, 13}, {27, 17} });
-        else if (faceDir == FaceDir::Down)
-            projectileSprite->setTextureRect({ {428, 10}, {20, 22} });
-        else if (faceDir == FaceDir::Up)
-            projectileSprite->setTextureRect({ {429, 42}, {19, 21} });
+        projectileSprite->setTextureRect(frameRect(clipReturn[dirIndex()]));
     }
+    boomerangStep = projectilePos - previousPos;
     projectileSprite->setPosition(projectilePos);
+    boomerangHitbox = makeHitbox(projectilePos, boomerangHitboxShape);
 }
 
 void Chubby::handleAttackSequence(float deltaTime, sf::Vector2f playerPos) {
-    float curScaleX = (faceDir == FaceDir::Left) ? -scaleFactor : scaleFactor;
-    sprite->setScale({ curScaleX, scaleFactor });
-    sprite->setOrigin({ (faceDir == FaceDir::Left ? 28.f : 0.f), 0.f });
+    applyFacing();
 
-    if (stateTimer < 0.1f) sprite->setTextureRect({ {242, 24}, {28, 32} });
-    else if (stateTimer < 0.2f) {
-        if (faceDir == FaceDir::Right || faceDir == FaceDir::Left) sprite->setTextureRect({ {273, 24}, {30, 33} });
-        else if (faceDir == FaceDir::Down) sprite->setTextureRect({ {241, 56}, {30, 33} });
-        else if (faceDir == FaceDir::Up)   sprite->setTextureRect({ {241, 90}, {30, 33} });
-    }
-    else if (stateTimer < 0.35f) {
-        if (faceDir == FaceDir::Right || faceDir == FaceDir::Left) sprite->setTextureRect({ {306, 26}, {30, 31} });
-        else if (faceDir == FaceDir::Down) sprite->setTextureRect({ {272, 58}, {32, 31} });
-        else if (faceDir == FaceDir::Up)   sprite->setTextureRect({ {272, 90}, {32, 31} });
-    }
+    const ArchetypeTiming& timing = archetype.timing;
+    if (stateTimer < timing.windup_start) showClip(clipIdle);
+    else if (stateTimer < timing.windup_end) showClip(clipWindup[dirIndex()]);
+    else if (stateTimer < timing.throw_time) showClip(clipThrow[dirIndex()]);
     else {
         if (!boomerangActive) launchBoomerang();
     }
 }
 
-void Chubby::updateAnimation(float deltaTime) {
-    animTimer += deltaTime;
-    if (animTimer >= 0.12f) {
-        animTimer = 0;
-        animFrame = (animFrame + 1) % 8;
-    }
-    int row = (animFrame < 4) ? 125 : 157;
-    int col = (animFrame % 4) * 32 + 242;
-    sprite->setTextureRect({ {col, row}, {28, 32} });
+void Chubby::updateAnimation() {
+    // Os frames do clip avancam no passo em lote da sala
+    showClip(clipWalk);
+    applyFacing();
+}
 
+// Virado para a esquerda = sprite espelhado (origem no lado direito do frame)
+void Chubby::applyFacing() {
     float curScaleX = (faceDir == FaceDir::Left) ? -scaleFactor : scaleFactor;
     sprite->setScale({ curScaleX, scaleFactor });
-    sprite->setOrigin({ (faceDir == FaceDir::Left ? 28.f : 0.f), 0.f });
+    sprite->setOrigin({ (faceDir == FaceDir::Left ? static_cast<float>(frameRect(clipIdle).size.x) : 0.f), 0.f });
+}
+
+// timers = { stateTimer, distanceWalked }
+// points = { moveDir, posicao do bumerangue, velocidade do bumerangue, ultimo passo do bumerangue }
+// values = { state, faceDir, boomerangActive, boomerangReturn }
+void Chubby::saveState(EnemyState& saved, std::vector<ProjectileState>& projectiles) const {
+    EnemyBase::saveState(saved, projectiles);
+    const int archetypeIndex = ConfigManager::getInstance().getConfig().archetypes.find(archetype.name);
+    saved.archetype = static_cast<std::uint16_t>(std::max(archetypeIndex, 0));
+    saved.timers[0] = stateTimer;
+    saved.timers[1] = distanceWalked;
+    saved.points[0] = moveDir;
+    saved.points[1] = projectilePos;
+    saved.points[2] = projectileVel;
+    saved.points[3] = boomerangStep;
+    saved.values[0] = static_cast<std::int32_t>(state);
+    saved.values[1] = static_cast<std::int32_t>(faceDir);
+    saved.values[2] = boomerangActive ? 1 : 0;
+    saved.values[3] = boomerangReturn ? 1 : 0;
+}
+
+void Chubby::loadState(const EnemyState& saved, const ProjectileState* projectiles) {
+    EnemyBase::loadState(saved, projectiles);
+    stateTimer = saved.timers[0];
+    distanceWalked = saved.timers[1];
+    moveDir = saved.points[0];
+    projectilePos = saved.points[1];
+    projectileVel = saved.points[2];
+    boomerangStep = saved.points[3];
+    state = static_cast<ChubbyState>(std::clamp(saved.values[0], 0, static_cast<int>(ChubbyState::Recovering)));
+    faceDir = static_cast<FaceDir>(std::clamp(saved.values[1], 0, static_cast<int>(FaceDir::Right)));
+    boomerangActive = saved.values[2] != 0;
+    boomerangReturn = saved.values[3] != 0;
+    applyFacing();
+
+    if (boomerangActive) {
+        projectileSprite->setScale({ (faceDir == FaceDir::Left ? -scaleFactor : scaleFactor), scaleFactor });
+        projectileSprite->setTextureRect(frameRect(boomerangReturn ? clipReturn[dirIndex()] : clipBoomerang[dirIndex()]));
+        projectileSprite->setPosition(projectilePos);
+        boomerangHitbox = makeHitbox(projectilePos, boomerangHitboxShape);
+    }
+    else {
+        projectileSprite->setPosition({ -9999.f, -9999.f });
+    }
 }
\ No newline at end of file
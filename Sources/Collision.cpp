@@ -0,0 +1,248 @@
+#include "Collision.hpp"
+#include <limits>
+#include <algorithm>
+
+#if defined(__AVX__)
+#define COLLISION_USE_AVX 1
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define COLLISION_USE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace {
+    // Largura do bloco usado no padding (serve tanto para AVX como para SSE)
+    constexpr std::size_t kLane = 8;
+    constexpr float kInf = std::numeric_limits<float>::infinity();
+
+    inline int lowestBit(unsigned int bits) {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward(&index, bits);
+        return static_cast<int>(index);
+#else
+        return __builtin_ctz(bits);
+#endif
+    }
+
+    // Devolve os bits de colisao do bloco que comeca em 'i' (bit n = retangulo i + n)
+    inline unsigned int blockBits(const sf::FloatRect& r, const RectBatch& b, std::size_t i) {
+        const float rMinX = r.position.x;
+        const float rMinY = r.position.y;
+        const float rMaxX = r.position.x + r.size.x;
+        const float rMaxY = r.position.y + r.size.y;
+
+#if defined(COLLISION_USE_AVX)
+        __m256 ox = _mm256_and_ps(
+            _mm256_cmp_ps(_mm256_set1_ps(rMinX), _mm256_loadu_ps(b.maxXData() + i), _CMP_LT_OQ),
+            _mm256_cmp_ps(_mm256_set1_ps(rMaxX), _mm256_loadu_ps(b.minXData() + i), _CMP_GT_OQ));
+        __m256 oy = _mm256_and_ps(
+            _mm256_cmp_ps(_mm256_set1_ps(rMinY), _mm256_loadu_ps(b.maxYData() + i), _CMP_LT_OQ),
+            _mm256_cmp_ps(_mm256_set1_ps(rMaxY), _mm256_loadu_ps(b.minYData() + i), _CMP_GT_OQ));
+        return static_cast<unsigned int>(_mm256_movemask_ps(_mm256_and_ps(ox, oy)));
+#elif defined(COLLISION_USE_SSE2)
+        const __m128 minX = _mm_set1_ps(rMinX), maxX = _mm_set1_ps(rMaxX);
+        const __m128 minY = _mm_set1_ps(rMinY), maxY = _mm_set1_ps(rMaxY);
+        unsigned int bits = 0;
+        for (std::size_t half = 0; half < kLane; half += 4) {
+            __m128 ox = _mm_and_ps(_mm_cmplt_ps(minX, _mm_loadu_ps(b.maxXData() + i + half)),
+                _mm_cmpgt_ps(maxX, _mm_loadu_ps(b.minXData() + i + half)));
+            __m128 oy = _mm_and_ps(_mm_cmplt_ps(minY, _mm_loadu_ps(b.maxYData() + i + half)),
+                _mm_cmpgt_ps(maxY, _mm_loadu_ps(b.minYData() + i + half)));
+            bits |= static_cast<unsigned int>(_mm_movemask_ps(_mm_and_ps(ox, oy))) << half;
+        }
+        return bits;
+#else
+        unsigned int bits = 0;
+        for (std::size_t n = 0; n < kLane; ++n) {
+            bool hit = rMinX < b.maxXData()[i + n] && rMaxX > b.minXData()[i + n] &&
+                rMinY < b.maxYData()[i + n] && rMaxY > b.minYData()[i + n];
+            bits |= static_cast<unsigned int>(hit) << n;
+        }
+        return bits;
+#endif
+    }
+}
+
+// --- RectBatch ---
+
+void RectBatch::clear() {
+    minX.clear(); minY.clear(); maxX.clear(); maxY.clear();
+    count = 0;
+}
+
+void RectBatch::reserve(std::size_t n) {
+    std::size_t padded = (n + kLane - 1) / kLane * kLane;
+    minX.reserve(padded); minY.reserve(padded);
+    maxX.reserve(padded); maxY.reserve(padded);
+}
+
+void RectBatch::pad() {
+    // Retangulo "vazio": min = +inf e max = -inf nunca passa nas comparacoes
+    minX.resize(minX.size() + kLane, kInf);
+    minY.resize(minY.size() + kLane, kInf);
+    maxX.resize(maxX.size() + kLane, -kInf);
+    maxY.resize(maxY.size() + kLane, -kInf);
+}
+
+void RectBatch::push(const sf::FloatRect& rect) {
+    if (count == minX.size()) pad();
+    minX[count] = rect.position.x;
+    minY[count] = rect.position.y;
+    maxX[count] = rect.position.x + rect.size.x;
+    maxY[count] = rect.position.y + rect.size.y;
+    ++count;
+}
+
+sf::FloatRect RectBatch::get(std::size_t index) const {
+    return sf::FloatRect({ minX[index], minY[index] },
+        { maxX[index] - minX[index], maxY[index] - minY[index] });
+}
+
+void RectBatch::disable(std::size_t index) {
+    if (index >= count) return;
+    minX[index] = kInf; minY[index] = kInf;
+    maxX[index] = -kInf; maxY[index] = -kInf;
+}
+
+// --- Hitboxes ---
+
+sf::FloatRect makeHitbox(sf::Vector2f position, const HitboxConfig& shape) {
+    return sf::FloatRect(
+        { position.x + shape.offset_x - shape.width / 2.f, position.y + shape.offset_y - shape.height / 2.f },
+        { shape.width, shape.height });
+}
+
+sf::Vector2f clampToBounds(sf::Vector2f position, const HitboxConfig& shape, const sf::FloatRect& bounds) {
+    float minX = bounds.position.x + shape.width / 2.f - shape.offset_x;
+    float maxX = bounds.position.x + bounds.size.x - shape.width / 2.f - shape.offset_x;
+    float minY = bounds.position.y + shape.height / 2.f - shape.offset_y;
+    float maxY = bounds.position.y + bounds.size.y - shape.height / 2.f - shape.offset_y;
+    position.x = std::min(std::max(position.x, minX), maxX);
+    position.y = std::min(std::max(position.y, minY), maxY);
+    return position;
+}
+
+// --- Kernels ---
+
+std::size_t collisionMask(const sf::FloatRect& rect, const RectBatch& batch, std::vector<std::uint8_t>& mask) {
+    mask.assign(batch.size(), 0);
+    std::size_t hits = 0;
+    for (std::size_t i = 0; i < batch.size(); i += kLane) {
+        unsigned int bits = blockBits(rect, batch, i);
+        while (bits) {
+            std::size_t index = i + lowestBit(bits);
+            bits &= bits - 1;
+            if (index >= batch.size()) break;
+            mask[index] = 1;
+            ++hits;
+        }
+    }
+    return hits;
+}
+
+int firstCollision(const sf::FloatRect& rect, const RectBatch& batch) {
+    for (std::size_t i = 0; i < batch.size(); i += kLane) {
+        unsigned int bits = blockBits(rect, batch, i);
+        if (bits) {
+            std::size_t index = i + lowestBit(bits);
+            return index < batch.size() ? static_cast<int>(index) : -1;
+        }
+    }
+    return -1;
+}
+
+void firstCollisions(const RectBatch& a, const RectBatch& b, std::vector<int>& firstHit) {
+    firstHit.assign(a.size(), -1);
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        sf::FloatRect r({ a.minXData()[i], a.minYData()[i] },
+            { a.maxXData()[i] - a.minXData()[i], a.maxYData()[i] - a.minYData()[i] });
+        firstHit[i] = firstCollision(r, b);
+    }
+}
+
+// --- Colisao continua ---
+
+bool sweptCollision(const sf::FloatRect& rect, sf::Vector2f motion, const sf::FloatRect& target, float& timeOfImpact) {
+    // Soma de Minkowski: o alvo cresce pelo tamanho de 'rect' e 'rect' passa a ser um ponto
+    const float start[2] = { rect.position.x, rect.position.y };
+    const float delta[2] = { motion.x, motion.y };
+    const float lo[2] = { target.position.x - rect.size.x, target.position.y - rect.size.y };
+    const float hi[2] = { target.position.x + target.size.x, target.position.y + target.size.y };
+
+    float tEnter = -std::numeric_limits<float>::infinity();
+    float tExit = std::numeric_limits<float>::infinity();
+
+    for (int axis = 0; axis < 2; ++axis) {
+        if (delta[axis] == 0.f) {
+            // Sem movimento neste eixo: tem de estar estritamente dentro da faixa
+            if (start[axis] <= lo[axis] || start[axis] >= hi[axis]) return false;
+            continue;
+        }
+        float t1 = (lo[axis] - start[axis]) / delta[axis];
+        float t2 = (hi[axis] - start[axis]) / delta[axis];
+        if (t1 > t2) std::swap(t1, t2);
+        tEnter = std::max(tEnter, t1);
+        tExit = std::min(tExit, t2);
+    }
+
+    // Contacto de raspao (tEnter == tExit) nao conta, tal como no checkCollision
+    if (tEnter >= tExit || tExit <= 0.f || tEnter > 1.f) return false;
+    timeOfImpact = std::max(0.f, tEnter);
+    return true;
+}
+
+sf::FloatRect sweptBounds(const sf::FloatRect& rect, sf::Vector2f motion) {
+    float minX = std::min(rect.position.x, rect.position.x + motion.x);
+    float minY = std::min(rect.position.y, rect.position.y + motion.y);
+    float maxX = std::max(rect.position.x, rect.position.x + motion.x) + rect.size.x;
+    float maxY = std::max(rect.position.y, rect.position.y + motion.y) + rect.size.y;
+    return sf::FloatRect({ minX, minY }, { maxX - minX, maxY - minY });
+}
+
+int firstSweptCollision(const sf::FloatRect& rect, sf::Vector2f motion, const RectBatch& batch, std::vector<std::uint8_t>& scratch) {
+    if (motion.x == 0.f && motion.y == 0.f) return firstCollision(rect, batch);
+
+    // Broad phase em SIMD com a caixa do varrimento; narrow phase so nos candidatos
+    if (collisionMask(sweptBounds(rect, motion), batch, scratch) == 0) return -1;
+
+    int best = -1;
+    float bestTime = 2.f;
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        if (!scratch[i]) continue;
+        float t;
+        if (sweptCollision(rect, motion, batch.get(i), t) && t < bestTime) {
+            bestTime = t;
+            best = static_cast<int>(i);
+        }
+    }
+    return best;
+}
+
+std::size_t collisionMaskScalar(const sf::FloatRect& rect, const RectBatch& batch, std::vector<std::uint8_t>& mask) {
+    mask.assign(batch.size(), 0);
+    std::size_t hits = 0;
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        sf::FloatRect other({ batch.minXData()[i], batch.minYData()[i] },
+            { batch.maxXData()[i] - batch.minXData()[i], batch.maxYData()[i] - batch.minYData()[i] });
+        if (checkCollision(rect, other)) {
+            mask[i] = 1;
+            ++hits;
+        }
+    }
+    return hits;
+}
+
+const char* collisionBackendName() {
+#if defined(COLLISION_USE_AVX)
+    return "AVX";
+#elif defined(COLLISION_USE_SSE2)
+    return "SSE2";
+#else
+    return "Scalar";
+#endif
+}
@@ -0,0 +1,103 @@
+#include "CrowdSteering.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    inline float lengthOf(sf::Vector2f v) { return std::sqrt(v.x * v.x + v.y * v.y); }
+}
+
+void CrowdSteering::configure(const SteeringConfig& config) {
+    settings = config;
+}
+
+void CrowdSteering::begin(const sf::FloatRect& bounds, const ObstacleGrid* obstacles) {
+    area = bounds;
+    walls = obstacles;
+    positions.clear();
+    radii.clear();
+    maxRadius = 0.f;
+}
+
+int CrowdSteering::add(sf::Vector2f position, float radius) {
+    positions.push_back(position);
+    radii.push_back(radius);
+    maxRadius = std::max(maxRadius, radius);
+    return static_cast<int>(positions.size()) - 1;
+}
+
+void CrowdSteering::finish() {
+    hash.build(positions, settings.cell_size);
+}
+
+template <typename Fn>
+void CrowdSteering::forEachNeighbor(int agent, Fn&& fn) const {
+    const sf::Vector2f self = positions[agent];
+    const float selfRadius = radii[agent];
+    int found = 0;
+    hash.query(self, (selfRadius + maxRadius) * settings.separation_scale, [&](std::uint32_t other) {
+        if (found >= settings.max_neighbors || static_cast<int>(other) == agent) return;
+        const float range = (selfRadius + radii[other]) * settings.separation_scale;
+        const sf::Vector2f offset = self - positions[other];
+        const float distanceSq = offset.x * offset.x + offset.y * offset.y;
+        if (distanceSq >= range * range) return;
+        ++found;
+        fn(static_cast<int>(other), offset, std::sqrt(distanceSq), range);
+        });
+}
+
+sf::Vector2f CrowdSteering::separation(int agent) const {
+    if (agent < 0 || agent >= static_cast<int>(positions.size())) return { 0.f, 0.f };
+    sf::Vector2f push(0.f, 0.f);
+    forEachNeighbor(agent, [&](int other, sf::Vector2f offset, float distance, float range) {
+        const float strength = 1.f - distance / range;
+        if (distance > 0.001f) push += offset / distance * strength;
+        // Em cima um do outro: desempata pelo indice para se afastarem em sentidos opostos
+        else push.x += agent < other ? strength : -strength;
+        });
+    return push;
+}
+
+float CrowdSteering::arrival(float distance) const {
+    const float span = settings.slowing_radius - settings.arrival_radius;
+    if (span <= 0.f) return distance > settings.arrival_radius ? 1.f : 0.f;
+    return std::clamp((distance - settings.arrival_radius) / span, 0.f, 1.f);
+}
+
+sf::Vector2f CrowdSteering::avoidWalls(int agent, sf::Vector2f heading) const {
+    const float speed = lengthOf(heading);
+    if (agent < 0 || agent >= static_cast<int>(positions.size()) || speed <= 0.f) return { 0.f, 0.f };
+
+    const sf::Vector2f self = positions[agent];
+    const sf::Vector2f forward = heading / speed;
+    const float reach = radii[agent] + settings.wall_probe;
+    auto blocked = [&](sf::Vector2f direction) {
+        sf::Vector2f probe = self + direction * reach;
+        return !area.contains(probe) || (walls && walls->blocksPoint(probe, ObstacleLayer::Movement));
+        };
+    if (!blocked(forward)) return { 0.f, 0.f };
+
+    // Antenas a +-45 graus: vira para o lado livre (esquerda se os dois estiverem livres)
+    const sf::Vector2f side(forward.y, -forward.x);
+    const bool leftFree = !blocked((forward + side) * 0.7071f);
+    const bool rightFree = !blocked((forward - side) * 0.7071f);
+    sf::Vector2f steer = leftFree ? side : (rightFree ? -side : -forward);
+    return steer * speed;
+}
+
+sf::Vector2f CrowdSteering::steer(int agent, sf::Vector2f desired) const {
+    sf::Vector2f velocity = desired
+        + separation(agent) * settings.separation_weight
+        + avoidWalls(agent, desired) * settings.wall_weight;
+    const float speed = lengthOf(velocity);
+    return speed > 1.f ? velocity / speed : velocity;
+}
+
+bool CrowdSteering::blockedAhead(int agent, sf::Vector2f direction) const {
+    if (agent < 0 || agent >= static_cast<int>(positions.size())) return false;
+    bool blocked = false;
+    forEachNeighbor(agent, [&](int, sf::Vector2f offset, float, float) {
+        // offset aponta do vizinho para mim: vizinho a frente = produto escalar negativo
+        if (offset.x * direction.x + offset.y * direction.y < 0.f) blocked = true;
+        });
+    return blocked;
+}
@@ -0,0 +1,256 @@
+#include "DungeonCache.hpp"
+#include "Logger.hpp"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <type_traits>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+    // FNV-1a sobre os bytes de cada campo (floats incluidos: mudar 0.1 na config muda o hash)
+    struct Fingerprint {
+        std::uint32_t value = 2166136261u;
+
+        void bytes(const void* data, std::size_t size) {
+            const auto* p = static_cast<const unsigned char*>(data);
+            for (std::size_t i = 0; i < size; ++i) {
+                value ^= p[i];
+                value *= 16777619u;
+            }
+        }
+
+        template <typename T>
+        void add(const T& field) {
+            static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>, "so campos simples");
+            bytes(&field, sizeof(field));
+        }
+
+        void add(const HitboxConfig& hitbox) {
+            add(hitbox.width);
+            add(hitbox.height);
+            add(hitbox.offset_x);
+            add(hitbox.offset_y);
+        }
+    };
+}
+
+std::uint32_t layoutFingerprint(const GameConfig& config, const DungeonConfig::FloorConfig& floor) {
+    Fingerprint hash;
+    hash.add(kDungeonGeneratorVersion);
+
+    const DungeonConfig& dungeon = config.game.dungeon;
+    hash.add(dungeon.generator_attempts);
+    hash.add(dungeon.min_boss_distance);
+    for (const auto& rule : dungeon.extra_door_chances) {
+        hash.add(rule.is_safe_zone);
+        for (int chance : rule.chances) hash.add(chance);
+    }
+
+    hash.add(floor.min_rooms);
+    hash.add(floor.max_rooms);
+    hash.add(floor.extra_enemies);
+    hash.add(floor.chubby_room_chance);
+
+    // Os rosters dependem dos obstaculos (posicoes livres) e dos arquetipos sorteaveis
+    const ObstacleConfig& obstacles = config.game.obstacles;
+    hash.add(obstacles.enabled);
+    hash.add(obstacles.tile_size);
+    hash.add(obstacles.clusters_min);
+    hash.add(obstacles.clusters_max);
+    hash.add(obstacles.cluster_tiles_max);
+    hash.add(obstacles.pit_chance);
+    hash.add(obstacles.corridor_tiles);
+
+    hash.add(config.game.bounds.left);
+    hash.add(config.game.bounds.top);
+    hash.add(config.game.bounds.width);
+    hash.add(config.game.bounds.height);
+
+    hash.add(config.demon.hitbox);
+    hash.add(config.demon.spawn.start_position_x);
+    hash.add(config.demon.spawn.start_position_y);
+    for (const EnemyArchetype& archetype : config.archetypes.records) {
+        hash.bytes(archetype.name, std::strlen(archetype.name));
+        hash.add(archetype.kind);
+        hash.add(archetype.spawn_weight);
+        hash.add(archetype.hitbox);
+    }
+    return hash.value;
+}
+
+std::string dungeonCachePath(const std::string& directory, int floorIndex, std::uint32_t seed) {
+    return (fs::path(directory) / ("v" + std::to_string(kDungeonGeneratorVersion) + "_f" + std::to_string(floorIndex) +
+        "_" + std::to_string(seed) + ".dng")).string();
+}
+
+void appendLayoutRecords(const DungeonLayout& layout, CachedLayoutCounts& counts, std::vector<char>& out) {
+    counts = {};
+    counts.roomCount = static_cast<std::uint16_t>(layout.rooms.size());
+    counts.doorCount = static_cast<std::uint16_t>(layout.doors.size());
+    counts.spawnCount = static_cast<std::uint16_t>(layout.spawns.size());
+    counts.treasureRoom = static_cast<std::int16_t>(layout.treasureRoom);
+    counts.bossRoom = static_cast<std::int16_t>(layout.bossRoom);
+    counts.bossDistance = static_cast<std::uint8_t>(layout.bossDistance);
+    counts.loops = static_cast<std::uint8_t>(layout.loops);
+    counts.attempts = static_cast<std::uint8_t>(layout.attempts);
+    counts.satisfied = layout.satisfied ? 1 : 0;
+
+    out.reserve(out.size() + layout.rooms.size() * sizeof(CachedRoom) + layout.doors.size() * sizeof(CachedDoor) +
+        layout.spawns.size() * sizeof(CachedSpawn));
+    for (const LayoutRoom& room : layout.rooms) {
+        CachedRoom cached{};
+        cached.x = static_cast<std::int16_t>(room.coord.x);
+        cached.y = static_cast<std::int16_t>(room.coord.y);
+        cached.type = static_cast<std::uint8_t>(room.type);
+        cached.cornerVariant = room.cornerVariant;
+        cached.spawnCount = room.spawnCount;
+        cached.seed = room.seed;
+        appendRecords(out, &cached, 1);
+    }
+    for (const LayoutDoor& door : layout.doors) {
+        CachedDoor cached{};
+        cached.from = door.from;
+        cached.to = door.to;
+        cached.direction = static_cast<std::uint8_t>(door.direction);
+        cached.type = static_cast<std::uint8_t>(door.type);
+        appendRecords(out, &cached, 1);
+    }
+    for (const EnemySpawn& spawn : layout.spawns) {
+        CachedSpawn cached{};
+        cached.kind = static_cast<std::uint8_t>(spawn.kind);
+        cached.archetype = spawn.archetype;
+        cached.x = spawn.position.x;
+        cached.y = spawn.position.y;
+        appendRecords(out, &cached, 1);
+    }
+}
+
+bool readLayoutRecords(const std::vector<char>& data, std::size_t& offset, const CachedLayoutCounts& counts, DungeonLayout& layout) {
+    std::vector<CachedRoom> rooms;
+    std::vector<CachedDoor> doors;
+    std::vector<CachedSpawn> spawns;
+    if (!readRecords(data, offset, counts.roomCount, rooms) || !readRecords(data, offset, counts.doorCount, doors) ||
+        !readRecords(data, offset, counts.spawnCount, spawns)) {
+        return false;
+    }
+
+    std::size_t spawnTotal = 0;
+    for (const CachedRoom& room : rooms) {
+        if (room.type > static_cast<std::uint8_t>(RoomType::Treasure)) return false;
+        spawnTotal += room.spawnCount;
+    }
+    if (rooms.empty() || spawnTotal != spawns.size()) return false;
+    for (const CachedDoor& door : doors) {
+        if (door.from >= rooms.size() || door.to >= rooms.size() || door.direction >= static_cast<std::uint8_t>(DoorDirection::None) ||
+            door.type > static_cast<std::uint8_t>(DoorType::Treasure)) {
+            return false;
+        }
+    }
+    for (const CachedSpawn& spawn : spawns) {
+        if (spawn.kind > static_cast<std::uint8_t>(SpawnKind::Monstro)) return false;
+    }
+
+    layout.clear();
+    layout.rooms.reserve(rooms.size());
+    std::uint16_t spawnBegin = 0;
+    for (const CachedRoom& cached : rooms) {
+        LayoutRoom room;
+        room.coord = { cached.x, cached.y };
+        room.type = static_cast<RoomType>(cached.type);
+        room.cornerVariant = cached.cornerVariant;
+        room.seed = cached.seed;
+        room.spawnBegin = spawnBegin;
+        room.spawnCount = cached.spawnCount;
+        spawnBegin = static_cast<std::uint16_t>(spawnBegin + cached.spawnCount);
+        layout.rooms.push_back(room);
+    }
+    layout.doors.reserve(doors.size());
+    for (const CachedDoor& cached : doors) {
+        LayoutDoor door;
+        door.from = cached.from;
+        door.to = cached.to;
+        door.direction = static_cast<DoorDirection>(cached.direction);
+        door.type = static_cast<DoorType>(cached.type);
+        layout.doors.push_back(door);
+    }
+    layout.spawns.reserve(spawns.size());
+    for (const CachedSpawn& cached : spawns) {
+        EnemySpawn spawn;
+        spawn.kind = static_cast<SpawnKind>(cached.kind);
+        spawn.archetype = cached.archetype;
+        spawn.position = { cached.x, cached.y };
+        layout.spawns.push_back(spawn);
+    }
+    layout.treasureRoom = counts.treasureRoom;
+    layout.bossRoom = counts.bossRoom;
+    layout.bossDistance = counts.bossDistance;
+    layout.loops = counts.loops;
+    layout.attempts = counts.attempts;
+    layout.satisfied = counts.satisfied != 0;
+    return true;
+}
+
+bool loadCachedLayout(const std::string& path, int floorIndex, std::uint32_t seed, std::uint32_t fingerprint, DungeonLayout& layout) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) return false;
+    std::vector<char> data(static_cast<std::size_t>(in.tellg()));
+    in.seekg(0);
+    if (!in.read(data.data(), static_cast<std::streamsize>(data.size()))) return false;
+
+    if (data.size() < sizeof(DungeonCacheHeader)) return false;
+    DungeonCacheHeader header;
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (std::memcmp(header.magic, kDungeonCacheMagic, sizeof(header.magic)) != 0 || header.format != kDungeonCacheFormat ||
+        header.generatorVersion != kDungeonGeneratorVersion || header.fingerprint != fingerprint ||
+        header.seed != seed || header.floorIndex != floorIndex) {
+        return false;
+    }
+
+    std::size_t offset = sizeof(header);
+    if (!readLayoutRecords(data, offset, header.layout, layout)) {
+        LOG_WARN(LogCategory::Rooms, "planta em cache invalida: ", path);
+        return false;
+    }
+    return true;
+}
+
+bool saveCachedLayout(const std::string& path, int floorIndex, std::uint32_t seed, std::uint32_t fingerprint, const DungeonLayout& layout) {
+    std::error_code error;
+    const fs::path parent = fs::path(path).parent_path();
+    if (!parent.empty()) fs::create_directories(parent, error);
+
+    DungeonCacheHeader header{};
+    std::memcpy(header.magic, kDungeonCacheMagic, sizeof(header.magic));
+    header.format = kDungeonCacheFormat;
+    header.generatorVersion = kDungeonGeneratorVersion;
+    header.fingerprint = fingerprint;
+    header.seed = seed;
+    header.floorIndex = floorIndex;
+
+    std::vector<char> data(sizeof(header));
+    appendLayoutRecords(layout, header.layout, data);
+    std::memcpy(data.data(), &header, sizeof(header));
+    return writeFileAtomically(path, data);
+}
+
+bool writeFileAtomically(const std::string& path, const std::vector<char>& data) {
+    // Escreve num temporario e troca: quem le nunca apanha um ficheiro a meio
+    std::error_code error;
+    const std::string temporary = path + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out || !out.write(data.data(), static_cast<std::streamsize>(data.size()))) {
+            LOG_WARN(LogCategory::General, "nao foi possivel escrever '", temporary, "'");
+            return false;
+        }
+    }
+    fs::rename(temporary, path, error);
+    if (error) {
+        LOG_WARN(LogCategory::General, "nao foi possivel escrever '", path, "': ", error.message());
+        fs::remove(temporary, error);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,236 @@
+#include "DungeonGenerator.hpp"
+#include <algorithm>
+
+namespace {
+    constexpr int kFreeCell = -1;
+    constexpr int kOutside = -2;
+
+    constexpr DoorDirection kDirections[4] = { DoorDirection::North, DoorDirection::South, DoorDirection::East, DoorDirection::West };
+
+    sf::Vector2i step(DoorDirection direction) {
+        switch (direction) {
+        case DoorDirection::North: return { 0, -1 };
+        case DoorDirection::South: return { 0, 1 };
+        case DoorDirection::East:  return { 1, 0 };
+        case DoorDirection::West:  return { -1, 0 };
+        default:                   return { 0, 0 };
+        }
+    }
+
+    DoorDirection opposite(DoorDirection direction) {
+        switch (direction) {
+        case DoorDirection::North: return DoorDirection::South;
+        case DoorDirection::South: return DoorDirection::North;
+        case DoorDirection::East:  return DoorDirection::West;
+        case DoorDirection::West:  return DoorDirection::East;
+        default:                   return DoorDirection::None;
+        }
+    }
+
+    std::uint8_t bit(DoorDirection direction) {
+        return static_cast<std::uint8_t>(1u << static_cast<unsigned>(direction));
+    }
+}
+
+void DungeonLayout::clear() {
+    rooms.clear();
+    doors.clear();
+    spawns.clear();
+    treasureRoom = -1;
+    bossRoom = -1;
+    bossDistance = 0;
+    loops = 0;
+    satisfied = false;
+}
+
+bool DungeonGenerator::generate(const DungeonConfig& dungeon, const DungeonConfig::FloorConfig& floor,
+    std::uint32_t seed, DungeonLayout& layout) {
+    rng.seed(seed);
+    // Sala inicial + pelo menos uma normal + Tesouro + Boss
+    const int minRooms = std::max(4, floor.min_rooms);
+    const int roomCount = std::uniform_int_distribution<int>(minRooms, std::max(minRooms, floor.max_rooms))(rng);
+
+    const int budget = std::max(1, dungeon.generator_attempts);
+    int attempts = 0;
+    bool satisfied = false;
+    while (attempts < budget && !satisfied) {
+        ++attempts;
+        satisfied = attempt(dungeon, roomCount, false, layout);
+    }
+    if (!satisfied) attempt(dungeon, roomCount, true, layout);
+    layout.attempts = attempts;
+    layout.satisfied = satisfied;
+
+    // Visual e seeds de cada sala, ja com a planta final
+    for (LayoutRoom& room : layout.rooms) {
+        room.cornerVariant = static_cast<std::uint8_t>(std::uniform_int_distribution<int>(0, 2)(rng));
+        room.seed = static_cast<std::uint32_t>(rng());
+    }
+    return satisfied;
+}
+
+bool DungeonGenerator::attempt(const DungeonConfig& dungeon, int roomCount, bool relaxed, DungeonLayout& layout) {
+    layout.clear();
+    gridSide = roomCount * 2 + 3;
+    cells.assign(static_cast<std::size_t>(gridSide) * gridSide, kFreeCell);
+    doorMasks.clear();
+    openRooms.clear();
+
+    // Corpo: arvore que cresce a partir de salas ao acaso; uma sala sem vizinhas
+    // livres sai da lista em O(1) (troca com a ultima)
+    const int bodyCount = roomCount - 2;
+    openRooms.push_back(addRoom(layout, { 0, 0 }, RoomType::SafeZone));
+    while (static_cast<int>(layout.rooms.size()) < bodyCount) {
+        if (openRooms.empty()) return false;
+        const std::size_t pick = std::uniform_int_distribution<std::size_t>(0, openRooms.size() - 1)(rng);
+        const int parent = openRooms[pick];
+        const sf::Vector2i parentCoord = layout.rooms[parent].coord;
+
+        DoorDirection free[4];
+        int freeCount = 0;
+        for (DoorDirection direction : kDirections) {
+            if (cellAt(parentCoord + step(direction)) == kFreeCell) free[freeCount++] = direction;
+        }
+        if (freeCount == 0) {
+            openRooms[pick] = openRooms.back();
+            openRooms.pop_back();
+            continue;
+        }
+
+        const DoorDirection direction = free[std::uniform_int_distribution<int>(0, freeCount - 1)(rng)];
+        const int room = addRoom(layout, parentCoord + step(direction), RoomType::Normal);
+        addDoor(layout, parent, room, direction, DoorType::Normal);
+        openRooms.push_back(room);
+    }
+
+    // Ciclos antes das salas especiais: as distancias ja contam com os atalhos
+    addLoops(dungeon, layout);
+    computeDistances(layout);
+
+    layout.bossRoom = placeSpecial(layout, RoomType::Boss, true, dungeon.min_boss_distance, relaxed);
+    if (layout.bossRoom < 0) return false;
+    layout.bossDistance = distances[layout.doors.back().from] + 1;
+
+    layout.treasureRoom = placeSpecial(layout, RoomType::Treasure, false, 0, relaxed);
+    return layout.treasureRoom >= 0;
+}
+
+int DungeonGenerator::addRoom(DungeonLayout& layout, sf::Vector2i coord, RoomType type) {
+    const int id = static_cast<int>(layout.rooms.size());
+    LayoutRoom room;
+    room.coord = coord;
+    room.type = type;
+    layout.rooms.push_back(room);
+    doorMasks.push_back(0);
+
+    const int half = gridSide / 2;
+    cells[static_cast<std::size_t>(coord.y + half) * gridSide + (coord.x + half)] = id;
+    return id;
+}
+
+void DungeonGenerator::addDoor(DungeonLayout& layout, int from, int to, DoorDirection direction, DoorType type) {
+    LayoutDoor door;
+    door.from = static_cast<std::uint16_t>(from);
+    door.to = static_cast<std::uint16_t>(to);
+    door.direction = direction;
+    door.type = type;
+    layout.doors.push_back(door);
+    doorMasks[from] |= bit(direction);
+    doorMasks[to] |= bit(opposite(direction));
+}
+
+// chances[k] = probabilidade (%) da (k+1)-esima porta extra da sala; a primeira
+// que falhar acaba com as portas extra dessa sala
+void DungeonGenerator::addLoops(const DungeonConfig& dungeon, DungeonLayout& layout) {
+    const int bodyCount = static_cast<int>(layout.rooms.size());
+    for (int room = 0; room < bodyCount; ++room) {
+        const bool safeZone = layout.rooms[room].type == RoomType::SafeZone;
+        const DungeonConfig::ExtraDoorChance* rule = nullptr;
+        for (const auto& entry : dungeon.extra_door_chances) {
+            if (entry.is_safe_zone == safeZone) { rule = &entry; break; }
+        }
+        if (!rule || rule->chances.empty()) continue;
+
+        DoorDirection order[4] = { kDirections[0], kDirections[1], kDirections[2], kDirections[3] };
+        std::shuffle(std::begin(order), std::end(order), rng);
+
+        std::size_t extra = 0;
+        for (DoorDirection direction : order) {
+            if (extra >= rule->chances.size()) break;
+            if (doorMasks[room] & bit(direction)) continue;
+            // Cada par so e sorteado uma vez (pela sala de id mais baixo)
+            const int neighbour = cellAt(layout.rooms[room].coord + step(direction));
+            if (neighbour <= room) continue;
+
+            if (std::uniform_int_distribution<int>(0, 99)(rng) >= rule->chances[extra]) break;
+            addDoor(layout, room, neighbour, direction, DoorType::Normal);
+            ++layout.loops;
+            ++extra;
+        }
+    }
+}
+
+void DungeonGenerator::computeDistances(const DungeonLayout& layout) {
+    distances.assign(layout.rooms.size(), -1);
+    queue.clear();
+    queue.push_back(0);
+    distances[0] = 0;
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+        const int room = queue[head];
+        for (DoorDirection direction : kDirections) {
+            if (!(doorMasks[room] & bit(direction))) continue;
+            const int neighbour = cellAt(layout.rooms[room].coord + step(direction));
+            if (neighbour < 0 || distances[neighbour] >= 0) continue;
+            distances[neighbour] = distances[room] + 1;
+            queue.push_back(neighbour);
+        }
+    }
+}
+
+// Beco = celula livre cuja unica vizinha ocupada e a sala normal a que liga.
+// Relaxado: qualquer celula livre ao lado de uma sala que nao seja especial.
+int DungeonGenerator::placeSpecial(DungeonLayout& layout, RoomType type, bool farthest, int minDistance, bool relaxed) {
+    candidates.clear();
+    for (int parent = 0; parent < static_cast<int>(layout.rooms.size()); ++parent) {
+        const RoomType parentType = layout.rooms[parent].type;
+        if (parentType == RoomType::Boss || parentType == RoomType::Treasure) continue;
+        if (!relaxed && parentType != RoomType::Normal) continue;
+
+        for (DoorDirection direction : kDirections) {
+            const sf::Vector2i coord = layout.rooms[parent].coord + step(direction);
+            if (cellAt(coord) != kFreeCell) continue;
+            if (!relaxed && occupiedNeighbours(coord) != 1) continue;
+            candidates.push_back({ coord, parent, direction });
+        }
+    }
+    if (candidates.empty()) return -1;
+
+    if (farthest) {
+        int best = -1;
+        for (const Candidate& candidate : candidates) best = std::max(best, distances[candidate.parent]);
+        if (!relaxed && best + 1 < minDistance) return -1;
+        candidates.erase(std::remove_if(candidates.begin(), candidates.end(),
+            [&](const Candidate& candidate) { return distances[candidate.parent] != best; }), candidates.end());
+    }
+
+    const Candidate chosen = candidates[std::uniform_int_distribution<std::size_t>(0, candidates.size() - 1)(rng)];
+    const int room = addRoom(layout, chosen.coord, type);
+    addDoor(layout, chosen.parent, room, chosen.direction, type == RoomType::Boss ? DoorType::Boss : DoorType::Treasure);
+    return room;
+}
+
+int DungeonGenerator::cellAt(sf::Vector2i coord) const {
+    const int half = gridSide / 2;
+    const int x = coord.x + half;
+    const int y = coord.y + half;
+    if (x < 0 || y < 0 || x >= gridSide || y >= gridSide) return kOutside;
+    return cells[static_cast<std::size_t>(y) * gridSide + x];
+}
+
+int DungeonGenerator::occupiedNeighbours(sf::Vector2i coord) const {
+    int count = 0;
+    for (DoorDirection direction : kDirections) {
+        if (cellAt(coord + step(direction)) >= 0) ++count;
+    }
+    return count;
+}
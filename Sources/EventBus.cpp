@@ -0,0 +1,89 @@
+#include "EventBus.hpp"
+#include "Logger.hpp"
+#include <algorithm>
+
+namespace {
+    thread_local EventBus* scopedBus = nullptr;
+}
+
+EventBus& EventBus::getInstance() {
+    if (scopedBus) return *scopedBus;
+    static EventBus instance;
+    return instance;
+}
+
+EventBus::Scope::Scope(EventBus& bus) : previous(scopedBus) {
+    scopedBus = &bus;
+}
+
+EventBus::Scope::~Scope() {
+    scopedBus = previous;
+}
+
+int EventBus::subscribe(std::uint32_t mask, Listener listener) {
+    subscribers.push_back({ nextId, mask, std::move(listener) });
+    return nextId++;
+}
+
+void EventBus::unsubscribe(int id) {
+    subscribers.erase(std::remove_if(subscribers.begin(), subscribers.end(),
+        [id](const Subscriber& s) { return s.id == id; }), subscribers.end());
+}
+
+void EventBus::dispatch() {
+    if (queue.empty()) return;
+
+    // O que os subscritores publicarem durante a entrega fica para o proximo tick
+    delivering.clear();
+    std::swap(delivering, queue);
+
+    std::uint32_t present = 0;
+    for (const auto& e : delivering) present |= eventBit(e.type);
+    for (const auto& s : subscribers) {
+        if (s.mask & present) s.listener(delivering);
+    }
+}
+
+// --- ConsoleEventLog ---
+
+namespace {
+    const char* targetName(const GameEvent& e) {
+        switch (e.target) {
+        case GameEventTarget::Player: return "Isaac";
+        case GameEventTarget::Enemy: return "inimigo";
+        default: return "-";
+        }
+    }
+}
+
+ConsoleEventLog::ConsoleEventLog() {
+    subscription = EventBus::getInstance().subscribe(kAllGameEvents,
+        [this](const std::vector<GameEvent>& events) { write(events); });
+}
+
+ConsoleEventLog::~ConsoleEventLog() {
+    EventBus::getInstance().unsubscribe(subscription);
+}
+
+void ConsoleEventLog::write(const std::vector<GameEvent>& events) {
+    // Categoria Combat: limitada por segundo no logger, nunca segura o frame
+    for (const auto& e : events) {
+        switch (e.type) {
+        case GameEventType::Damage:
+            LOG_INFO(LogCategory::Combat, "Dano: ", targetName(e), " -", e.amount, " (vida ", e.health, ")");
+            break;
+        case GameEventType::Heal:
+            LOG_INFO(LogCategory::Combat, "Cura: ", targetName(e), " +", e.amount, " (vida ", e.health, ")");
+            break;
+        case GameEventType::Death:
+            LOG_INFO(LogCategory::Combat, "Morte: ", targetName(e));
+            break;
+        case GameEventType::ProjectileHit:
+            LOG_DEBUG(LogCategory::Combat, "Projetil acertou: ", targetName(e));
+            break;
+        case GameEventType::RoomClear:
+            LOG_INFO(LogCategory::Rooms, "Sala ", e.roomId, " limpa");
+            break;
+        }
+    }
+}
@@ -0,0 +1,167 @@
+#include "FlowField.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include <utility>
+
+namespace {
+    constexpr int kStraightCost = 10;
+    constexpr int kDiagonalCost = 14;
+    constexpr int kNeighborX[8] = { 1, -1, 0, 0, 1, 1, -1, -1 };
+    constexpr int kNeighborY[8] = { 0, 0, 1, -1, 1, -1, 1, -1 };
+
+    sf::Vector2f unit(sf::Vector2f v) {
+        float length = std::sqrt(v.x * v.x + v.y * v.y);
+        return length > 0.f ? v / length : sf::Vector2f(0.f, 0.f);
+    }
+}
+
+void FlowField::configure(const sf::FloatRect& bounds, float cellSize) {
+    area = bounds;
+    cell = std::max(1.f, cellSize);
+    cols = std::max(1, static_cast<int>(std::ceil(bounds.size.x / cell)));
+    rowCount = std::max(1, static_cast<int>(std::ceil(bounds.size.y / cell)));
+
+    const std::size_t count = static_cast<std::size_t>(cols) * rowCount;
+    blocked.assign(count, 0);
+    cost.assign(count, kUnreachable);
+    flow.assign(count, sf::Vector2f(0.f, 0.f));
+    visible.assign(count, 0);
+    blockedCount = 0;
+    targetCell = -1;
+    dirty = true;
+}
+
+void FlowField::setBlocked(int column, int row, bool isBlocked) {
+    if (column < 0 || row < 0 || column >= cols || row >= rowCount) return;
+    std::uint8_t& b = blocked[static_cast<std::size_t>(row) * cols + column];
+    if (b == static_cast<std::uint8_t>(isBlocked)) return;
+    b = static_cast<std::uint8_t>(isBlocked);
+    blockedCount += isBlocked ? 1 : -1;
+    dirty = true;
+}
+
+void FlowField::clearBlocked() {
+    std::fill(blocked.begin(), blocked.end(), 0);
+    blockedCount = 0;
+    dirty = true;
+}
+
+sf::FloatRect FlowField::cellBounds(int column, int row) const {
+    return sf::FloatRect({ area.position.x + column * cell, area.position.y + row * cell }, { cell, cell });
+}
+
+int FlowField::cellIndex(sf::Vector2f position) const {
+    int column = static_cast<int>((position.x - area.position.x) / cell);
+    int row = static_cast<int>((position.y - area.position.y) / cell);
+    column = std::clamp(column, 0, cols - 1);
+    row = std::clamp(row, 0, rowCount - 1);
+    return row * cols + column;
+}
+
+bool FlowField::cellBlocked(int column, int row) const {
+    if (column < 0 || row < 0 || column >= cols || row >= rowCount) return true;
+    return blocked[static_cast<std::size_t>(row) * cols + column] != 0;
+}
+
+bool FlowField::isBlocked(sf::Vector2f position) const {
+    if (empty() || !area.contains(position)) return false;
+    return blocked[cellIndex(position)] != 0;
+}
+
+bool FlowField::setTarget(sf::Vector2f position) {
+    if (empty()) return false;
+    target = position;
+    int index = cellIndex(position);
+    if (index == targetCell && !dirty) return false;
+    targetCell = index;
+    rebuild();
+    return true;
+}
+
+void FlowField::rebuild() {
+    dirty = false;
+    std::fill(cost.begin(), cost.end(), kUnreachable);
+
+    // Dijkstra a partir do alvo (custos pequenos, grelha de poucas centenas de celulas)
+    using Entry = std::pair<int, int>; // (custo, celula)
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+    cost[targetCell] = 0;
+    open.push({ 0, targetCell });
+
+    while (!open.empty()) {
+        auto [current, index] = open.top();
+        open.pop();
+        if (current > cost[index]) continue;
+        const int cx = index % cols, cy = index / cols;
+
+        for (int n = 0; n < 8; ++n) {
+            const int nx = cx + kNeighborX[n], ny = cy + kNeighborY[n];
+            if (cellBlocked(nx, ny)) continue;
+            const bool diagonal = n >= 4;
+            // Nao corta cantos de celulas bloqueadas
+            if (diagonal && (cellBlocked(cx + kNeighborX[n], cy) || cellBlocked(cx, cy + kNeighborY[n]))) continue;
+
+            const int next = current + (diagonal ? kDiagonalCost : kStraightCost);
+            const int nIndex = ny * cols + nx;
+            if (next < cost[nIndex]) {
+                cost[nIndex] = static_cast<std::uint16_t>(next);
+                open.push({ next, nIndex });
+            }
+        }
+    }
+
+    // Cada celula aponta para a vizinha de menor custo
+    const int tx = targetCell % cols, ty = targetCell / cols;
+    for (int index = 0; index < cols * rowCount; ++index) {
+        flow[index] = { 0.f, 0.f };
+        visible[index] = 0;
+        if (cost[index] == kUnreachable) continue;
+
+        const int cx = index % cols, cy = index / cols;
+        visible[index] = blockedCount == 0 || lineOfSight(cx, cy, tx, ty);
+        if (index == targetCell) continue;
+
+        int best = cost[index];
+        for (int n = 0; n < 8; ++n) {
+            const int nx = cx + kNeighborX[n], ny = cy + kNeighborY[n];
+            if (cellBlocked(nx, ny)) continue;
+            if (n >= 4 && (cellBlocked(cx + kNeighborX[n], cy) || cellBlocked(cx, cy + kNeighborY[n]))) continue;
+            const int nIndex = ny * cols + nx;
+            if (cost[nIndex] < best) {
+                best = cost[nIndex];
+                flow[index] = unit(sf::Vector2f(static_cast<float>(kNeighborX[n]), static_cast<float>(kNeighborY[n])));
+            }
+        }
+    }
+}
+
+bool FlowField::lineOfSight(int x0, int y0, int x1, int y1) const {
+    // Bresenham sobre a grelha; passos na diagonal tambem verificam as duas celulas retas
+    const int dx = std::abs(x1 - x0), dy = -std::abs(y1 - y0);
+    const int sx = x0 < x1 ? 1 : -1, sy = y0 < y1 ? 1 : -1;
+    int err = dx + dy;
+    while (true) {
+        if (cellBlocked(x0, y0)) return false;
+        if (x0 == x1 && y0 == y1) return true;
+        const int e2 = 2 * err;
+        const bool stepX = e2 >= dy, stepY = e2 <= dx;
+        if (stepX && stepY && (cellBlocked(x0 + sx, y0) || cellBlocked(x0, y0 + sy))) return false;
+        if (stepX) { err += dy; x0 += sx; }
+        if (stepY) { err += dx; y0 += sy; }
+    }
+}
+
+sf::Vector2f FlowField::direction(sf::Vector2f position) const {
+    if (empty() || targetCell < 0) return unit(target - position);
+    const int index = cellIndex(position);
+    if (visible[index]) return unit(target - position);
+    return flow[index];
+}
+
+std::uint16_t FlowField::costAt(sf::Vector2f position) const {
+    if (empty()) return kUnreachable;
+    return cost[cellIndex(position)];
+}
@@ -1,37 +1,53 @@
 ﻿#include "Game.hpp"
 #include "Utils.hpp"
 #include "ConfigManager.hpp"
-#include "Chubby.hpp"
-#include "Monstro.hpp"
-#include <iostream>
+#include "JobSystem.hpp"
+#include "BulletPattern.hpp"
+#include "EventBus.hpp"
+#include "Logger.hpp"
+#include "RunSave.hpp"
 #include <cstdlib>
 #include <ctime>
 #include <algorithm>
 
 void Game::loadGameAssets() {
-    assets.loadAnimation("I_Down", "Isaac/Front_Isaac", "F", 9, "V1.png");
-    assets.loadAnimation("I_Up", "Isaac/Back_Isaac", "B", 9, "V1.png");
-    assets.loadAnimation("I_Left", "Isaac/Left_Isaac", "L", 6, "V1.png");
-    assets.loadAnimation("I_Right", "Isaac/Right_Isaac", "R", 6, "V1.png");
-    assets.loadTexture("TearAtlas", "Images/Tears/bulletatlas.png");
-
-    assets.loadAnimation("D_Down", "Demon/Front_Demon", "F", 8, "D.png");
-    assets.loadAnimation("D_Up", "Demon/Back_Demon", "B", 8, "D.png");
-    assets.loadAnimation("D_Left", "Demon/Left_Demon", "L", 8, "D.png");
-    assets.loadAnimation("D_Right", "Demon/Right_Demon", "R", 8, "D.png");
-    assets.loadAnimation("Bishop", "Bishop", "B", 14, ".png");
-
-    assets.loadTexture("ChubbySheet", "Images/Chubby/Chubby.png");
-    assets.loadTexture("Door", "Images/Background/Doors.png");
-    assets.loadTexture("HeartF", "Images/UI/Life/Full.png");
-    assets.loadTexture("HeartH", "Images/UI/Life/Half.png");
-    assets.loadTexture("HeartE", "Images/UI/Life/Empty.png");
-    assets.loadTexture("BasementCorner", "Images/Background/Basement_sheet.png");
-    assets.loadTexture("MonstroSheet", "Images/Monstro(BOSS)/Monstro.png");
+    const auto& config = ConfigManager::getInstance().getConfig();
+    sf::Clock loadClock;
+    if (config.game.assets.use_pack) assets.mountPack(config.game.assets.pack_file);
+    assets.setBudget(static_cast<std::uint64_t>(std::max(config.game.assets.texture_budget_mb, 0)) * 1024 * 1024);
+
+    // O que o Isaac e a UI usam fica sempre residente; o resto e pedido por sala (RoomManager)
+    auto pin = [&](auto handle) { pinnedAssets.emplace_back(assets, handle); };
+
+    // Um so lote: os frames de todas as animacoes descodificam-se em paralelo
+    const std::vector<AnimationHandle> animations = assets.loadAnimations({
+        { AssetIds::IsaacDown, "Isaac/Front_Isaac", "F", 9, "V1.png" },
+        { AssetIds::IsaacUp, "Isaac/Back_Isaac", "B", 9, "V1.png" },
+        { AssetIds::IsaacLeft, "Isaac/Left_Isaac", "L", 6, "V1.png" },
+        { AssetIds::IsaacRight, "Isaac/Right_Isaac", "R", 6, "V1.png" },
+        { AssetIds::DemonDown, "Demon/Front_Demon", "F", 8, "D.png" },
+        { AssetIds::DemonUp, "Demon/Back_Demon", "B", 8, "D.png" },
+        { AssetIds::DemonLeft, "Demon/Left_Demon", "L", 8, "D.png" },
+        { AssetIds::DemonRight, "Demon/Right_Demon", "R", 8, "D.png" },
+        { AssetIds::Bishop, "Bishop", "B", 14, ".png" },
+        });
+    for (std::size_t i = 0; i < 4; ++i) pin(animations[i]);  // As quatro do Isaac
+    pin(assets.loadTexture(AssetIds::TearAtlas, "Images/Tears/bulletatlas.png"));
+
+    assets.loadTexture(AssetIds::ChubbySheet, "Images/Chubby/Chubby.png");
+    pin(assets.loadTexture(AssetIds::Door, "Images/Background/Doors.png"));
+    pin(assets.loadTexture(AssetIds::HeartFull, "Images/UI/Life/Full.png"));
+    pin(assets.loadTexture(AssetIds::HeartHalf, "Images/UI/Life/Half.png"));
+    pin(assets.loadTexture(AssetIds::HeartEmpty, "Images/UI/Life/Empty.png"));
+    pin(assets.loadTexture(AssetIds::BasementCorner, "Images/Background/Basement_sheet.png"));
+    assets.loadTexture(AssetIds::MonstroSheet, "Images/Monstro(BOSS)/Monstro.png");
+
+    LOG_INFO(LogCategory::Assets, "assets carregados em ", loadClock.getElapsedTime().asSeconds() * 1000.f, " ms (",
+        assets.texturesFromPack(), " do pack, ", assets.texturesFromFiles(), " de ficheiros soltos)");
 }
 
 void Game::updateRoomVisuals() {
-    Room* curr = roomManager->getCurrentRoom();
+    Room* curr = simulation->rooms().getCurrentRoom();
     if (!curr) return;
 
     sf::IntRect savedRect = curr->getCornerTextureRect();
@@ -47,7 +63,7 @@ void Game::updateRoomVisuals() {
         bossIntroBackground.setSize({ 1920.f, 1080.f });
         bossIntroBackground.setFillColor(sf::Color::Black);
 
-        bossNameSprite.emplace(assets.getTexture("MonstroSheet"));
+        bossNameSprite.emplace(assets.get(bossTitleTexture));
         bossNameSprite->setTextureRect(sf::IntRect({ 173, 237 }, { 149, 45 }));
         bossNameSprite->setOrigin({ 149 / 2.f, 45 / 2.f });
         bossNameSprite->setPosition({ 1920 / 2.f, 1080 / 2.f });
@@ -63,33 +79,28 @@ Game::Game()
     bossTitleTimer(0.f)
 {
     try { ConfigManager::getInstance().loadConfig("config.json"); }
-    catch (const std::exception& e) { std::cerr << "Config Error: " << e.what() << std::endl; }
+    catch (const std::exception& e) { LOG_ERROR(LogCategory::Config, "falha ao carregar a config: ", e.what()); }
 
     const auto& config = ConfigManager::getInstance().getConfig();
+    Logger::getInstance().start(config.game.logging);
     std::srand(static_cast<unsigned>(std::time(NULL)));
+    JobSystem::getInstance().start(config.game.parallel.worker_threads);
+    BulletPatternLibrary::getInstance().build(config.bullet_patterns);
+    if (config.game.events.console_log) eventLog.emplace();
 
     loadGameAssets();
+    bossTitleTexture = assets.findTexture(AssetIds::MonstroSheet);
 
-    Isaac.emplace(assets.getAnimationSet("I_Down"), assets.getTexture("TearAtlas"),
-        assets.getAnimationSet("I_Up"), assets.getAnimationSet("I_Left"),
-        assets.getAnimationSet("I_Right"));
-
-    if (Isaac) {
-        const auto& projConfig = config.projectile_textures.isaac_tear;
-        Isaac->setProjectileTextureRect(sf::IntRect(sf::Vector2i(projConfig.x, projConfig.y), sf::Vector2i(projConfig.width, projConfig.height)));
-        Isaac->setPosition({ (float)config.game.window_width / 2.f, (float)config.game.window_height / 2.f });
-    }
-
-    heartSpriteF.emplace(assets.getTexture("HeartF"));
-    heartSpriteH.emplace(assets.getTexture("HeartH"));
-    heartSpriteE.emplace(assets.getTexture("HeartE"));
+    heartSpriteF.emplace(assets.getTexture(AssetIds::HeartFull));
+    heartSpriteH.emplace(assets.getTexture(AssetIds::HeartHalf));
+    heartSpriteE.emplace(assets.getTexture(AssetIds::HeartEmpty));
 
     setupMenu();
 
-    cornerTL.emplace(assets.getTexture("BasementCorner"));
-    cornerTR.emplace(assets.getTexture("BasementCorner"));
-    cornerBL.emplace(assets.getTexture("BasementCorner"));
-    cornerBR.emplace(assets.getTexture("BasementCorner"));
+    cornerTL.emplace(assets.getTexture(AssetIds::BasementCorner));
+    cornerTR.emplace(assets.getTexture(AssetIds::BasementCorner));
+    cornerBL.emplace(assets.getTexture(AssetIds::BasementCorner));
+    cornerBR.emplace(assets.getTexture(AssetIds::BasementCorner));
 
     float scaleX = (float)config.game.window_width / 2.f / (float)config.corners.option_a.width;
     float scaleY = (float)config.game.window_height / 2.f / (float)config.corners.option_a.height;
@@ -99,11 +110,16 @@ Game::Game()
     cornerBL->setPosition({ 0, (float)config.game.window_height }); cornerBL->setScale({ scaleX, -scaleY });
     cornerBR->setPosition({ (float)config.game.window_width, (float)config.game.window_height }); cornerBR->setScale({ -scaleX, -scaleY });
 
-    gameBounds = sf::FloatRect({ (float)config.game.bounds.left, (float)config.game.bounds.top }, { (float)config.game.bounds.width, (float)config.game.bounds.height });
-    roomManager.emplace(assets, gameBounds);
+    PlayerTextures isaacTextures;
+    isaacTextures.walkDown = &assets.getAnimationSet(AssetIds::IsaacDown);
+    isaacTextures.walkUp = &assets.getAnimationSet(AssetIds::IsaacUp);
+    isaacTextures.walkLeft = &assets.getAnimationSet(AssetIds::IsaacLeft);
+    isaacTextures.walkRight = &assets.getAnimationSet(AssetIds::IsaacRight);
+    isaacTextures.tears = &assets.getTexture(AssetIds::TearAtlas);
 
-    int numRooms = config.game.dungeon.min_rooms + (std::rand() % (config.game.dungeon.max_rooms - config.game.dungeon.min_rooms + 1));
-    roomManager->generateDungeon(numRooms);
+    sf::FloatRect gameBounds({ (float)config.game.bounds.left, (float)config.game.bounds.top }, { (float)config.game.bounds.width, (float)config.game.bounds.height });
+    simulation.emplace(assets, isaacTextures, gameBounds);
+    simulation->newRun();
 
     updateRoomVisuals();
 }
@@ -116,6 +132,7 @@ void Game::run() {
         if (currentState == GameState::menu) {
             if (playButton && isMouseOver(*playButton) && sf::Mouse::isButtonPressed(sf::Mouse::Button::Left)) {
                 currentState = GameState::playing;
+                if (ConfigManager::getInstance().getConfig().game.save.resume) resumeRun();
             }
             window.clear();
             if (menuGround) window.draw(*menuGround);
@@ -131,7 +148,7 @@ void Game::run() {
 }
 
 void Game::update(float deltaTime) {
-    if (!Isaac || !roomManager) return;
+    if (!simulation) return;
 
     if (showBossTitle) {
         bossTitleTimer += deltaTime;
@@ -139,129 +156,52 @@ void Game::update(float deltaTime) {
         else return;
     }
 
-    const auto& config = ConfigManager::getInstance().getConfig();
-    sf::Vector2f playerPosition = Isaac->getPosition();
-
-    if (roomManager->isTransitioning()) {
-        Room* roomBefore = roomManager->getCurrentRoom();
-        roomManager->updateTransition(deltaTime, playerPosition);
-        Isaac->setPosition(playerPosition);
-        Isaac->setSpeedMultiplier(0.f);
-        if (roomManager->getCurrentRoom() != roomBefore) updateRoomVisuals();
-        return;
-    }
+    Room* roomBefore = simulation->rooms().getCurrentRoom();
+    simulation->update(deltaTime);
+    if (simulation->rooms().getCurrentRoom() != roomBefore) updateRoomVisuals();
 
-    Isaac->setSpeedMultiplier(1.f);
-    Isaac->update(deltaTime, gameBounds);
-    roomManager->update(deltaTime, Isaac->getPosition());
-
-    DoorDirection doorHit = roomManager->checkPlayerAtDoor(Isaac->getGlobalBounds());
-    if (doorHit != DoorDirection::None) {
-        roomManager->requestTransition(doorHit);
-        return;
+    if (simulation->isOver()) {
+        // Run perdida: o save nao pode trazer o Isaac de volta
+        deleteRunSnapshot(ConfigManager::getInstance().getConfig().game.save.file);
+        window.close();
     }
+}
 
-    Room* currentRoom = roomManager->getCurrentRoom();
-    if (currentRoom) {
-        auto& isaacProjectiles = Isaac->getProjectiles();
-        auto& demons = currentRoom->getDemons();
-        auto& bishops = currentRoom->getBishops();
-        auto& chubbies = currentRoom->getChubbies();
-        auto& monstros = currentRoom->getMonstros();
-
-        sf::FloatRect isaacBounds = Isaac->getGlobalBounds();
-
-        // --- LÓGICA DE CURA DO BISHOP ---
-        for (auto& b : bishops) {
-            if (b->getHealth() > 0 && b->shouldHealDemon()) {
-                // Cura Demons
-                for (auto& d : demons) {
-                    if (d->getHealth() > 0) d->heal(4);
-                }
-                // Cura Chubbies
-                for (auto& c : chubbies) {
-                    if (c->getHealth() > 0) c->heal(4);
-                }
-                b->resetHealFlag();
-            }
-        }
-
-        // Colisões Isaac -> Inimigos
-        for (auto itTear = isaacProjectiles.begin(); itTear != isaacProjectiles.end();) {
-            bool hit = false;
-            sf::FloatRect tearBounds = itTear->sprite.getGlobalBounds();
-
-            for (auto& m : monstros) {
-                if (m->getHealth() > 0 && checkCollision(tearBounds, m->getGlobalBounds())) {
-                    m->takeDamage(config.player.stats.damage); hit = true; break;
-                }
-            }
-            if (!hit) {
-                for (auto& d : demons) {
-                    if (d->getHealth() > 0 && checkCollision(tearBounds, d->getGlobalBounds())) {
-                        d->takeDamage(config.player.stats.damage); hit = true; break;
-                    }
-                }
-            }
-            if (!hit) {
-                for (auto& b : bishops) {
-                    if (b->getHealth() > 0 && checkCollision(tearBounds, b->getGlobalBounds())) {
-                        b->takeDamage(config.player.stats.damage); hit = true; break;
-                    }
-                }
-            }
-            if (!hit) {
-                for (auto& c : chubbies) {
-                    if (c->getHealth() > 0 && checkCollision(tearBounds, c->getGlobalBounds())) {
-                        c->takeDamage(config.player.stats.damage); hit = true; break;
-                    }
-                }
-            }
-
-            if (hit) itTear = isaacProjectiles.erase(itTear);
-            else ++itTear;
-        }
-
-        // Colisões Inimigos -> Isaac
-        for (auto& m : monstros) {
-            if (m->getHealth() <= 0) continue;
-            if (checkCollision(isaacBounds, m->getGlobalBounds())) {
-                int dmg = (m->getState() == MonstroState::Falling) ? 2 : 1;
-                Isaac->takeDamage(dmg);
-            }
-            auto& mProj = m->getProjectiles();
-            for (auto itP = mProj.begin(); itP != mProj.end();) {
-                if (checkCollision(isaacBounds, itP->sprite.getGlobalBounds())) {
-                    Isaac->takeDamage(1); itP = mProj.erase(itP);
-                }
-                else ++itP;
-            }
-        }
+void Game::restoreRun(const RunSnapshot& snapshot) {
+    simulation->restoreRun(snapshot);
+    updateRoomVisuals();
+    showBossTitle = false;
+}
 
-        for (auto& d : demons) {
-            if (d->getHealth() <= 0) continue;
-            if (checkCollision(isaacBounds, d->getGlobalBounds())) Isaac->takeDamage(1);
-            auto& dProj = d->getProjectiles();
-            for (auto itP = dProj.begin(); itP != dProj.end();) {
-                if (checkCollision(isaacBounds, itP->sprite.getGlobalBounds())) {
-                    Isaac->takeDamage(1); itP = dProj.erase(itP);
-                }
-                else ++itP;
-            }
-        }
+void Game::saveRun() {
+    const auto& config = ConfigManager::getInstance().getConfig();
+    if (!config.game.save.enabled || currentState != GameState::playing || !simulation || simulation->isOver()) return;
 
-        for (auto& b : bishops) {
-            if (b->getHealth() > 0 && checkCollision(isaacBounds, b->getGlobalBounds())) Isaac->takeDamage(1);
-        }
+    sf::Clock saveClock;
+    simulation->captureRun(runSnapshot);
+    if (saveRunSnapshot(config.game.save.file, runSnapshot, config)) {
+        LOG_INFO(LogCategory::General, "run guardada em '", config.game.save.file, "' (", runSnapshot.enemies.size(), " inimigos, ",
+            saveClock.getElapsedTime().asMicroseconds(), " us)");
+    }
+}
 
-        for (auto& c : chubbies) {
-            if (c->getHealth() <= 0) continue;
-            if (checkCollision(isaacBounds, c->getGlobalBounds())) Isaac->takeDamage(1);
-            if (c->BoomerangActive() && checkCollision(isaacBounds, c->getBoomerangBounds())) Isaac->takeDamage(2);
-        }
+bool Game::restoreWorld(const WorldSnapshot& snapshot) {
+    const int roomBefore = simulation->rooms().getCurrentRoomID();
+    if (!simulation->restoreWorld(snapshot)) return false;
+    if (simulation->rooms().getCurrentRoomID() != roomBefore) {
+        updateRoomVisuals();
+        showBossTitle = false;
     }
+    return true;
+}
+
+bool Game::resumeRun() {
+    const auto& config = ConfigManager::getInstance().getConfig();
+    if (!config.game.save.enabled || !simulation) return false;
+    if (!loadRunSnapshot(config.game.save.file, config, runSnapshot)) return false;
 
-    if (Isaac->getHealth() <= 0) window.close();
+    restoreRun(runSnapshot);
+    return true;
 }
 
 void Game::render() {
@@ -273,11 +213,13 @@ void Game::render() {
     if (cornerBL) window.draw(*cornerBL);
     if (cornerBR) window.draw(*cornerBR);
 
-    if (roomManager) roomManager->draw(window);
-    if (Isaac) Isaac->draw(window);
+    if (simulation) {
+        simulation->rooms().draw(window);
+        simulation->player().draw(window);
+    }
 
-    if (Isaac && heartSpriteF) {
-        int hp = Isaac->getHealth();
+    if (simulation && heartSpriteF) {
+        int hp = simulation->player().getHealth();
         float x = config.game.ui.heart_ui_x;
         for (int i = 0; i < config.game.ui.max_hearts; ++i) {
             sf::Sprite* s = (hp >= 2) ? &*heartSpriteF : (hp == 1 ? &*heartSpriteH : &*heartSpriteE);
@@ -288,9 +230,9 @@ void Game::render() {
         }
     }
 
-    if (roomManager) {
-        roomManager->drawMiniMap(window);
-        roomManager->drawTransitionOverlay(window);
+    if (simulation) {
+        simulation->rooms().drawMiniMap(window);
+        simulation->rooms().drawTransitionOverlay(window);
     }
 
     if (showBossTitle) {
@@ -303,24 +245,53 @@ void Game::render() {
 
 void Game::processEvents() {
     while (std::optional<sf::Event> event = window.pollEvent()) {
-        if (event->is<sf::Event::Closed>()) window.close();
+        if (event->is<sf::Event::Closed>()) {
+            saveRun();
+            window.close();
+        }
+        // F2: relatorio de residencia das texturas no log; F5/F9: guardar e retomar a run
+        if (const auto* key = event->getIf<sf::Event::KeyPressed>()) {
+            if (key->scancode == sf::Keyboard::Scancode::F2) assets.logResidencyReport();
+            else if (key->scancode == sf::Keyboard::Scancode::F5) saveRun();
+            else if (key->scancode == sf::Keyboard::Scancode::F9 && currentState == GameState::playing) resumeRun();
+            // F6/F7: fotografia da simulacao e rollback (testar uma jogada varias vezes)
+            else if (key->scancode == sf::Keyboard::Scancode::F6 && currentState == GameState::playing && simulation) {
+                simulation->captureWorld(worldSnapshot);
+                hasWorldSnapshot = true;
+                LOG_INFO(LogCategory::General, "fotografia da simulacao: ", worldSnapshot.enemies.size(), " inimigos, ",
+                    worldSnapshot.projectiles.size(), " projeteis");
+            }
+            else if (key->scancode == sf::Keyboard::Scancode::F7 && hasWorldSnapshot && currentState == GameState::playing) {
+                if (!restoreWorld(worldSnapshot)) LOG_WARN(LogCategory::General, "fotografia de outro andar, rollback ignorado");
+            }
+        }
     }
 }
 
 void Game::setupMenu() {
     const auto& config = ConfigManager::getInstance().getConfig();
-    if (playButtonTexture.loadFromFile("Images/UI/Menu/playButton.png")) {
-        playButton.emplace(playButtonTexture);
+    // Opcionais: sem a imagem o menu fica sem esse elemento
+    auto menuTexture = [&](AssetId id, const std::string& filename) -> const sf::Texture* {
+        try {
+            TextureHandle handle = assets.loadTexture(id, filename);
+            pinnedAssets.emplace_back(assets, handle);
+            return &assets.get(handle);
+        }
+        catch (const std::exception&) { return nullptr; }
+        };
+
+    if (const sf::Texture* texture = menuTexture(AssetIds::MenuPlay, "Images/UI/Menu/playButton.png")) {
+        playButton.emplace(*texture);
         playButton->setPosition({ config.game.menu.play_button.position_x, config.game.menu.play_button.position_y });
         playButton->setScale({ config.game.menu.play_button.scale_x, config.game.menu.play_button.scale_y });
     }
-    if (exitButtonTexture.loadFromFile("Images/UI/Menu/exitButton.png")) {
-        exitButton.emplace(exitButtonTexture);
+    if (const sf::Texture* texture = menuTexture(AssetIds::MenuExit, "Images/UI/Menu/exitButton.png")) {
+        exitButton.emplace(*texture);
         exitButton->setPosition({ config.game.menu.exit_button.position_x, config.game.menu.exit_button.position_y });
         exitButton->setScale({ config.game.menu.exit_button.scale_x, config.game.menu.exit_button.scale_y });
     }
-    if (menuTexture.loadFromFile("Images/UI/Menu/backgroundMenu.png")) {
-        menuGround.emplace(menuTexture);
+    if (const sf::Texture* texture = menuTexture(AssetIds::MenuBackground, "Images/UI/Menu/backgroundMenu.png")) {
+        menuGround.emplace(*texture);
         menuGround->setScale({ config.game.menu.background_scale_x, config.game.menu.background_scale_y });
     }
 }
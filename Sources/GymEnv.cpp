@@ -0,0 +1,238 @@
+#include "GymEnv.hpp"
+#include "ConfigManager.hpp"
+#include "JobSystem.hpp"
+#include <algorithm>
+
+// Texturas vazias: headless nada e desenhado, mas os sprites e os clips guardam
+// ponteiros para elas, por isso vivem ate ao fim do processo
+HeadlessTextures::HeadlessTextures() {
+    // Tantos frames como a maior animacao da config: com menos, os clips sairiam mais
+    // curtos do que no jogo (o Bishop so cura no heal_trigger_frame)
+    const auto& config = ConfigManager::getInstance().getConfig();
+    const int frameCount = std::max({ config.player.visual.animation.frames_vertical, config.player.visual.animation.frames_horizontal,
+        config.demon.visual.animation.frames, config.bishop.visual.animation.frames, 1 });
+    frames.resize(static_cast<std::size_t>(frameCount));
+
+    enemies.demonDown = enemies.demonUp = enemies.demonLeft = enemies.demonRight = &frames;
+    enemies.bishop = &frames;
+    enemies.demonProjectile = enemies.chubbySheet = enemies.chubbyProjectile = enemies.monstroSheet = &sheet;
+    player.walkDown = player.walkUp = player.walkLeft = player.walkRight = &frames;
+    player.tears = &sheet;
+}
+
+HeadlessTextures& headlessTextures() {
+    static HeadlessTextures textures;
+    return textures;
+}
+
+namespace {
+    sf::FloatRect configBounds() {
+        const auto& bounds = ConfigManager::getInstance().getConfig().game.bounds;
+        return sf::FloatRect({ (float)bounds.left, (float)bounds.top }, { (float)bounds.width, (float)bounds.height });
+    }
+
+    const sf::Vector2f kMoves[kGymMoveActions] = {
+        { 0.f, 0.f }, { 0.f, -1.f }, { 0.f, 1.f }, { -1.f, 0.f }, { 1.f, 0.f },
+        { -1.f, -1.f }, { 1.f, -1.f }, { -1.f, 1.f }, { 1.f, 1.f },
+    };
+
+    sf::Vector2f center(const sf::FloatRect& rect) {
+        return rect.position + rect.size / 2.f;
+    }
+}
+
+void GymEnv::prepare() {
+    static bool prepared = false;
+    if (prepared) return;
+    prepared = true;
+
+    // Uma sala com um inimigo de cada tipo e arquetipo: os clips ficam todos criados
+    // aqui e os ambientes, em qualquer thread, so os procuram
+    const auto& config = ConfigManager::getInstance().getConfig();
+    HeadlessTextures& textures = headlessTextures();
+    std::vector<EnemySpawn> roster(2);
+    roster[0].kind = SpawnKind::Demon;
+    roster[1].kind = SpawnKind::Bishop;
+    for (std::size_t i = 0; i < config.archetypes.records.size(); ++i) {
+        EnemySpawn spawn;
+        spawn.kind = config.archetypes.records[i].kind == ArchetypeKind::Monstro ? SpawnKind::Monstro : SpawnKind::Chubby;
+        spawn.archetype = static_cast<std::uint16_t>(i);
+        roster.push_back(spawn);
+    }
+    const sf::FloatRect bounds = configBounds();
+    for (EnemySpawn& spawn : roster) spawn.position = center(bounds);
+
+    Room room(0, RoomType::Normal, bounds, 1u);
+    room.setRoster(std::move(roster), 1.f);
+    room.spawnEnemies(textures.enemies);
+    Player_ALL player(*textures.player.walkDown, *textures.player.tears, *textures.player.walkUp,
+        *textures.player.walkLeft, *textures.player.walkRight);
+}
+
+GymEnv::GymEnv()
+    : sim(headlessTextures().player, headlessTextures().enemies, headlessTextures().sheet, configBounds())
+{
+    subscription = bus.subscribe(kAllGameEvents, [this](const std::vector<GameEvent>& events) { onEvents(events); });
+}
+
+GymEnv::~GymEnv() {
+    bus.unsubscribe(subscription);
+}
+
+void GymEnv::onEvents(const std::vector<GameEvent>& events) {
+    const GymConfig& gym = ConfigManager::getInstance().getConfig().game.gym;
+    for (const GameEvent& event : events) {
+        const bool player = event.target == GameEventTarget::Player;
+        switch (event.type) {
+        case GameEventType::Damage:
+            pendingReward += event.amount * (player ? gym.reward_hurt : gym.reward_hit);
+            break;
+        case GameEventType::Death:
+            pendingReward += player ? gym.reward_death : gym.reward_kill;
+            break;
+        case GameEventType::RoomClear:
+            pendingReward += gym.reward_room_clear;
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+void GymEnv::reset(std::uint32_t seed, float* observation) {
+    EventBus::Scope scope(bus);
+    sim.newRun(seed);
+    sim.player().setInput(&input);
+    input = PlayerInput();
+    stepCount = 0;
+    bus.pending().clear();
+    pendingReward = 0.f;
+    observe(observation);
+}
+
+GymStep GymEnv::step(int action, float* observation) {
+    const GymConfig& gym = ConfigManager::getInstance().getConfig().game.gym;
+    EventBus::Scope scope(bus);
+
+    action = std::clamp(action, 0, kGymActionCount - 1);
+    input.move = kMoves[action / kGymShootActions];
+    input.shoot = static_cast<ShootDirection>(action % kGymShootActions);
+
+    pendingReward = 0.f;
+    for (int tick = 0; tick < std::max(gym.frame_skip, 1) && !sim.isOver(); ++tick) sim.update(gym.step_dt);
+    ++stepCount;
+
+    GymStep result;
+    result.reward = pendingReward + gym.reward_step;
+    result.truncated = !sim.isOver() && stepCount >= gym.max_steps;
+    result.done = sim.isOver() || result.truncated;
+    observe(observation);
+    return result;
+}
+
+void GymEnv::observe(float* observation) {
+    std::fill(observation, observation + kGymObservationSize, 0.f);
+    const sf::FloatRect& bounds = sim.bounds();
+    const Player_ALL& player = sim.player();
+    const sf::Vector2f origin = player.getPosition();
+    float* out = observation;
+
+    *out++ = (origin.x - bounds.position.x) / bounds.size.x;
+    *out++ = (origin.y - bounds.position.y) / bounds.size.y;
+    *out++ = static_cast<float>(player.getHealth());
+
+    RoomManager& rooms = sim.rooms();
+    Room* room = rooms.getCurrentRoom();
+    *out++ = room && room->isCleared() ? 1.f : 0.f;
+    *out++ = static_cast<float>(rooms.getFloorIndex());
+    *out++ = rooms.isTransitioning() ? 1.f : 0.f;
+    for (DoorDirection direction : { DoorDirection::North, DoorDirection::South, DoorDirection::East, DoorDirection::West }) {
+        *out++ = room && room->hasDoor(direction) ? 1.f : 0.f;
+    }
+    if (!room) return;
+
+    auto relative = [&](const sf::Vector2f& position, float*& slot) {
+        *slot++ = (position.x - origin.x) / bounds.size.x;
+        *slot++ = (position.y - origin.y) / bounds.size.y;
+    };
+
+    float* enemySlot = out;
+    float* projectileSlot = out + kGymObservedEnemies * 4;
+    float* const enemyEnd = projectileSlot;
+    float* const projectileEnd = observation + kGymObservationSize;
+
+    auto addProjectile = [&](const sf::FloatRect& hitbox) {
+        if (projectileSlot == projectileEnd) return;
+        relative(center(hitbox), projectileSlot);
+        *projectileSlot++ = 1.f;
+    };
+    auto addEnemy = [&](EnemyBase& enemy) {
+        if (enemy.getHealth() <= 0) return;
+        if (enemySlot != enemyEnd) {
+            relative(center(enemy.getHitbox()), enemySlot);
+            *enemySlot++ = static_cast<float>(enemy.getHealth());
+            *enemySlot++ = 1.f;
+        }
+        for (const EnemyProjectile& projectile : enemy.getProjectiles()) addProjectile(projectile.hitbox);
+    };
+
+    for (auto& d : room->getDemons()) addEnemy(*d);
+    for (auto& b : room->getBishops()) addEnemy(*b);
+    for (auto& c : room->getChubbies()) {
+        addEnemy(*c);
+        if (c->getHealth() > 0 && c->BoomerangActive()) addProjectile(c->getBoomerangBounds());
+    }
+    for (auto& m : room->getMonstros()) addEnemy(*m);
+}
+
+// --- VecEnv ---
+
+VecEnv::VecEnv(std::size_t count)
+    : seeds(count, 0u)
+    , observationBuffer(count * kGymObservationSize, 0.f)
+    , rewardBuffer(count, 0.f)
+    , doneBuffer(count, 0)
+    , truncatedBuffer(count, 0)
+{
+    GymEnv::prepare();
+    envs.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) envs.push_back(std::make_unique<GymEnv>());
+}
+
+void VecEnv::reset(std::uint32_t seed) {
+    for (std::size_t i = 0; i < envs.size(); ++i) {
+        seeds[i] = seed + static_cast<std::uint32_t>(i);
+        envs[i]->reset(seeds[i], observationBuffer.data() + i * kGymObservationSize);
+        rewardBuffer[i] = 0.f;
+        doneBuffer[i] = 0;
+        truncatedBuffer[i] = 0;
+    }
+}
+
+void VecEnv::step(const int* actions) {
+    stepRange(actions, 0, envs.size());
+}
+
+void VecEnv::stepParallel(const int* actions) {
+    // Um bloco por thread: cada ambiente e independente, so o custo por sala varia
+    JobSystem& jobs = JobSystem::getInstance();
+    const std::size_t threads = jobs.workerCount() + 1;
+    const std::size_t grain = std::max<std::size_t>(1, (envs.size() + threads - 1) / threads);
+    jobs.parallelFor(envs.size(), grain, [&](std::size_t begin, std::size_t end, std::size_t) {
+        stepRange(actions, begin, end);
+        });
+}
+
+void VecEnv::stepRange(const int* actions, std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+        float* observation = observationBuffer.data() + i * kGymObservationSize;
+        GymStep result = envs[i]->step(actions[i], observation);
+        rewardBuffer[i] = result.reward;
+        doneBuffer[i] = result.done ? 1 : 0;
+        truncatedBuffer[i] = result.truncated ? 1 : 0;
+        if (result.done) {
+            seeds[i] += static_cast<std::uint32_t>(envs.size());
+            envs[i]->reset(seeds[i], observation);
+        }
+    }
+}
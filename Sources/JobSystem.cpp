@@ -0,0 +1,176 @@
+#include "JobSystem.hpp"
+#include <algorithm>
+#include <iostream>
+
+namespace {
+    // Indice do worker da thread atual (as outras threads ficam com "nenhum")
+    constexpr std::size_t kNoWorker = static_cast<std::size_t>(-1);
+    thread_local std::size_t currentWorker = kNoWorker;
+}
+
+JobSystem& JobSystem::getInstance() {
+    static JobSystem instance;
+    return instance;
+}
+
+JobSystem::~JobSystem() {
+    stop();
+}
+
+void JobSystem::start(int workerThreads) {
+    stop();
+
+    std::size_t count = workerThreads > 0 ? static_cast<std::size_t>(workerThreads)
+        : static_cast<std::size_t>(std::max(1u, std::thread::hardware_concurrency()) - 1);
+
+    running = true;
+    workers.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) workers.push_back(std::make_unique<Worker>());
+    for (std::size_t i = 0; i < count; ++i) {
+        workers[i]->thread = std::thread(&JobSystem::workerLoop, this, i);
+    }
+}
+
+void JobSystem::stop() {
+    if (workers.empty()) return;
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        running = false;
+    }
+    wake.notify_all();
+    for (auto& w : workers) {
+        if (w->thread.joinable()) w->thread.join();
+    }
+    // Jobs que ficaram na fila ainda tem de terminar (alguem pode estar em wait)
+    for (auto& w : workers) {
+        for (auto& job : w->queue) execute(job);
+    }
+    workers.clear();
+    queued = 0;
+}
+
+void JobSystem::execute(Job& job) {
+    try {
+        job.fn();
+    }
+    catch (...) {
+        std::lock_guard<std::mutex> lock(job.counter->errorMutex);
+        if (!job.counter->error) job.counter->error = std::current_exception();
+    }
+    job.counter->pending.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void JobSystem::submit(std::function<void()> job, JobCounter& counter, JobLane lane) {
+    counter.pending.fetch_add(1, std::memory_order_relaxed);
+    Job entry{ std::move(job), &counter, lane };
+
+    if (workers.empty()) {
+        execute(entry);
+        return;
+    }
+
+    // Um worker mete na propria fila; as outras threads distribuem em round-robin
+    std::size_t target = currentWorker != kNoWorker ? currentWorker
+        : nextQueue.fetch_add(1, std::memory_order_relaxed) % workers.size();
+    {
+        std::lock_guard<std::mutex> lock(workers[target]->mutex);
+        workers[target]->queue.push_back(std::move(entry));
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        queued.fetch_add(1, std::memory_order_release);
+    }
+    wake.notify_one();
+}
+
+bool JobSystem::tryRunOne(std::size_t preferred) {
+    Job job;
+    bool found = false;
+
+    // Primeiro a propria fila (LIFO, dados ainda quentes na cache)
+    if (preferred != kNoWorker) {
+        std::lock_guard<std::mutex> lock(workers[preferred]->mutex);
+        auto& q = workers[preferred]->queue;
+        if (!q.empty()) {
+            job = std::move(q.back());
+            q.pop_back();
+            found = true;
+        }
+    }
+
+    // Depois rouba do inicio das filas dos outros (FIFO, os blocos mais antigos).
+    // Threads que nao sao workers saltam os jobs WorkersOnly.
+    const bool isWorker = preferred != kNoWorker;
+    const std::size_t n = workers.size();
+    const std::size_t startAt = isWorker ? preferred + 1 : 0;
+    for (std::size_t k = 0; !found && k < n; ++k) {
+        std::size_t victim = (startAt + k) % n;
+        if (victim == preferred) continue;
+        std::lock_guard<std::mutex> lock(workers[victim]->mutex);
+        auto& q = workers[victim]->queue;
+        for (auto it = q.begin(); it != q.end(); ++it) {
+            if (!isWorker && it->lane == JobLane::WorkersOnly) continue;
+            job = std::move(*it);
+            q.erase(it);
+            found = true;
+            break;
+        }
+    }
+
+    if (!found) return false;
+    queued.fetch_sub(1, std::memory_order_acq_rel);
+    execute(job);
+    return true;
+}
+
+void JobSystem::workerLoop(std::size_t index) {
+    currentWorker = index;
+    while (true) {
+        if (tryRunOne(index)) continue;
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait(lock, [this] { return !running || queued.load(std::memory_order_acquire) > 0; });
+        if (!running) break;
+    }
+    currentWorker = kNoWorker;
+}
+
+void JobSystem::wait(JobCounter& counter) {
+    while (!counter.done()) {
+        if (!tryRunOne(currentWorker)) std::this_thread::yield();
+    }
+
+    std::exception_ptr error;
+    {
+        std::lock_guard<std::mutex> lock(counter.errorMutex);
+        std::swap(error, counter.error);
+    }
+    if (error) std::rethrow_exception(error);
+}
+
+std::size_t JobSystem::blockCount(std::size_t count, std::size_t grain) {
+    grain = std::max<std::size_t>(1, grain);
+    return (count + grain - 1) / grain;
+}
+
+void JobSystem::parallelFor(std::size_t count, std::size_t grain,
+    const std::function<void(std::size_t, std::size_t, std::size_t)>& fn) {
+    grain = std::max<std::size_t>(1, grain);
+    const std::size_t blocks = blockCount(count, grain);
+
+    if (workers.empty() || blocks <= 1) {
+        for (std::size_t b = 0; b < blocks; ++b) fn(b * grain, std::min(count, (b + 1) * grain), b);
+        return;
+    }
+
+    JobCounter counter;
+    // O primeiro bloco fica para a thread que chamou
+    for (std::size_t b = 1; b < blocks; ++b) {
+        submit([&fn, b, grain, count] { fn(b * grain, std::min(count, (b + 1) * grain), b); }, counter);
+    }
+    counter.pending.fetch_add(1, std::memory_order_relaxed);
+    Job first{ [&fn, grain, count] { fn(0, std::min(count, grain), 0); }, &counter };
+    execute(first);
+
+    wait(counter);
+}
@@ -0,0 +1,234 @@
+#include "Logger.hpp"
+#include "GameConfig.hpp"
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+
+namespace {
+    constexpr const char* kLevelNames[] = { "trace", "debug", "info", "warn", "error", "off" };
+    constexpr const char* kCategoryNames[] = { "geral", "assets", "config", "combat", "ai", "rooms" };
+    static_assert(std::size(kCategoryNames) == kLogCategoryCount);
+
+    std::size_t roundUpPow2(std::size_t value) {
+        std::size_t result = 64;
+        while (result < value) result <<= 1;
+        return result;
+    }
+}
+
+const char* logLevelName(LogLevel level) { return kLevelNames[static_cast<std::size_t>(level)]; }
+const char* logCategoryName(LogCategory category) { return kCategoryNames[static_cast<std::size_t>(category)]; }
+
+bool logLevelFromName(std::string_view name, LogLevel& level) {
+    for (std::size_t i = 0; i < std::size(kLevelNames); ++i) {
+        if (name == kLevelNames[i]) { level = static_cast<LogLevel>(i); return true; }
+    }
+    return false;
+}
+
+bool logCategoryFromName(std::string_view name, LogCategory& category) {
+    for (std::size_t i = 0; i < kLogCategoryCount; ++i) {
+        if (name == kCategoryNames[i]) { category = static_cast<LogCategory>(i); return true; }
+    }
+    return false;
+}
+
+Logger& Logger::getInstance() {
+    static Logger instance;
+    return instance;
+}
+
+Logger::Logger() : startTime(std::chrono::steady_clock::now()) {}
+
+Logger::~Logger() {
+    stop();
+}
+
+void Logger::start(const LoggingConfig& config) {
+    if (running.load(std::memory_order_acquire)) return;
+
+    LogLevel level = LogLevel::Info;
+    if (!logLevelFromName(config.level, level)) LOG_WARN(LogCategory::Config, "nivel de log desconhecido '", config.level, "', a usar info");
+    setLevel(level);
+    for (const auto& [name, perSecond] : config.rate_limits) {
+        LogCategory category;
+        if (logCategoryFromName(name, category)) setRateLimit(category, perSecond);
+        else LOG_WARN(LogCategory::Config, "categoria de log desconhecida '", name, "'");
+    }
+
+    const std::size_t capacity = roundUpPow2(static_cast<std::size_t>(std::max(config.queue_capacity, 1)));
+    cells = std::make_unique<Cell[]>(capacity);
+    for (std::size_t i = 0; i < capacity; ++i) cells[i].sequence.store(i, std::memory_order_relaxed);
+    mask = capacity - 1;
+    enqueuePos.store(0, std::memory_order_relaxed);
+    dequeuePos = 0;
+    flushInterval = std::chrono::milliseconds(std::max(config.flush_interval_ms, 1));
+
+    {
+        std::lock_guard<std::mutex> lock(sinkMutex);
+        console = config.console;
+        if (!config.file.empty()) {
+            file.open(config.file, std::ios::out | std::ios::trunc);
+            if (!file.is_open()) std::cerr << "ERRO: nao foi possivel abrir o ficheiro de log '" << config.file << "'\n";
+        }
+    }
+
+    running.store(true, std::memory_order_release);
+    writer = std::thread([this] { writerLoop(); });
+}
+
+void Logger::stop() {
+    if (!running.exchange(false, std::memory_order_acq_rel)) return;
+    wake.notify_all();
+    if (writer.joinable()) writer.join();
+    drain();
+
+    std::lock_guard<std::mutex> lock(sinkMutex);
+    if (file.is_open()) file.close();
+}
+
+void Logger::setRateLimit(LogCategory category, int perSecond) {
+    limits[static_cast<std::size_t>(category)].perSecond.store(std::max(perSecond, 0), std::memory_order_relaxed);
+}
+
+std::int64_t Logger::elapsedMs() const {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+bool Logger::accept(LogLevel level, LogCategory category) {
+    if (level < runtimeLevel.load(std::memory_order_relaxed) || level == LogLevel::Off) return false;
+    if (level >= LogLevel::Warn) return true;
+
+    CategoryLimit& limit = limits[static_cast<std::size_t>(category)];
+    const int perSecond = limit.perSecond.load(std::memory_order_relaxed);
+    if (perSecond <= 0) return true;
+
+    // Janela fixa de 1 s: quem a vira primeiro zera a contagem
+    const std::int64_t now = elapsedMs();
+    std::int64_t window = limit.windowStart.load(std::memory_order_relaxed);
+    if (now - window >= 1000 && limit.windowStart.compare_exchange_strong(window, now, std::memory_order_relaxed)) {
+        limit.count.store(0, std::memory_order_relaxed);
+    }
+    if (limit.count.fetch_add(1, std::memory_order_relaxed) < perSecond) return true;
+    limit.suppressed.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void Logger::push(LogRecord& record) {
+    record.time = std::chrono::duration<float>(std::chrono::steady_clock::now() - startTime).count();
+    if (!running.load(std::memory_order_acquire)) {
+        writeNow(record);
+        return;
+    }
+
+    std::size_t pos = enqueuePos.load(std::memory_order_relaxed);
+    Cell* cell;
+    for (;;) {
+        cell = &cells[pos & mask];
+        const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        const std::intptr_t diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+        if (diff == 0) {
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        }
+        else if (diff < 0) {
+            // Fila cheia: a thread de escrita esta atrasada, descarta em vez de esperar
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        else pos = enqueuePos.load(std::memory_order_relaxed);
+    }
+    cell->record = record;
+    cell->sequence.store(pos + 1, std::memory_order_release);
+}
+
+bool Logger::pop(LogRecord& record) {
+    Cell& cell = cells[dequeuePos & mask];
+    const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+    if (static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(dequeuePos + 1) < 0) return false;
+    record = cell.record;
+    cell.sequence.store(dequeuePos + mask + 1, std::memory_order_release);
+    ++dequeuePos;
+    return true;
+}
+
+void Logger::writerLoop() {
+    while (running.load(std::memory_order_acquire)) {
+        drain();
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait_for(lock, flushInterval, [this] { return !running.load(std::memory_order_acquire); });
+    }
+}
+
+void Logger::format(const LogRecord& record, std::string& out) const {
+    char time[16];
+    auto result = std::to_chars(time, time + sizeof(time), record.time, std::chars_format::fixed, 3);
+    out += '[';
+    out.append(time, result.ptr);
+    out += "] ";
+    out += logLevelName(record.level);
+    out += ' ';
+    out += logCategoryName(record.category);
+    out += ": ";
+    out.append(record.text, record.length);
+    out += '\n';
+}
+
+void Logger::drain() {
+    outBatch.clear();
+    errBatch.clear();
+    fileBatch.clear();
+
+    // Consola: normal para stdout, Warn/Error para stderr. Ficheiro: tudo pela ordem
+    LogRecord record;
+    auto emit = [&]() {
+        std::string& target = record.level >= LogLevel::Warn ? errBatch : outBatch;
+        const std::size_t from = target.size();
+        format(record, target);
+        fileBatch.append(target, from, std::string::npos);
+        };
+    while (pop(record)) emit();
+
+    // Resumo do que foi descartado desde o ultimo lote
+    record.time = std::chrono::duration<float>(std::chrono::steady_clock::now() - startTime).count();
+    for (std::size_t i = 0; i < kLogCategoryCount; ++i) {
+        const int suppressed = limits[i].suppressed.exchange(0, std::memory_order_relaxed);
+        if (suppressed == 0) continue;
+        record.level = LogLevel::Warn;
+        record.category = static_cast<LogCategory>(i);
+        record.length = 0;
+        record.append(suppressed);
+        record.append(" mensagens suprimidas (limite ");
+        record.append(limits[i].perSecond.load(std::memory_order_relaxed));
+        record.append("/s)");
+        emit();
+    }
+    const std::uint64_t droppedNow = dropped.load(std::memory_order_relaxed);
+    if (droppedNow != reportedDropped) {
+        record.level = LogLevel::Warn;
+        record.category = LogCategory::General;
+        record.length = 0;
+        record.append(droppedNow - reportedDropped);
+        record.append(" mensagens perdidas (fila de log cheia)");
+        emit();
+        reportedDropped = droppedNow;
+    }
+
+    if (outBatch.empty() && errBatch.empty()) return;
+    std::lock_guard<std::mutex> lock(sinkMutex);
+    if (console) {
+        if (!outBatch.empty()) std::cout << outBatch << std::flush;
+        if (!errBatch.empty()) std::cerr << errBatch << std::flush;
+    }
+    if (file.is_open()) {
+        file << fileBatch;
+        file.flush();
+    }
+}
+
+void Logger::writeNow(const LogRecord& record) {
+    std::string line;
+    format(record, line);
+    std::lock_guard<std::mutex> lock(sinkMutex);
+    if (console) (record.level >= LogLevel::Warn ? std::cerr : std::cout) << line << std::flush;
+    if (file.is_open()) file << line << std::flush;
+}
@@ -1,5 +1,8 @@
 #include "Monstro.hpp"
 #include "ConfigManager.hpp"
+#include "Collision.hpp"
+#include "BulletPattern.hpp"
+#include "Logger.hpp"
 #include <cmath>
 #include <algorithm>
 
@@ -7,9 +10,44 @@
 #define M_PI 3.14159265358979323846f
 #endif
 
-Monstro::Monstro(sf::Texture& texture, sf::Texture& projectileTex, sf::Vector2f startPos) : EnemyBase() {
+Monstro::Monstro(const EnemyArchetype& type, sf::Texture& texture, sf::Texture& projectileTex, sf::Vector2f startPos)
+    : EnemyBase(), archetype(type) {
     projTex = &projectileTex;
-    initFrames();
+    hitboxShape = archetype.hitbox;
+    projectileHitboxShape = archetype.projectile.hitbox;
+    baseScale = archetype.stats.scale;
+
+    // O config ja foi validado no load (validateArchetype / validateBossTimeline)
+    auto& clips = AnimationLibrary::getInstance();
+    clipIdle = clips.fromArchetype(archetype, archetype.findClip("idle"));
+
+    const auto& config = ConfigManager::getInstance().getConfig();
+    if (archetype.timeline_id >= 0) {
+        const BossTimelineConfig& timeline = config.boss_timelines[archetype.timeline_id];
+        brain.emplace(timeline);
+
+        // Tabelas por id de segmento/evento: o update nao faz lookups por nome
+        const auto& library = BulletPatternLibrary::getInstance();
+        segmentClips.assign(timeline.segment_count, nullptr);
+        eventPatterns.assign(timeline.event_count, nullptr);
+        for (const auto& state : timeline.states) {
+            for (const auto& segment : state.segments)
+                if (!segment.clip.empty())
+                    segmentClips[segment.id] = clips.fromArchetype(archetype, archetype.findClip(segment.clip.c_str()));
+            for (const auto& event : state.events)
+                if (event.kind == BossEventKind::Attack)
+                    eventPatterns[event.id] = library.get(archetype.attacks[archetype.findAttack(event.attack.c_str())].pattern_id);
+        }
+    }
+    else {
+        LOG_ERROR(LogCategory::AI, "Monstro '", archetype.name, "' sem timeline valida, fica parado");
+    }
+
+    // Todas as lagrimas partem da mesma copia (rect e origem do config)
+    const auto& tearRect = config.projectile_textures.demon_tear;
+    buildProjectilePrototype(*projTex, sf::IntRect({ tearRect.x, tearRect.y }, { tearRect.width, tearRect.height }),
+        sf::Vector2f(tearRect.width / 2.f, tearRect.height / 2.f), 2.f);
+
     sprite.emplace(texture);
 
     if (sprite) {
@@ -17,14 +55,11 @@ Monstro::Monstro(sf::Texture& texture, sf::Texture& projectileTex, sf::Vector2f
         sprite->setScale(sf::Vector2f(baseScale, baseScale));
     }
 
-    setFrame(1, 3);
-    health = 80.f;
-    maxHealth = 80.f;
-    state = MonstroState::Idle;
-    stateTimer = 0.f;
-    animStep = 0;
-    groundPos = startPos;
-    lastActionWasAttack = false;
+    setClip(clipIdle);
+    health = archetype.stats.health;
+    maxHealth = static_cast<float>(archetype.stats.max_health);
+    if (brain) brain->setGroundPosition(startPos);
+    refreshHitbox();
 
     shadow.setFillColor(sf::Color(0, 0, 0, 100));
     shadow.setRadius(25.f);
@@ -32,159 +67,74 @@ Monstro::Monstro(sf::Texture& texture, sf::Texture& projectileTex, sf::Vector2f
     shadow.setOrigin(sf::Vector2f(25.f, 25.f));
 }
 
-void Monstro::initFrames() {
-    frames[1][1] = sf::IntRect({ 6, 66 }, { 67, 46 });
-    frames[1][2] = sf::IntRect({ 86, 66 }, { 67, 46 });
-    frames[1][3] = sf::IntRect({ 167, 60 }, { 67, 52 });
-    frames[1][4] = sf::IntRect({ 246, 49 }, { 67, 63 });
-    frames[1][5] = sf::IntRect({ 928, 66 }, { 66, 76 });
-    frames[2][4] = sf::IntRect({ 247, 172 }, { 67, 52 });
-}
-
-void Monstro::setFrame(int coluna, int id) {
+void Monstro::setClip(const AnimationClip* clip) {
     if (sprite) {
-        sf::IntRect r = frames[coluna][id];
-        sprite->setTextureRect(r);
-        sprite->setOrigin(sf::Vector2f((float)r.size.x / 2.f, (float)r.size.y));
+        animation.play(clip);
+        applyFrame();
     }
 }
 
-void Monstro::handleStates(float deltaTime, sf::Vector2f playerPos) {
-    float flip = (playerPos.x > groundPos.x) ? -baseScale : baseScale;
-
-    switch (state) {
-    case MonstroState::Idle: {
-        setFrame(1, 3);
-        sprite->setScale(sf::Vector2f(flip, baseScale));
-        if (stateTimer > 1.1f) {
-            stateTimer = 0.0f;
-            if (health < 40.f && (rand() % 100 < 40)) { // Mega Jump abaixo de 50% HP
-                state = MonstroState::MegaJumping;
-                groundPosTarget = playerPos;
-            }
-            else {
-                if (lastActionWasAttack) {
-                    state = MonstroState::Walking;
-                    sf::Vector2f dir = playerPos - groundPos;
-                    float dist = std::sqrt(dir.x * dir.x + dir.y * dir.y);
-                    moveDir = (dist > 0) ? dir / dist : sf::Vector2f(0, 0);
-                    lastActionWasAttack = false;
-                }
-                else {
-                    state = MonstroState::Attacking;
-                    groundPosTarget = playerPos;
-                    lastActionWasAttack = true;
-                }
-            }
-            animStep = 0;
-        }
-        break;
-    }
+void Monstro::applyFrame() {
+    if (!sprite) return;
+    animation.apply(*sprite);
+    const sf::IntRect& r = sprite->getTextureRect();
+    sprite->setOrigin(sf::Vector2f((float)r.size.x / 2.f, (float)r.size.y));
+}
 
-    case MonstroState::Walking: {
-        if (stateTimer < 0.75f) {
-            setFrame(1, 2);
-            groundPos += moveDir * 280.f * deltaTime;
-            float jumpProgress = stateTimer / 0.75f;
-            float jumpHeight = std::sin(jumpProgress * M_PI) * 150.f;
-            sprite->setScale(sf::Vector2f(flip, baseScale));
-            sprite->setPosition(sf::Vector2f(groundPos.x, groundPos.y - jumpHeight));
-        }
-        else {
-            state = MonstroState::Cooldown;
-            stateTimer = 0.0f;
-        }
-        break;
-    }
+int Monstro::getContactDamage() const {
+    return brain ? brain->currentState().contact_damage : 1;
+}
 
-    case MonstroState::Attacking: {
-        if (stateTimer < 0.45f) {
-            setFrame(1, 3);
-            float charge = (stateTimer / 0.45f) * 0.08f;
-            sprite->setScale(sf::Vector2f(flip * (1.0f + charge), baseScale * (1.0f - charge)));
-        }
-        else if (stateTimer < 1.4f) {
-            setFrame(1, 4);
-            sprite->setScale(sf::Vector2f(flip * 0.95f, baseScale * 1.1f));
-            if (animStep == 0) { spawnTears(18, false); animStep = 1; }
-        }
-        else {
-            state = MonstroState::Cooldown;
-            stateTimer = 0.0f;
-        }
-        break;
-    }
+void Monstro::handleStates(float deltaTime, sf::Vector2f playerPos) {
+    if (!brain || !sprite) return;
 
-    case MonstroState::MegaJumping: {
-        setFrame(1, 1);
-        if (stateTimer < 0.4f) {
-            sprite->move(sf::Vector2f(0.f, -2200.f * deltaTime));
-        }
-        else {
-            state = MonstroState::Falling;
-            stateTimer = 0.0f;
-        }
-        break;
-    }
+    brainOutput.clear();
+    brain->update(deltaTime, playerPos, static_cast<float>(health) / maxHealth, rngState, brainOutput);
 
-    case MonstroState::Falling: {
-        if (stateTimer < 0.8f) { // Perseguio no ar
-            sf::Vector2f dir = groundPosTarget - groundPos;
-            float dist = std::sqrt(dir.x * dir.x + dir.y * dir.y);
-            if (dist > 5.0f) groundPos += (dir / dist) * 850.f * deltaTime;
-        }
-        else if (stateTimer < 1.0f) { // Queda rpida
-            float dropProgress = (stateTimer - 0.8f) / 0.2f;
-            sprite->setPosition(sf::Vector2f(groundPos.x, (groundPos.y - 2000.f) + (dropProgress * 2000.f)));
-            setFrame(1, 2);
-        }
-        else {
-            sprite->setPosition(groundPos);
-            spawnTears(55, true);
-            state = MonstroState::Cooldown;
-            stateTimer = 0.0f;
-        }
-        break;
-    }
+    // O sprite so e tocado quando a timeline diz que algo mudou
+    if (brain->bodyChanged()) sprite->setPosition(brain->bodyPosition());
+    if (brain->scaleChanged()) sprite->setScale(brain->scaleFactor() * baseScale);
 
-    case MonstroState::Cooldown: {
-        setFrame(2, 4);
-        sprite->setPosition(groundPos);
-        if (stateTimer > 0.6f) {
-            state = MonstroState::Idle;
-            stateTimer = 0.0f;
+    for (const BossOutput& output : brainOutput) {
+        if (output.segment) {
+            if (segmentClips[output.segment->id]) setClip(segmentClips[output.segment->id]);
+        }
+        else if (output.event->kind == BossEventKind::Attack) {
+            spawnTears(eventPatterns[output.event->id]);
         }
-        break;
-    }
     }
 }
 
 void Monstro::update(float deltaTime, sf::Vector2f playerPosition, const sf::FloatRect& gameBounds) {
     if (health <= 0) return;
-    stateTimer += deltaTime;
+    sf::Vector2f previousPos = sprite ? sprite->getPosition() : sf::Vector2f();
     handleStates(deltaTime, playerPosition);
+    // O playhead avana no Room::updateEnemies; clips com varios frames mudam aqui
+    if (animation.frameChanged) applyFrame();
+    bodyStep = (sprite ? sprite->getPosition() : sf::Vector2f()) - previousPos;
+
+    const float maxRange = archetype.projectile.range;
 
-    float maxRange = 980.f; // RANGE DE 980px
+    // Os que expiraram no tick anterior sem passar pelas colises
+    eraseExpiring(projectiles);
 
-    for (auto it = projectiles.begin(); it != projectiles.end();) {
-        float speed = 480.f;
-        sf::Vector2f movement = it->direction * speed * deltaTime;
-        it->sprite.move(movement);
+    for (EnemyProjectile& p : projectiles) {
+        float speed = archetype.projectile.speed;
+        sf::Vector2f movement = p.direction * speed * deltaTime;
+        p.sprite.move(movement);
+        p.lastStep = movement;
+        p.hitbox = makeHitbox(p.sprite.getPosition(), projectileHitboxShape);
 
         // Acumula a distncia percorrida
-        it->distanceTraveled += std::sqrt(movement.x * movement.x + movement.y * movement.y);
+        p.distanceTraveled += std::sqrt(movement.x * movement.x + movement.y * movement.y);
 
-        // Remove se sair da tela OU se passar de 980px
-        if (!gameBounds.contains(it->sprite.getPosition()) || it->distanceTraveled >= maxRange) {
-            it = projectiles.erase(it);
-        }
-        else {
-            ++it;
-        }
+        // Sai da tela OU passa do alcance: ainda entra nas colises deste tick
+        p.expiring = !gameBounds.contains(p.sprite.getPosition()) || p.distanceTraveled >= maxRange;
     }
 
-    handleHitFlash();
-    shadow.setPosition(groundPos);
+    handleHitFlash(deltaTime);
+    if (brain) shadow.setPosition(brain->groundPosition());
+    refreshHitbox();
 }
 
 void Monstro::draw(sf::RenderWindow& window) {
@@ -207,46 +157,49 @@ void Monstro::draw(sf::RenderWindow& window) {
     }
 }
 
-void Monstro::spawnTears(int count, bool circular) {
-    if (!sprite || !projTex) return;
-    const auto& dConfigTear = ConfigManager::getInstance().getConfig().projectile_textures.demon_tear;
-    sf::IntRect demonTearRect({ dConfigTear.x, dConfigTear.y }, { dConfigTear.width, dConfigTear.height });
-
-    if (circular) {
-        for (int i = 0; i < count; ++i) {
-            float angle = (360.f / count) * i;
-            float rad = angle * (M_PI / 180.f);
-            float speedMult = 0.7f + (static_cast<float>(rand() % 60) / 100.f);
-
-            // Inicializando distanceTraveled como 0.f
-            EnemyProjectile p = { sf::Sprite(*projTex), { std::cos(rad) * speedMult, std::sin(rad) * speedMult }, 0.f };
-            p.sprite.setTextureRect(demonTearRect);
-            p.sprite.setOrigin(sf::Vector2f(dConfigTear.width / 2.f, dConfigTear.height / 2.f));
-            p.sprite.setPosition(sprite->getPosition());
-            p.sprite.setScale(sf::Vector2f(2.0f, 2.0f));
-            projectiles.push_back(p);
-        }
-    }
-    else {
-        sf::Vector2f baseDir = groundPosTarget - sprite->getPosition();
-        float baseAngle = std::atan2(baseDir.y, baseDir.x) * (180.f / M_PI);
-
-        for (int i = 0; i < count; ++i) {
-            float spread = (rand() % 60 - 30);
-            float rad = (baseAngle + spread) * (M_PI / 180.f);
-            float speedMult = 0.8f + (static_cast<float>(rand() % 40) / 100.f);
-
-            EnemyProjectile p = { sf::Sprite(*projTex), { std::cos(rad) * speedMult, std::sin(rad) * speedMult }, 0.f };
-            p.sprite.setTextureRect(demonTearRect);
-            p.sprite.setOrigin(sf::Vector2f(dConfigTear.width / 2.f, dConfigTear.height / 2.f));
-            p.sprite.setPosition(sprite->getPosition() - sf::Vector2f(0.f, 40.f));
-            p.sprite.setScale(sf::Vector2f(2.3f, 2.3f));
-            projectiles.push_back(p);
-        }
-    }
+void Monstro::spawnTears(const BulletPattern* pattern) {
+    if (!sprite || !pattern || !projectilePrototype) return;
+
+    sf::Vector2f baseDir = (brain ? brain->targetPosition() : sf::Vector2f()) - sprite->getPosition();
+    float aim = std::atan2(baseDir.y, baseDir.x) * (180.f / M_PI);
+    pattern->emit(*projectilePrototype, projectileHitboxShape, sprite->getPosition(), aim,
+        volleyCount++, rngState, projectiles);
 }
 
 void Monstro::setPosition(sf::Vector2f pos) {
-    groundPos = pos;
+    if (brain) brain->setGroundPosition(pos);
     if (sprite) sprite->setPosition(pos);
+    refreshHitbox();
+}
+
+void Monstro::scaleHealth(float multiplier) {
+    EnemyBase::scaleHealth(multiplier);
+    // A barra de vida e as fases da timeline usam a fracao da vida maxima
+    maxHealth = static_cast<float>(health);
+}
+
+void Monstro::saveState(EnemyState& saved, std::vector<ProjectileState>& projectiles) const {
+    EnemyBase::saveState(saved, projectiles);
+    const int archetypeIndex = ConfigManager::getInstance().getConfig().archetypes.find(archetype.name);
+    saved.archetype = static_cast<std::uint16_t>(std::max(archetypeIndex, 0));
+    if (brain) brain->save(saved);
+    saved.timers[1] = maxHealth;
+    saved.values[5] = volleyCount;
+}
+
+void Monstro::loadState(const EnemyState& saved, const ProjectileState* projectiles) {
+    EnemyBase::loadState(saved, projectiles);
+    maxHealth = std::max(1.f, saved.timers[1]);
+    volleyCount = saved.values[5];
+    if (brain) {
+        brain->load(saved);
+        if (sprite) {
+            sprite->setPosition(brain->bodyPosition());
+            sprite->setScale(brain->scaleFactor() * baseScale);
+        }
+        shadow.setPosition(brain->groundPosition());
+    }
+    // Frame guardado com a origem nos pes, como no setClip
+    applyFrame();
+    refreshHitbox();
 }
\ No newline at end of file
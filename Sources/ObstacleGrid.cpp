@@ -0,0 +1,290 @@
+#include "ObstacleGrid.hpp"
+#include "Collision.hpp"
+#include "Utils.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+namespace {
+    constexpr float kInf = std::numeric_limits<float>::infinity();
+    // Folga deixada ao encostar num tile, para o arredondamento nao o fazer entrar
+    constexpr float kContactGap = 0.01f;
+    constexpr int kDirX[4] = { 1, -1, 0, 0 };
+    constexpr int kDirY[4] = { 0, 0, 1, -1 };
+
+    // floor/ceil sem chamar a libm (o resultado e sempre limitado a grelha depois):
+    // primeiro tile tocado por uma coordenada (negativos contam como 0) e o ultimo
+    // tile tocado por uma borda exclusiva
+    inline int firstTile(float v) {
+        return v > 0.f ? static_cast<int>(v) : 0;
+    }
+    inline int lastTile(float v) {
+        if (v <= 0.f) return -1;
+        int i = static_cast<int>(v);
+        return static_cast<float>(i) == v ? i - 1 : i;
+    }
+
+    // Mascara dos bits [first, last] de uma palavra
+    inline std::uint64_t bitRange(int first, int last) {
+        std::uint64_t high = last >= 63 ? ~0ull : ((1ull << (last + 1)) - 1);
+        std::uint64_t low = (1ull << first) - 1;
+        return high & ~low;
+    }
+}
+
+void ObstacleGrid::configure(const sf::FloatRect& bounds, float tileSize) {
+    area = bounds;
+    tile = std::max(1.f, tileSize);
+    cols = std::max(1, static_cast<int>(std::ceil(bounds.size.x / tile)));
+    rowCount = std::max(1, static_cast<int>(std::ceil(bounds.size.y / tile)));
+    wordsPerRow = (cols + 63) / 64;
+    solid.assign(static_cast<std::size_t>(wordsPerRow) * rowCount, 0);
+    opaque.assign(solid.size(), 0);
+    solidTiles = 0;
+}
+
+void ObstacleGrid::clear() {
+    std::fill(solid.begin(), solid.end(), 0);
+    std::fill(opaque.begin(), opaque.end(), 0);
+    solidTiles = 0;
+}
+
+void ObstacleGrid::set(int column, int row, ObstacleKind kind) {
+    if (column < 0 || row < 0 || column >= cols || row >= rowCount) return;
+    const std::size_t word = static_cast<std::size_t>(row) * wordsPerRow + column / 64;
+    const std::uint64_t bit = 1ull << (column % 64);
+
+    const bool wasSolid = (solid[word] & bit) != 0;
+    const bool isSolid = kind != ObstacleKind::None;
+    solidTiles += static_cast<int>(isSolid) - static_cast<int>(wasSolid);
+
+    if (isSolid) solid[word] |= bit; else solid[word] &= ~bit;
+    if (kind == ObstacleKind::Rock) opaque[word] |= bit; else opaque[word] &= ~bit;
+}
+
+ObstacleKind ObstacleGrid::kindAt(int column, int row) const {
+    if (testBit(opaque, column, row)) return ObstacleKind::Rock;
+    if (testBit(solid, column, row)) return ObstacleKind::Pit;
+    return ObstacleKind::None;
+}
+
+sf::FloatRect ObstacleGrid::tileBounds(int column, int row) const {
+    return sf::FloatRect({ area.position.x + column * tile, area.position.y + row * tile }, { tile, tile });
+}
+
+const std::vector<std::uint64_t>& ObstacleGrid::bitsFor(ObstacleLayer layer) const {
+    return layer == ObstacleLayer::Projectiles ? opaque : solid;
+}
+
+bool ObstacleGrid::testBit(const std::vector<std::uint64_t>& bits, int column, int row) const {
+    if (column < 0 || row < 0 || column >= cols || row >= rowCount) return false;
+    return (bits[static_cast<std::size_t>(row) * wordsPerRow + column / 64] >> (column % 64)) & 1ull;
+}
+
+bool ObstacleGrid::rowRangeBlocked(const std::vector<std::uint64_t>& bits, int row, int firstColumn, int lastColumn) const {
+    const std::uint64_t* words = bits.data() + static_cast<std::size_t>(row) * wordsPerRow;
+    for (int w = firstColumn / 64; w <= lastColumn / 64; ++w) {
+        int first = std::max(firstColumn, w * 64) - w * 64;
+        int last = std::min(lastColumn, w * 64 + 63) - w * 64;
+        if (words[w] & bitRange(first, last)) return true;
+    }
+    return false;
+}
+
+bool ObstacleGrid::columnRangeBlocked(const std::vector<std::uint64_t>& bits, int column, int firstRow, int lastRow) const {
+    for (int row = firstRow; row <= lastRow; ++row) {
+        if (testBit(bits, column, row)) return true;
+    }
+    return false;
+}
+
+bool ObstacleGrid::tileRange(const sf::FloatRect& rect, int& c0, int& r0, int& c1, int& r1) const {
+    // Bordas exclusivas, como no checkCollision: encostar num tile nao conta
+    c0 = firstTile((rect.position.x - area.position.x) / tile);
+    r0 = firstTile((rect.position.y - area.position.y) / tile);
+    c1 = lastTile((rect.position.x + rect.size.x - area.position.x) / tile);
+    r1 = lastTile((rect.position.y + rect.size.y - area.position.y) / tile);
+    c1 = std::min(c1, cols - 1); r1 = std::min(r1, rowCount - 1);
+    return c0 <= c1 && r0 <= r1;
+}
+
+bool ObstacleGrid::blocksPoint(sf::Vector2f position, ObstacleLayer layer) const {
+    if (solidTiles == 0 || !area.contains(position)) return false;
+    int column = static_cast<int>((position.x - area.position.x) / tile);
+    int row = static_cast<int>((position.y - area.position.y) / tile);
+    return testBit(bitsFor(layer), column, row);
+}
+
+bool ObstacleGrid::overlaps(const sf::FloatRect& rect, ObstacleLayer layer) const {
+    if (solidTiles == 0) return false;
+    int c0, r0, c1, r1;
+    if (!tileRange(rect, c0, r0, c1, r1)) return false;
+    const auto& bits = bitsFor(layer);
+    if (wordsPerRow == 1) {
+        // Caso normal (ate 64 colunas): a mesma mascara serve para todas as linhas
+        const std::uint64_t mask = bitRange(c0, c1);
+        for (int row = r0; row <= r1; ++row) {
+            if (bits[row] & mask) return true;
+        }
+        return false;
+    }
+    for (int row = r0; row <= r1; ++row) {
+        if (rowRangeBlocked(bits, row, c0, c1)) return true;
+    }
+    return false;
+}
+
+bool ObstacleGrid::raycast(sf::Vector2f from, sf::Vector2f to, ObstacleLayer layer, float& hitFraction) const {
+    if (solidTiles == 0) return false;
+    const auto& bits = bitsFor(layer);
+
+    // Coordenadas em tiles; o DDA avanca sempre para a fronteira de tile mais proxima
+    const float fx = (from.x - area.position.x) / tile, fy = (from.y - area.position.y) / tile;
+    const float tx = (to.x - area.position.x) / tile, ty = (to.y - area.position.y) / tile;
+    int column = static_cast<int>(std::floor(fx)), row = static_cast<int>(std::floor(fy));
+    const int endColumn = static_cast<int>(std::floor(tx)), endRow = static_cast<int>(std::floor(ty));
+    const int stepX = tx > fx ? 1 : (tx < fx ? -1 : 0);
+    const int stepY = ty > fy ? 1 : (ty < fy ? -1 : 0);
+
+    const float spanX = std::abs(tx - fx), spanY = std::abs(ty - fy);
+    const float deltaX = stepX != 0 ? 1.f / spanX : kInf;
+    const float deltaY = stepY != 0 ? 1.f / spanY : kInf;
+    float nextX = stepX > 0 ? (column + 1 - fx) * deltaX : (stepX < 0 ? (fx - column) * deltaX : kInf);
+    float nextY = stepY > 0 ? (row + 1 - fy) * deltaY : (stepY < 0 ? (fy - row) * deltaY : kInf);
+
+    const int steps = std::abs(endColumn - column) + std::abs(endRow - row);
+    float t = 0.f;
+    for (int i = 0; ; ++i) {
+        if (testBit(bits, column, row)) {
+            hitFraction = std::min(t, 1.f);
+            return true;
+        }
+        if (i >= steps) break;
+        if (nextX < nextY) { t = nextX; nextX += deltaX; column += stepX; }
+        else { t = nextY; nextY += deltaY; row += stepY; }
+    }
+    return false;
+}
+
+sf::Vector2f ObstacleGrid::resolveMotion(const sf::FloatRect& box, sf::Vector2f motion, ObstacleLayer layer) const {
+    // Caminho rapido: nada bloqueado em toda a area varrida
+    if (solidTiles == 0 || !overlaps(sweptBounds(box, motion), layer)) return motion;
+    // Ja dentro de um obstaculo (ex.: nasceu em cima de um): deixa sair livremente
+    if (overlaps(box, layer)) return motion;
+
+    const auto& bits = bitsFor(layer);
+    sf::FloatRect current = box;
+    sf::Vector2f allowed = motion;
+
+    for (int axis = 0; axis < 2; ++axis) {
+        float& delta = axis == 0 ? allowed.x : allowed.y;
+        if (delta == 0.f) continue;
+
+        // Varrimento so neste eixo: qualquer tile bloqueado na faixa fica a frente da caixa
+        sf::FloatRect sweep = current;
+        float& sweepPos = axis == 0 ? sweep.position.x : sweep.position.y;
+        float& sweepSize = axis == 0 ? sweep.size.x : sweep.size.y;
+        if (delta < 0.f) sweepPos += delta;
+        sweepSize += std::abs(delta);
+
+        int c0, r0, c1, r1;
+        if (tileRange(sweep, c0, r0, c1, r1)) {
+            const float boxMin = axis == 0 ? current.position.x : current.position.y;
+            const float boxMax = boxMin + (axis == 0 ? current.size.x : current.size.y);
+            const float origin = axis == 0 ? area.position.x : area.position.y;
+            const int first = axis == 0 ? c0 : r0, last = axis == 0 ? c1 : r1;
+            const int step = delta > 0.f ? 1 : -1;
+
+            for (int line = delta > 0.f ? first : last; line >= first && line <= last; line += step) {
+                bool hit = axis == 0 ? columnRangeBlocked(bits, line, r0, r1) : rowRangeBlocked(bits, line, c0, c1);
+                if (!hit) continue;
+                delta = delta > 0.f
+                    ? std::max(0.f, origin + line * tile - boxMax - kContactGap)
+                    : std::min(0.f, origin + (line + 1) * tile - boxMin + kContactGap);
+                break;
+            }
+        }
+
+        if (axis == 0) current.position.x += allowed.x;
+        else current.position.y += allowed.y;
+    }
+    return allowed;
+}
+
+bool ObstacleGrid::freeTilesConnected(int startColumn, int startRow) const {
+    if (testBit(solid, startColumn, startRow)) return false;
+
+    std::vector<std::uint8_t> seen(static_cast<std::size_t>(cols) * rowCount, 0);
+    std::vector<int> open;
+    open.push_back(startRow * cols + startColumn);
+    seen[open.back()] = 1;
+    int reached = 0;
+
+    while (!open.empty()) {
+        int index = open.back();
+        open.pop_back();
+        ++reached;
+        int column = index % cols, row = index / cols;
+        for (int d = 0; d < 4; ++d) {
+            int nc = column + kDirX[d], nr = row + kDirY[d];
+            if (nc < 0 || nr < 0 || nc >= cols || nr >= rowCount) continue;
+            int next = nr * cols + nc;
+            if (seen[next] || testBit(solid, nc, nr)) continue;
+            seen[next] = 1;
+            open.push_back(next);
+        }
+    }
+    return reached == cols * rowCount - solidTiles;
+}
+
+void ObstacleGrid::generate(const ObstacleConfig& config, std::uint32_t seed) {
+    clear();
+    if (!config.enabled || config.clusters_max <= 0) return;
+
+    std::uint32_t rng = seed != 0 ? seed : 0x9E3779B9u;
+
+    // So tiles inteiros (os da borda direita/de baixo podem ficar cortados)
+    const int fullCols = static_cast<int>(area.size.x / tile);
+    const int fullRows = static_cast<int>(area.size.y / tile);
+    const int centerColumn = std::clamp(static_cast<int>(area.size.x / 2.f / tile), 0, cols - 1);
+    const int centerRow = std::clamp(static_cast<int>(area.size.y / 2.f / tile), 0, rowCount - 1);
+    const int halfCorridor = std::max(0, config.corridor_tiles / 2);
+
+    auto placeable = [&](int column, int row) {
+        if (column < 0 || row < 0 || column >= fullCols || row >= fullRows) return false;
+        if (std::abs(column - centerColumn) <= halfCorridor || std::abs(row - centerRow) <= halfCorridor) return false;
+        return kindAt(column, row) == ObstacleKind::None;
+    };
+
+    const int minClusters = std::max(0, config.clusters_min);
+    const int clusters = minClusters + randomBelow(rng, std::max(0, config.clusters_max - minClusters) + 1);
+    const int pitThreshold = static_cast<int>(config.pit_chance * 1000.f);
+
+    for (int c = 0; c < clusters; ++c) {
+        ObstacleKind kind = randomBelow(rng, 1000) < pitThreshold ? ObstacleKind::Pit : ObstacleKind::Rock;
+        int column = randomBelow(rng, std::max(1, fullCols));
+        int row = randomBelow(rng, std::max(1, fullRows));
+        const int size = 1 + randomBelow(rng, std::max(1, config.cluster_tiles_max));
+
+        // Passeio aleatorio a partir do primeiro tile; um tile que isole uma zona e desfeito
+        for (int placed = 0, attempts = 0; placed < size && attempts < size * 4; ++attempts) {
+            if (placeable(column, row)) {
+                set(column, row, kind);
+                if (freeTilesConnected(centerColumn, centerRow)) ++placed;
+                else set(column, row, ObstacleKind::None);
+            }
+            int d = randomBelow(rng, 4);
+            column += kDirX[d];
+            row += kDirY[d];
+        }
+    }
+}
+
+sf::Vector2f resolveMovement(sf::Vector2f from, sf::Vector2f to, const HitboxConfig& shape,
+    const sf::FloatRect& bounds, const ObstacleGrid* obstacles) {
+    to = clampToBounds(to, shape, bounds);
+    if (!obstacles || obstacles->empty()) return to;
+    sf::Vector2f motion = obstacles->resolveMotion(makeHitbox(from, shape), to - from, ObstacleLayer::Movement);
+    return from + motion;
+}
@@ -3,7 +3,10 @@
 #include "ConfigManager.hpp"
 #include "AssetManager.hpp"
 #include "Monstro.hpp"
-#include <iostream>
+#include "JobSystem.hpp"
+#include "Collision.hpp"
+#include "EventBus.hpp"
+#include "Logger.hpp"
 #include <cstdlib>
 #include <ctime>
 #include <algorithm>
@@ -11,58 +14,59 @@
 #include <SFML/Window/Keyboard.hpp>
 #include <SFML/Graphics/RectangleShape.hpp>
 
-Room::Room(int id, RoomType type, const sf::FloatRect& gameBounds)
+Room::Room(int id, RoomType type, const sf::FloatRect& gameBounds, std::uint32_t seed)
     : roomID(id)
     , type(type)
     , gameBounds(gameBounds)
+    , seed(seed)
     , cleared(type == RoomType::SafeZone)
     , doorsOpened(type == RoomType::SafeZone)
 {
+    const auto& gameConfig = ConfigManager::getInstance().getConfig().game;
+
+    // Só as salas normais têm obstáculos (o Monstro salta pela sala toda)
+    obstacles.configure(gameBounds, gameConfig.obstacles.tile_size);
+    if (type == RoomType::Normal) {
+        obstacles.generate(gameConfig.obstacles, seed);
+    }
+
+    useSteering = gameConfig.steering.enabled;
+    crowd.configure(gameConfig.steering);
+
+    const auto& navigation = gameConfig.navigation;
+    useFlowField = navigation.flow_field;
+    if (useFlowField) {
+        flowField.configure(gameBounds, navigation.cell_size);
+        // Célula bloqueada se tocar num tile sólido (encolhida 1px para não apanhar o vizinho)
+        for (int row = 0; row < flowField.rows(); ++row) {
+            for (int column = 0; column < flowField.columns(); ++column) {
+                sf::FloatRect cellRect = flowField.cellBounds(column, row);
+                cellRect.position += sf::Vector2f(1.f, 1.f);
+                cellRect.size -= sf::Vector2f(2.f, 2.f);
+                flowField.setBlocked(column, row, obstacles.overlaps(cellRect, ObstacleLayer::Movement));
+            }
+        }
+    }
+}
+
+namespace {
+    const DoorVisualConfig& doorVisual(DoorType doorType) {
+        const auto& config = ConfigManager::getInstance().getConfig();
+        if (doorType == DoorType::Boss) return config.game.door_boss;
+        if (doorType == DoorType::Treasure) return config.game.door_treasure;
+        return config.game.door_normal;
+    }
 }
 
 void Room::addDoor(DoorDirection direction, DoorType doorType, sf::Texture& doorSpritesheet) {
     Door door;
     door.direction = direction;
     door.type = doorType;
+    doorSheet = &doorSpritesheet;
 
-    const auto& config = ConfigManager::getInstance().getConfig();
-    const auto* doorConfig = &config.game.door_normal;
+    const DoorVisualConfig& doorConfig = doorVisual(doorType);
     const float bossOffsetY = (type == RoomType::Boss) ? 2.0f : 0.0f;
 
-    if (doorType == DoorType::Boss) doorConfig = &config.game.door_boss;
-    else if (doorType == DoorType::Treasure) doorConfig = &config.game.door_treasure;
-
-    door.sprite.emplace(doorSpritesheet);
-    sf::IntRect textureRect({ doorConfig->frame_start_x, doorConfig->frame_start_y },
-        { doorConfig->texture_width, doorConfig->texture_height });
-    door.sprite->setTextureRect(textureRect);
-    door.sprite->setOrigin({ (float)doorConfig->origin_x, (float)doorConfig->origin_y });
-    door.sprite->setScale({ doorConfig->scale_x, doorConfig->scale_y });
-
-    door.leftHalf.emplace(doorSpritesheet);
-    sf::IntRect leftRect({ doorConfig->left_half_x, doorConfig->left_half_y },
-        { doorConfig->left_half_width, doorConfig->left_half_height });
-    door.leftHalf->setTextureRect(leftRect);
-    door.leftHalf->setOrigin({ (float)doorConfig->left_half_width, doorConfig->left_half_height / 2.0f });
-    door.leftHalf->setScale({ doorConfig->scale_x, doorConfig->scale_y });
-    door.leftHalfOriginalRect = leftRect;
-
-    door.rightHalf.emplace(doorSpritesheet);
-    sf::IntRect rightRect({ doorConfig->right_half_x, doorConfig->right_half_y },
-        { doorConfig->right_half_width, doorConfig->right_half_height });
-    door.rightHalf->setTextureRect(rightRect);
-    door.rightHalf->setOrigin({ 0.0f, doorConfig->right_half_height / 2.0f });
-    door.rightHalf->setScale({ doorConfig->scale_x, doorConfig->scale_y });
-    door.rightHalfOriginalRect = rightRect;
-
-    door.overlaySprite.emplace(doorSpritesheet);
-    sf::IntRect overlayRect = (doorType == DoorType::Treasure) ? sf::IntRect({ 188, 0 }, { 49, 38 }) :
-        (doorType == DoorType::Boss) ? sf::IntRect({ 318, 0 }, { 49, 43 }) :
-        sf::IntRect({ 65, 0 }, { 49, 33 });
-    door.overlaySprite->setTextureRect(overlayRect);
-    door.overlaySprite->setOrigin(door.sprite->getOrigin());
-    door.overlaySprite->setScale(door.sprite->getScale());
-
     if (this->type == RoomType::SafeZone || this->type == RoomType::Treasure || this->type == RoomType::Boss) {
         door.isOpen = true; door.state = DoorState::Open; door.animationProgress = 1.0f;
     }
@@ -70,93 +74,373 @@ void Room::addDoor(DoorDirection direction, DoorType doorType, sf::Texture& door
         door.isOpen = false; door.state = DoorState::Closed; door.animationProgress = 0.0f;
     }
 
-    sf::Vector2f position = getDoorPosition(direction);
-    position.y += bossOffsetY;
-    door.sprite->setPosition(position);
-    door.overlaySprite->setPosition(position);
+    door.position = getDoorPosition(direction);
+    door.position.y += bossOffsetY;
+    door.rotation = getDoorRotation(direction);
 
-    sf::Vector2f halvesOffset(0.f, 0.f);
-    if (direction == DoorDirection::North) halvesOffset.y = -50.f;
-    else if (direction == DoorDirection::South) halvesOffset.y = 50.f;
-    else if (direction == DoorDirection::East)  halvesOffset.x = 50.f;
-    else if (direction == DoorDirection::West)  halvesOffset.x = -50.f;
-    halvesOffset.y += bossOffsetY;
+    // Hitbox igual aos bounds globais do sprite, sem o criar (mesma origem/escala/rotação)
+    sf::Transformable frame;
+    frame.setOrigin({ (float)doorConfig.origin_x, (float)doorConfig.origin_y });
+    frame.setScale({ doorConfig.scale_x, doorConfig.scale_y });
+    frame.setRotation(sf::degrees(door.rotation));
+    frame.setPosition(door.position);
+    door.bounds = frame.getTransform().transformRect(sf::FloatRect({ 0.f, 0.f }, { (float)doorConfig.texture_width, (float)doorConfig.texture_height }));
 
-    door.leftHalf->setPosition(position + halvesOffset);
-    door.rightHalf->setPosition(position + halvesOffset);
+    doors.push_back(door);
+    doorSpritesReady = false;
+}
 
-    float rotation = getDoorRotation(direction);
-    door.sprite->setRotation(sf::degrees(rotation));
-    door.overlaySprite->setRotation(sf::degrees(rotation));
-    door.leftHalf->setRotation(sf::degrees(rotation));
-    door.rightHalf->setRotation(sf::degrees(rotation));
+void Room::buildDoorSprites() {
+    doorSpritesReady = true;
+    if (!doorSheet) return;
+    const float bossOffsetY = (type == RoomType::Boss) ? 2.0f : 0.0f;
 
-    door.bounds = door.sprite->getGlobalBounds();
-    doors.push_back(door);
+    for (Door& door : doors) {
+        if (door.sprite) continue;
+        const DoorVisualConfig& doorConfig = doorVisual(door.type);
+
+        door.sprite.emplace(*doorSheet);
+        sf::IntRect textureRect({ doorConfig.frame_start_x, doorConfig.frame_start_y },
+            { doorConfig.texture_width, doorConfig.texture_height });
+        door.sprite->setTextureRect(textureRect);
+        door.sprite->setOrigin({ (float)doorConfig.origin_x, (float)doorConfig.origin_y });
+        door.sprite->setScale({ doorConfig.scale_x, doorConfig.scale_y });
+
+        door.leftHalf.emplace(*doorSheet);
+        sf::IntRect leftRect({ doorConfig.left_half_x, doorConfig.left_half_y },
+            { doorConfig.left_half_width, doorConfig.left_half_height });
+        door.leftHalf->setTextureRect(leftRect);
+        door.leftHalf->setOrigin({ (float)doorConfig.left_half_width, doorConfig.left_half_height / 2.0f });
+        door.leftHalf->setScale({ doorConfig.scale_x, doorConfig.scale_y });
+        door.leftHalfOriginalRect = leftRect;
+
+        door.rightHalf.emplace(*doorSheet);
+        sf::IntRect rightRect({ doorConfig.right_half_x, doorConfig.right_half_y },
+            { doorConfig.right_half_width, doorConfig.right_half_height });
+        door.rightHalf->setTextureRect(rightRect);
+        door.rightHalf->setOrigin({ 0.0f, doorConfig.right_half_height / 2.0f });
+        door.rightHalf->setScale({ doorConfig.scale_x, doorConfig.scale_y });
+        door.rightHalfOriginalRect = rightRect;
+
+        door.overlaySprite.emplace(*doorSheet);
+        sf::IntRect overlayRect = (door.type == DoorType::Treasure) ? sf::IntRect({ 188, 0 }, { 49, 38 }) :
+            (door.type == DoorType::Boss) ? sf::IntRect({ 318, 0 }, { 49, 43 }) :
+            sf::IntRect({ 65, 0 }, { 49, 33 });
+        door.overlaySprite->setTextureRect(overlayRect);
+        door.overlaySprite->setOrigin(door.sprite->getOrigin());
+        door.overlaySprite->setScale(door.sprite->getScale());
+
+        door.sprite->setPosition(door.position);
+        door.overlaySprite->setPosition(door.position);
+
+        sf::Vector2f halvesOffset(0.f, 0.f);
+        if (door.direction == DoorDirection::North) halvesOffset.y = -50.f;
+        else if (door.direction == DoorDirection::South) halvesOffset.y = 50.f;
+        else if (door.direction == DoorDirection::East)  halvesOffset.x = 50.f;
+        else if (door.direction == DoorDirection::West)  halvesOffset.x = -50.f;
+        halvesOffset.y += bossOffsetY;
+
+        door.leftHalf->setPosition(door.position + halvesOffset);
+        door.rightHalf->setPosition(door.position + halvesOffset);
+
+        door.sprite->setRotation(sf::degrees(door.rotation));
+        door.overlaySprite->setRotation(sf::degrees(door.rotation));
+        door.leftHalf->setRotation(sf::degrees(door.rotation));
+        door.rightHalf->setRotation(sf::degrees(door.rotation));
+    }
 }
 
-void Room::spawnEnemies(std::vector<sf::Texture>& dDown, std::vector<sf::Texture>& dUp,
-    std::vector<sf::Texture>& dLeft, std::vector<sf::Texture>& dRight,
-    sf::Texture& dProj, std::vector<sf::Texture>& bTex,
-    sf::Texture& cSheet, sf::Texture& cProj) {
+void Room::rollRoster(std::mt19937& rng, const DungeonConfig::FloorConfig& floor) {
+    roster.clear();
+    healthMultiplier = floor.enemy_health_multiplier;
+    if (type != RoomType::Normal && type != RoomType::Boss) return;
 
-    if (type == RoomType::SafeZone || type == RoomType::Treasure || cleared) return;
-    if (!demons.empty() || !bishops.empty() || !chubbies.empty() || !monstros.empty()) return;
+    const auto& config = ConfigManager::getInstance().getConfig();
+    auto roll = [&](int count) { return std::uniform_int_distribution<int>(0, count - 1)(rng); };
+
+    // Arquétipo escolhido pelo spawn_weight (variantes do config.json entram aqui sem recompilar)
+    const ArchetypeTable& archetypes = config.archetypes;
+    auto pickArchetype = [&](ArchetypeKind kind) -> int {
+        int total = archetypes.totalWeight(kind);
+        if (total <= 0) {
+            LOG_ERROR(LogCategory::Rooms, "nenhum arquetipo com spawn_weight > 0 para este tipo de inimigo");
+            return -1;
+        }
+        return static_cast<int>(archetypes.pick(kind, roll(total)));
+        };
 
-    const auto& dConfigTear = ConfigManager::getInstance().getConfig().projectile_textures.demon_tear;
-    sf::IntRect demonTearRect({ dConfigTear.x, dConfigTear.y }, { dConfigTear.width, dConfigTear.height });
+    // Sorteia outra vez se nascer em cima de um obstáculo
+    auto randomSpawn = [&](const HitboxConfig& hitbox) {
+        const float margin = 200.f;
+        sf::Vector2f spawn;
+        int tries = 0;
+        do {
+            float rx = margin + static_cast<float>(roll(static_cast<int>(gameBounds.size.x - margin * 2)));
+            float ry = margin + static_cast<float>(roll(static_cast<int>(gameBounds.size.y - margin * 2)));
+            spawn = { gameBounds.position.x + rx, gameBounds.position.y + ry };
+        } while (obstacles.overlaps(makeHitbox(spawn, hitbox), ObstacleLayer::Movement) && ++tries < 16);
+        return spawn;
+        };
 
-    if (type == RoomType::Boss) {
-        sf::Texture& monstroTex = AssetManager::getInstance().getTexture("MonstroSheet");
-        sf::Vector2f centerPos = {
-            gameBounds.position.x + gameBounds.size.x / 2.f,
-            gameBounds.position.y + gameBounds.size.y / 2.f
+    auto addSpawn = [&](SpawnKind kind, int archetype, sf::Vector2f position) {
+        EnemySpawn spawn;
+        spawn.kind = kind;
+        spawn.archetype = static_cast<std::uint16_t>(std::max(archetype, 0));
+        spawn.position = position;
+        roster.push_back(spawn);
         };
-        auto boss = std::make_unique<Monstro>(monstroTex, dProj, centerPos);
-        monstros.push_back(std::move(boss));
-    }
-    else if (type == RoomType::Normal) {
-        int enemyLogic = rand() % 100;
-
-        if (enemyLogic < 40) { // 40% Sala de Chubbies
-            int count = 2 + (rand() % 2);
-            for (int i = 0; i < count; i++) {
-                auto chubby = std::make_unique<Chubby>(cSheet, cProj);
-                float margin = 200.f;
-                float rx = margin + static_cast<float>(rand() % static_cast<int>(gameBounds.size.x - margin * 2));
-                float ry = margin + static_cast<float>(rand() % static_cast<int>(gameBounds.size.y - margin * 2));
-                chubby->setPosition({ gameBounds.position.x + rx, gameBounds.position.y + ry });
-                chubbies.push_back(std::move(chubby));
-            }
-            // Agora spawna Bishop na sala de Chubbies também
-            bishops.push_back(std::make_unique<Bishop_ALL>(bTex));
-        }
-        else { // 60% Sala de Demons
-            auto demon = std::make_unique<Demon_ALL>(dDown, dUp, dLeft, dRight, dProj);
-            demon->setProjectileTextureRect(demonTearRect);
-            demons.push_back(std::move(demon));
-            // Bishop padrão na sala de Demons
-            bishops.push_back(std::make_unique<Bishop_ALL>(bTex));
+
+    if (type == RoomType::Boss) {
+        int bossType = pickArchetype(ArchetypeKind::Monstro);
+        if (bossType < 0) return;
+        addSpawn(SpawnKind::Monstro, bossType, gameBounds.position + gameBounds.size / 2.f);
+        return;
+    }
+
+    if (roll(100) < floor.chubby_room_chance) { // Sala de Chubbies
+        int count = 2 + roll(2) + floor.extra_enemies;
+        for (int i = 0; i < count; i++) {
+            int chubbyType = pickArchetype(ArchetypeKind::Chubby);
+            if (chubbyType < 0) break;
+            addSpawn(SpawnKind::Chubby, chubbyType, randomSpawn(archetypes.at(chubbyType).hitbox));
         }
+    }
+    else { // Sala de Demons (o primeiro no sítio do config, os extra ao acaso)
+        addSpawn(SpawnKind::Demon, 0, { config.demon.spawn.start_position_x, config.demon.spawn.start_position_y });
+        for (int i = 0; i < floor.extra_enemies; i++) addSpawn(SpawnKind::Demon, 0, randomSpawn(config.demon.hitbox));
+    }
 
-        // Ajusta posição do Bishop (evita nascer em cima do spawn do player)
-        if (!bishops.empty()) {
-            bishops.back()->setPosition({ gameBounds.position.x + gameBounds.size.x / 2.f, gameBounds.position.y + 150.f });
+    // Bishop em todas as salas normais (longe do spawn do player)
+    addSpawn(SpawnKind::Bishop, 0, { gameBounds.position.x + gameBounds.size.x / 2.f, gameBounds.position.y + 150.f });
+}
+
+void Room::setRoster(std::vector<EnemySpawn> spawns, float enemyHealthMultiplier) {
+    roster = std::move(spawns);
+    healthMultiplier = enemyHealthMultiplier;
+}
+
+void Room::spawnEnemies(const EnemyTextures& textures) {
+    if (type == RoomType::SafeZone || type == RoomType::Treasure || cleared || enemiesSpawned) return;
+    enemiesSpawned = true;
+
+    for (std::size_t i = 0; i < roster.size(); ++i) {
+        EnemyBase* enemy = createEnemy(roster[i], textures);
+        if (!enemy) continue;
+        enemy->seedRandom((seed ^ 0x85EBCA6Bu) + static_cast<std::uint32_t>(i) * 2654435761u);
+        if (healthMultiplier != 1.f) enemy->scaleHealth(healthMultiplier);
+    }
+}
+
+EnemyBase* Room::createEnemy(const EnemySpawn& spawn, const EnemyTextures& textures) {
+    const auto& config = ConfigManager::getInstance().getConfig();
+    const ArchetypeTable& archetypes = config.archetypes;
+
+    switch (spawn.kind) {
+    case SpawnKind::Monstro:
+        monstros.push_back(std::make_unique<Monstro>(archetypes.at(spawn.archetype), *textures.monstroSheet, *textures.demonProjectile, spawn.position));
+        return monstros.back().get();
+    case SpawnKind::Chubby: {
+        auto chubby = std::make_unique<Chubby>(archetypes.at(spawn.archetype), *textures.chubbySheet, *textures.chubbyProjectile);
+        chubby->setPosition(spawn.position);
+        chubbies.push_back(std::move(chubby));
+        return chubbies.back().get();
+    }
+    case SpawnKind::Demon: {
+        const auto& dConfigTear = config.projectile_textures.demon_tear;
+        auto demon = std::make_unique<Demon_ALL>(*textures.demonDown, *textures.demonUp, *textures.demonLeft,
+            *textures.demonRight, *textures.demonProjectile);
+        demon->setProjectileTextureRect(sf::IntRect({ dConfigTear.x, dConfigTear.y }, { dConfigTear.width, dConfigTear.height }));
+        demon->setPosition(spawn.position);
+        demons.push_back(std::move(demon));
+        return demons.back().get();
+    }
+    case SpawnKind::Bishop:
+        bishops.push_back(std::make_unique<Bishop_ALL>(*textures.bishop));
+        bishops.back()->setPosition(spawn.position);
+        return bishops.back().get();
+    }
+    return nullptr;
+}
+
+void Room::captureState(RoomState& state, std::vector<DoorSaveState>& doorStates,
+    std::vector<EnemyState>& enemies, std::vector<ProjectileState>& projectiles, bool liveOnly) const {
+    state.cleared = cleared ? 1 : 0;
+    state.doorsOpened = doorsOpened ? 1 : 0;
+    state.trapdoorOpen = trapdoorOpen ? 1 : 0;
+    state.spawned = enemiesSpawned ? 1 : 0;
+
+    state.doorBegin = static_cast<std::uint16_t>(doorStates.size());
+    state.doorCount = static_cast<std::uint16_t>(doors.size());
+    for (const Door& door : doors) {
+        DoorSaveState saved;
+        saved.state = static_cast<std::uint8_t>(door.state);
+        saved.isOpen = door.isOpen ? 1 : 0;
+        saved.animationProgress = door.animationProgress;
+        doorStates.push_back(saved);
+    }
+
+    // No save só os vivos (os mortos não voltam a contar para nada)
+    state.enemyBegin = static_cast<std::uint32_t>(enemies.size());
+    auto capture = [&](const auto& list, SpawnKind kind) {
+        for (const auto& e : list) {
+            if (liveOnly && e->getHealth() <= 0) continue;
+            EnemyState saved;
+            saved.kind = static_cast<std::uint8_t>(kind);
+            e->saveState(saved, projectiles);
+            enemies.push_back(saved);
         }
+        };
+    capture(demons, SpawnKind::Demon);
+    capture(bishops, SpawnKind::Bishop);
+    capture(chubbies, SpawnKind::Chubby);
+    capture(monstros, SpawnKind::Monstro);
+    state.enemyCount = static_cast<std::uint32_t>(enemies.size()) - state.enemyBegin;
+}
+
+void Room::restoreState(const RoomState& state, const DoorSaveState* doorStates,
+    const EnemyState* enemies, const ProjectileState* projectiles, const EnemyTextures& textures) {
+    cleared = state.cleared != 0;
+    doorsOpened = state.doorsOpened != 0;
+    trapdoorOpen = state.trapdoorOpen != 0;
+
+    for (std::size_t i = 0; i < doors.size() && i < state.doorCount; ++i) {
+        const DoorSaveState& saved = doorStates[state.doorBegin + i];
+        doors[i].state = static_cast<DoorState>(std::min<std::uint8_t>(saved.state, static_cast<std::uint8_t>(DoorState::Opening)));
+        doors[i].isOpen = saved.isOpen != 0;
+        doors[i].animationProgress = saved.animationProgress;
+    }
+
+    // Os mesmos inimigos pela mesma ordem: só o estado é reposto, nada é construído
+    if (restoresInPlace(state, enemies)) {
+        std::uint32_t next = state.enemyBegin;
+        auto load = [&](auto& list) {
+            for (auto& e : list) {
+                const EnemyState& saved = enemies[next++];
+                e->loadState(saved, projectiles + saved.projectileBegin);
+            }
+            };
+        load(demons);
+        load(bishops);
+        load(chubbies);
+        load(monstros);
+        return;
+    }
+
+    demons.clear();
+    bishops.clear();
+    chubbies.clear();
+    monstros.clear();
+    enemiesSpawned = state.spawned != 0;
+    if (!enemiesSpawned) return;
+
+    for (std::uint32_t i = 0; i < state.enemyCount; ++i) {
+        const EnemyState& saved = enemies[state.enemyBegin + i];
+        EnemySpawn spawn;
+        spawn.kind = static_cast<SpawnKind>(saved.kind);
+        spawn.archetype = saved.archetype;
+        spawn.position = saved.position;
+        if (EnemyBase* enemy = createEnemy(spawn, textures)) enemy->loadState(saved, projectiles + saved.projectileBegin);
     }
 }
 
-void Room::update(float deltaTime, sf::Vector2f playerPosition) {
-    for (auto& d : demons) if (d->getHealth() > 0) d->update(deltaTime, playerPosition, gameBounds);
-    for (auto& b : bishops) if (b->getHealth() > 0) b->update(deltaTime, playerPosition, gameBounds);
-    for (auto& c : chubbies) if (c->getHealth() > 0) c->update(deltaTime, playerPosition, gameBounds);
-    for (auto& m : monstros) if (m->getHealth() > 0) m->update(deltaTime, playerPosition, gameBounds);
+bool Room::restoresInPlace(const RoomState& state, const EnemyState* enemies) const {
+    if (!enemiesSpawned || state.spawned == 0) return false;
+    std::size_t counts[4] = {};
+    for (std::uint32_t i = 0; i < state.enemyCount; ++i) {
+        const EnemyState& saved = enemies[state.enemyBegin + i];
+        if (saved.kind >= 4) return false;
+        // captureState escreve as listas por ordem: um tipo fora de ordem é outra sala
+        if (i > 0 && saved.kind < enemies[state.enemyBegin + i - 1].kind) return false;
+        ++counts[saved.kind];
+    }
+    return counts[static_cast<int>(SpawnKind::Demon)] == demons.size() &&
+        counts[static_cast<int>(SpawnKind::Bishop)] == bishops.size() &&
+        counts[static_cast<int>(SpawnKind::Chubby)] == chubbies.size() &&
+        counts[static_cast<int>(SpawnKind::Monstro)] == monstros.size();
+}
 
+void Room::update(float deltaTime, sf::Vector2f playerPosition) {
+    updateEnemies(deltaTime, playerPosition, true);
     updateDoorAnimations(deltaTime);
     checkIfCleared();
 }
 
+void Room::updateBackground(float deltaTime, sf::Vector2f targetPosition) {
+    updateEnemies(deltaTime, targetPosition, false);
+}
+
+void Room::updateEnemies(float deltaTime, sf::Vector2f playerPosition, bool foreground) {
+    aiTargets.clear();
+    auto gather = [&](auto& list) { for (auto& e : list) if (e->getHealth() > 0) aiTargets.push_back(e.get()); };
+    gather(demons);
+    gather(bishops);
+    gather(chubbies);
+    gather(monstros);
+    if (aiTargets.empty()) return;
+
+    // Todos os playheads da sala avançam num só passo, antes da IA (que lê os eventos)
+    animationTargets.clear();
+    for (EnemyBase* e : aiTargets) {
+        animationTargets.push_back(&e->getAnimation());
+        e->updateStatus(deltaTime);
+    }
+    advanceAnimations(animationTargets, deltaTime);
+
+    // Só recalcula quando o alvo muda de célula; os inimigos leem-no em paralelo
+    if (useFlowField) flowField.setTarget(playerPosition);
+
+    // Posições de todos antes de alguém se mexer: os updates em paralelo só leem isto.
+    // É também o índice espacial onde as auras do tick são resolvidas.
+    crowd.begin(gameBounds, &obstacles);
+    for (EnemyBase* e : aiTargets) {
+        const sf::FloatRect& box = e->getHitbox();
+        crowd.add(box.position + box.size / 2.f, (box.size.x + box.size.y) / 4.f);
+    }
+    crowd.finish();
+
+    for (std::size_t i = 0; i < aiTargets.size(); ++i) {
+        EnemyBase* e = aiTargets[i];
+        e->setFlowField(useFlowField ? &flowField : nullptr);
+        e->setObstacles(&obstacles);
+        e->setCrowd(useSteering ? &crowd : nullptr, static_cast<int>(i));
+    }
+
+    const auto& parallelConfig = ConfigManager::getInstance().getConfig().game.parallel;
+    JobSystem& jobs = JobSystem::getInstance();
+    const std::size_t chunkSize = static_cast<std::size_t>(std::max(1, parallelConfig.ai_chunk_size));
+    const bool runParallel = foreground && parallelAI && parallelConfig.parallel_ai && jobs.workerCount() > 0 &&
+        aiTargets.size() >= static_cast<std::size_t>(std::max(1, parallelConfig.ai_min_parallel_enemies));
+
+    // Cada inimigo só mexe no seu próprio estado (incluindo os seus projéteis);
+    // o que afeta outros inimigos vai para o buffer do bloco
+    const std::size_t chunks = runParallel ? JobSystem::blockCount(aiTargets.size(), chunkSize) : 1;
+    if (aiCommands.size() < chunks) aiCommands.resize(chunks);
+    for (std::size_t c = 0; c < chunks; ++c) aiCommands[c].clear();
+
+    auto runChunk = [&](std::size_t begin, std::size_t end, std::size_t chunk) {
+        for (std::size_t i = begin; i < end; ++i) {
+            aiTargets[i]->update(deltaTime, playerPosition, gameBounds);
+            aiTargets[i]->emitCommands(aiCommands[chunk]);
+        }
+        };
+
+    if (runParallel) jobs.parallelFor(aiTargets.size(), chunkSize, runChunk);
+    else runChunk(0, aiTargets.size(), 0);
+
+    // Junta os buffers pela ordem dos blocos = mesma ordem do modo em série,
+    // e resolve as auras todas numa só passagem
+    pendingAuras.clear();
+    for (std::size_t c = 0; c < chunks; ++c) {
+        pendingAuras.insert(pendingAuras.end(), aiCommands[c].auras.begin(), aiCommands[c].auras.end());
+    }
+    // Só a sala ativa (thread principal) publica no bus; as de fundo aplicam logo
+    if (!pendingAuras.empty()) resolveAuras(pendingAuras, crowd, aiTargets, foreground ? &EventBus::getInstance() : nullptr);
+}
+
 void Room::draw(sf::RenderWindow& window) {
+    if (!doorSpritesReady) buildDoorSprites();
+    drawObstacles(window);
+    drawTrapdoor(window);
     for (const auto& door : doors) drawDoor(window, door);
 
     for (auto& d : demons) if (d->getHealth() > 0) d->draw(window);
@@ -165,6 +449,44 @@ void Room::draw(sf::RenderWindow& window) {
     for (auto& m : monstros) if (m->getHealth() > 0) m->draw(window);
 }
 
+void Room::drawObstacles(sf::RenderWindow& window) const {
+    if (obstacles.empty()) return;
+    sf::RectangleShape shape({ obstacles.tileSize(), obstacles.tileSize() });
+    shape.setOutlineThickness(-3.f);
+    for (int row = 0; row < obstacles.rows(); ++row) {
+        for (int column = 0; column < obstacles.columns(); ++column) {
+            ObstacleKind kind = obstacles.kindAt(column, row);
+            if (kind == ObstacleKind::None) continue;
+            if (kind == ObstacleKind::Rock) {
+                shape.setFillColor(sf::Color(112, 100, 92));
+                shape.setOutlineColor(sf::Color(70, 60, 54));
+            }
+            else {
+                shape.setFillColor(sf::Color(18, 14, 12));
+                shape.setOutlineColor(sf::Color(48, 38, 32));
+            }
+            shape.setPosition(obstacles.tileBounds(column, row).position);
+            window.draw(shape);
+        }
+    }
+}
+
+sf::FloatRect Room::getTrapdoorBounds() const {
+    const sf::Vector2f size(96.f, 96.f);
+    return sf::FloatRect(gameBounds.position + (gameBounds.size - size) / 2.f, size);
+}
+
+void Room::drawTrapdoor(sf::RenderWindow& window) const {
+    if (!trapdoorOpen) return;
+    const sf::FloatRect bounds = getTrapdoorBounds();
+    sf::RectangleShape shape(bounds.size);
+    shape.setPosition(bounds.position);
+    shape.setFillColor(sf::Color(10, 6, 4));
+    shape.setOutlineColor(sf::Color(92, 64, 40));
+    shape.setOutlineThickness(-6.f);
+    window.draw(shape);
+}
+
 void Room::drawDoor(sf::RenderWindow& window, const Door& door) const {
     if (!door.sprite || !door.overlaySprite) return;
     window.draw(*door.sprite);
@@ -199,6 +521,11 @@ void Room::checkIfCleared() {
     if (dead(demons) && dead(bishops) && dead(chubbies) && dead(monstros)) {
         cleared = true;
         openDoors();
+        if (type == RoomType::Boss) trapdoorOpen = true;
+        GameEvent event;
+        event.type = GameEventType::RoomClear;
+        event.roomId = roomID;
+        EventBus::getInstance().publish(event);
     }
 }
 
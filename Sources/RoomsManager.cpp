@@ -1,16 +1,18 @@
 ﻿#include "RoomsManager.hpp"
+#include "DungeonCache.hpp"
 #include "enemy.hpp"
 #include "Utils.hpp"
-#include <iostream>
+#include "Logger.hpp"
 #include <algorithm>
 #include <cstdlib>
 #include <ctime>
 #include <random> 
 #include <map>
+#include <chrono>
 #include <SFML/System/Vector2.hpp> 
 
 RoomManager::RoomManager(AssetManager& assetManager, const sf::FloatRect& gameBounds)
-    : assets(assetManager)
+    : assets(&assetManager)
     , gameBounds(gameBounds)
     , currentRoom(nullptr)
     , currentRoomID(0)
@@ -23,110 +25,216 @@ RoomManager::RoomManager(AssetManager& assetManager, const sf::FloatRect& gameBo
 {
     std::srand((unsigned int)std::time(nullptr));
     const auto& config = ConfigManager::getInstance().getConfig();
+
+    handles.door = assets->findTexture(AssetIds::Door);
+    handles.tears = assets->findTexture(AssetIds::TearAtlas);
+    handles.chubby = assets->findTexture(AssetIds::ChubbySheet);
+    handles.monstro = assets->findTexture(AssetIds::MonstroSheet);
+    handles.demonDown = assets->findAnimation(AssetIds::DemonDown);
+    handles.demonUp = assets->findAnimation(AssetIds::DemonUp);
+    handles.demonLeft = assets->findAnimation(AssetIds::DemonLeft);
+    handles.demonRight = assets->findAnimation(AssetIds::DemonRight);
+    handles.bishop = assets->findAnimation(AssetIds::Bishop);
+
     transitionOverlay.setSize({ (float)config.game.window_width, (float)config.game.window_height });
     transitionOverlay.setFillColor(sf::Color(0, 0, 0, 0));
 }
 
-sf::Vector2i getNextCoord(const sf::Vector2i& current, DoorDirection direction) {
-    if (direction == DoorDirection::North) return { current.x, current.y - 1 };
-    if (direction == DoorDirection::South) return { current.x, current.y + 1 };
-    if (direction == DoorDirection::East)  return { current.x + 1, current.y };
-    if (direction == DoorDirection::West)  return { current.x - 1, current.y };
-    return current;
+RoomManager::RoomManager(const EnemyTextures& textures, sf::Texture& doorTexture, const sf::FloatRect& gameBounds)
+    : assets(nullptr)
+    , headless(true)
+    , fixedTextures(textures)
+    , fixedDoorTexture(&doorTexture)
+    , gameBounds(gameBounds)
+    , currentRoom(nullptr)
+    , currentRoomID(0)
+    , nextRoomID(-1)
+    , transitionState(TransitionState::None)
+    , transitionDirection(DoorDirection::None)
+    , transitionProgress(0.f)
+    , transitionDuration(ConfigManager::getInstance().getConfig().game.dungeon.transition_duration)
+    , rng(rd())
+{
+    transitionOverlay.setFillColor(sf::Color(0, 0, 0, 0));
 }
 
-void RoomManager::generateDungeon(int numRooms) {
-    rooms.clear();
-    coordToRoomID.clear();
-    visitedRooms.clear();
-    sf::Texture& doorTexture = assets.getTexture("Door");
-    int nextAvailableRoomID = 0;
-
-    // Criar Sala Inicial
-    createRoom(nextAvailableRoomID, RoomType::SafeZone);
-    coordToRoomID[{0, 0}] = nextAvailableRoomID++;
-
-    std::vector<sf::Vector2i> availableCoords = { {0, 0} };
-
-    // Gerar corpo principal da dungeon
-    while (nextAvailableRoomID < numRooms - 2 && !availableCoords.empty()) {
-        std::uniform_int_distribution<> coordDist(0, (int)availableCoords.size() - 1);
-        sf::Vector2i parentCoord = availableCoords[coordDist(rng)];
-        int parentID = coordToRoomID[parentCoord];
-
-        std::vector<DoorDirection> dirs = { DoorDirection::North, DoorDirection::South, DoorDirection::East, DoorDirection::West };
-        std::shuffle(dirs.begin(), dirs.end(), rng);
-
-        bool roomAdded = false;
-        for (DoorDirection dir : dirs) {
-            sf::Vector2i nextCoord = getNextCoord(parentCoord, dir);
-            if (coordToRoomID.find(nextCoord) == coordToRoomID.end()) {
-                createRoom(nextAvailableRoomID, RoomType::Normal);
-                coordToRoomID[nextCoord] = nextAvailableRoomID;
-
-                rooms.at(parentID).addDoor(dir, DoorType::Normal, doorTexture);
-                rooms.at(nextAvailableRoomID).addDoor(getOppositeDirection(dir), DoorType::Normal, doorTexture);
-                connectRooms(parentID, nextAvailableRoomID, dir);
-
-                availableCoords.push_back(nextCoord);
-                nextAvailableRoomID++;
-                roomAdded = true;
-                break;
-            }
-        }
-        if (!roomAdded && parentID != 0)
-            availableCoords.erase(std::remove(availableCoords.begin(), availableCoords.end(), parentCoord), availableCoords.end());
-    }
-
-    // Lambda para colocar salas especiais (Boss e Treasure) em pontas soltas
-    auto setupSpecial = [&](RoomType rType, int rID, DoorType dType) {
-        for (auto const& [coord, id] : coordToRoomID) {
-            if (rooms.at(id).getType() != RoomType::Normal) continue;
-
-            std::vector<DoorDirection> av = { DoorDirection::North, DoorDirection::South, DoorDirection::East, DoorDirection::West };
-            for (auto const& d : rooms.at(id).getDoors())
-                av.erase(std::remove(av.begin(), av.end(), d.direction), av.end());
-
-            if (!av.empty()) {
-                std::shuffle(av.begin(), av.end(), rng);
-                createRoom(rID, rType);
-                coordToRoomID[getNextCoord(coord, av[0])] = rID;
-                rooms.at(id).addDoor(av[0], dType, doorTexture);
-                rooms.at(rID).addDoor(getOppositeDirection(av[0]), dType, doorTexture);
-                connectRooms(id, rID, av[0]);
-                return true;
-            }
+RoomManager::~RoomManager() {
+    // O job de fundo guarda ponteiros para as salas: tem de acabar antes de elas morrerem
+    try { waitForBackgroundTier(); }
+    catch (const std::exception& e) { LOG_ERROR(LogCategory::Rooms, "tier de fundo: ", e.what()); }
+    // O mesmo para o andar seguinte, que está a ser escrito num worker
+    try { waitForNextFloor(); }
+    catch (const std::exception& e) { LOG_ERROR(LogCategory::Rooms, "andar seguinte: ", e.what()); }
+}
+
+void RoomManager::generateDungeon() {
+    waitForBackgroundTier();
+    waitForNextFloor();
+    nextFloor.reset();
+
+    // Seed fixa: todos os andares da run saem dela, por isso repetem-se (e vêm da cache)
+    const std::uint32_t fixedSeed = ConfigManager::getInstance().getConfig().game.dungeon.fixed_seed;
+    seededRun = fixedSeed != 0;
+    runSeed = fixedSeed ? fixedSeed : static_cast<std::uint32_t>(rd());
+
+    Floor first;
+    buildFloor(first, 0, floorSeed(0), doorTexture());
+    enterFloor(first);
+    prepareNextFloor();
+}
+
+void RoomManager::generateDungeon(std::uint32_t seed) {
+    waitForBackgroundTier();
+    waitForNextFloor();
+    nextFloor.reset();
+
+    seededRun = true;
+    runSeed = seed;
+    Floor first;
+    buildFloor(first, 0, floorSeed(0), doorTexture());
+    enterFloor(first);
+    prepareNextFloor();
+}
+
+void RoomManager::buildFloor(Floor& floor, int index, std::uint32_t seed, sf::Texture& doorTexture) const {
+    const auto& dungeon = ConfigManager::getInstance().getConfig().game.dungeon;
+    const auto floorConfig = dungeon.floor(index);
+    floor.index = index;
+    floor.seed = seed;
+
+    // Só runs com seed fixa usam a cache: seeds aleatórias nunca se repetem
+    const auto& config = ConfigManager::getInstance().getConfig();
+    const bool useCache = !headless && dungeon.layout_cache && dungeon.fixed_seed != 0;
+    const std::uint32_t fingerprint = useCache ? layoutFingerprint(config, floorConfig) : 0;
+    const std::string cachePath = useCache ? dungeonCachePath(dungeon.layout_cache_dir, index, seed) : std::string();
+
+    DungeonLayout& layout = floor.layout;
+    const bool cached = useCache && loadCachedLayout(cachePath, index, seed, fingerprint, layout);
+    if (!cached) {
+        DungeonGenerator generator;
+        if (!generator.generate(dungeon, floorConfig, seed, layout)) {
+            LOG_WARN(LogCategory::Rooms, "andar ", index + 1, ": restricoes do gerador falharam em ", layout.attempts,
+                " tentativas (seed ", seed, "), a usar a planta relaxada");
         }
-        return false;
-        };
+    }
+    assembleFloor(floor, doorTexture);
 
-    setupSpecial(RoomType::Treasure, numRooms - 2, DoorType::Treasure);
-    setupSpecial(RoomType::Boss, numRooms - 1, DoorType::Boss);
+    if (cached) {
+        applyRosters(floor);
+        LOG_DEBUG(LogCategory::Rooms, "andar ", index + 1, " lido da cache: ", cachePath);
+        return;
+    }
+
+    // Inimigos de todas as salas sorteados já, com a dificuldade deste andar
+    for (std::size_t id = 0; id < layout.rooms.size(); ++id) {
+        Room& room = floor.rooms.at(static_cast<int>(id));
+        std::mt19937 rosterRng(layout.rooms[id].seed ^ 0x9E3779B9u);
+        room.rollRoster(rosterRng, floorConfig);
+
+        layout.rooms[id].spawnBegin = static_cast<std::uint16_t>(layout.spawns.size());
+        layout.rooms[id].spawnCount = static_cast<std::uint16_t>(room.getRoster().size());
+        layout.spawns.insert(layout.spawns.end(), room.getRoster().begin(), room.getRoster().end());
+    }
+    if (useCache) saveCachedLayout(cachePath, index, seed, fingerprint, layout);
+}
+
+void RoomManager::assembleFloor(Floor& floor, sf::Texture& doorTexture) const {
+    floor.rooms.clear();
+    floor.coordToRoomID.clear();
+    const DungeonLayout& layout = floor.layout;
+    for (std::size_t id = 0; id < layout.rooms.size(); ++id) {
+        createRoom(floor, static_cast<int>(id), layout.rooms[id]);
+        floor.coordToRoomID[layout.rooms[id].coord] = static_cast<int>(id);
+    }
+    for (const LayoutDoor& door : layout.doors) {
+        floor.rooms.at(door.from).addDoor(door.direction, door.type, doorTexture);
+        floor.rooms.at(door.to).addDoor(getOppositeDirection(door.direction), door.type, doorTexture);
+        connectRooms(floor, door.from, door.to, door.direction);
+    }
+}
+
+void RoomManager::applyRosters(Floor& floor) const {
+    const float multiplier = ConfigManager::getInstance().getConfig().game.dungeon.floor(floor.index).enemy_health_multiplier;
+    const DungeonLayout& layout = floor.layout;
+    for (std::size_t id = 0; id < layout.rooms.size(); ++id) {
+        const LayoutRoom& room = layout.rooms[id];
+        const auto first = layout.spawns.begin() + room.spawnBegin;
+        floor.rooms.at(static_cast<int>(id)).setRoster(std::vector<EnemySpawn>(first, first + room.spawnCount), multiplier);
+    }
+}
+
+std::uint32_t RoomManager::floorSeed(int index) {
+    if (!seededRun && index > 0) return static_cast<std::uint32_t>(rng());
+    return runSeed + 0x9E3779B9u * static_cast<std::uint32_t>(index);
+}
+
+void RoomManager::swapInFloor(Floor& floor) {
+    backgroundSlots.clear();
+    rooms.swap(floor.rooms);
+    coordToRoomID.swap(floor.coordToRoomID);
+    std::swap(layout, floor.layout);
+    floorIndex = floor.index;
+    currentFloorSeed = floor.seed;
+    visitedRooms.clear();
+}
+
+void RoomManager::enterFloor(Floor& floor) {
+    swapInFloor(floor);
 
     currentRoomID = 0;
     currentRoom = &rooms.at(0);
     currentRoom->openDoors();
     visitedRooms.insert(currentRoomID);
+    rebuildBackgroundTier();
+    retainRoomAssets();
+    if (!headless) LOG_INFO(LogCategory::Rooms, "andar ", floorIndex + 1, ": ", rooms.size(), " salas (seed ", floor.seed, ")");
 }
 
-void RoomManager::createRoom(int id, RoomType type) {
-    rooms.emplace(id, Room(id, type, gameBounds));
+void RoomManager::prepareNextFloor() {
+    nextFloor = std::make_unique<Floor>();
+    const int index = floorIndex + 1;
+    const std::uint32_t seed = floorSeed(index);
+    // Sem workers (ou headless) o andar é gerado na descida (enterFloor a meio do fade)
+    if (headless || JobSystem::getInstance().workerCount() == 0) {
+        nextFloor->index = -1;
+        nextFloor->seed = seed;
+        return;
+    }
+
+    Floor* target = nextFloor.get();
+    sf::Texture& door = doorTexture();
+    JobSystem::getInstance().submit([this, target, index, seed, &door] {
+        using BuildClock = std::chrono::steady_clock;
+        const auto start = BuildClock::now();
+        buildFloor(*target, index, seed, door);
+        LOG_DEBUG(LogCategory::Rooms, "andar ", index + 1, " gerado num worker em ",
+            std::chrono::duration<double, std::milli>(BuildClock::now() - start).count(), " ms");
+        }, nextFloorJob, JobLane::WorkersOnly);
+}
+
+void RoomManager::waitForNextFloor() {
+    if (!nextFloorJob.done()) JobSystem::getInstance().wait(nextFloorJob);
+}
+
+void RoomManager::createRoom(Floor& floor, int id, const LayoutRoom& layoutRoom) const {
+    Room& room = floor.rooms.emplace(id, Room(id, layoutRoom.type, gameBounds, layoutRoom.seed)).first->second;
+    room.setParallelAI(!headless);
 
     // Variantes visuais (Chão/Cantos)
-    std::vector<sf::IntRect> vars = { {{0, 0}, {234, 156}}, {{0, 156}, {234, 156}}, {{234, 0}, {234, 156}} };
+    static const sf::IntRect vars[3] = { {{0, 0}, {234, 156}}, {{0, 156}, {234, 156}}, {{234, 0}, {234, 156}} };
 
-    if (type == RoomType::Boss) {
+    if (layoutRoom.type == RoomType::Boss) {
         // Visual de "carne/sangue" para a sala do Boss
-        rooms.at(id).setCornerTextureRect({ {234, 156}, {234, 156} });
+        room.setCornerTextureRect({ {234, 156}, {234, 156} });
     }
     else {
-        rooms.at(id).setCornerTextureRect(vars[std::uniform_int_distribution<>(0, 2)(rng)]);
+        room.setCornerTextureRect(vars[layoutRoom.cornerVariant % 3]);
     }
 }
 
-void RoomManager::connectRooms(int roomA, int roomB, DoorDirection dirA) {
-    rooms.at(roomA).connectDoor(dirA, roomB);
-    rooms.at(roomB).connectDoor(getOppositeDirection(dirA), roomA);
+void RoomManager::connectRooms(Floor& floor, int roomA, int roomB, DoorDirection dirA) {
+    floor.rooms.at(roomA).connectDoor(dirA, roomB);
+    floor.rooms.at(roomB).connectDoor(getOppositeDirection(dirA), roomA);
 }
 
 DoorDirection RoomManager::getOppositeDirection(DoorDirection dir) {
@@ -137,6 +245,10 @@ DoorDirection RoomManager::getOppositeDirection(DoorDirection dir) {
     return DoorDirection::None;
 }
 
+bool RoomManager::checkPlayerAtTrapdoor(const sf::FloatRect& pBounds) const {
+    return currentRoom && currentRoom->hasTrapdoor() && checkCollision(pBounds, currentRoom->getTrapdoorBounds());
+}
+
 DoorDirection RoomManager::checkPlayerAtDoor(const sf::FloatRect& pBounds) {
     if (!currentRoom || !currentRoom->isCleared()) return DoorDirection::None;
     for (auto const& d : currentRoom->getDoors()) {
@@ -155,6 +267,15 @@ void RoomManager::requestTransition(DoorDirection dir) {
     transitionDirection = dir;
     transitionState = TransitionState::FadingOut;
     transitionProgress = 0.f;
+    descending = false;
+}
+
+void RoomManager::requestFloorTransition() {
+    if (transitionState != TransitionState::None) return;
+    transitionDirection = DoorDirection::None;
+    transitionState = TransitionState::FadingOut;
+    transitionProgress = 0.f;
+    descending = true;
 }
 
 void RoomManager::updateTransition(float deltaTime, sf::Vector2f& pPos) {
@@ -163,7 +284,23 @@ void RoomManager::updateTransition(float deltaTime, sf::Vector2f& pPos) {
 
     if (transitionState == TransitionState::FadingOut) {
         transitionOverlay.setFillColor(sf::Color(0, 0, 0, (int)(255 * transitionProgress)));
-        if (transitionProgress >= 1.f) {
+        if (transitionProgress >= 1.f && descending) {
+            // O andar seguinte já foi gerado num worker; normalmente isto não espera nada
+            waitForBackgroundTier();
+            waitForNextFloor();
+            if (nextFloor->index < 0) buildFloor(*nextFloor, floorIndex + 1, nextFloor->seed, doorTexture());
+            enterFloor(*nextFloor);
+            nextFloor.reset();  // Agora tem as salas do andar anterior
+            prepareNextFloor();
+
+            pPos = currentRoom->getPlayerSpawnPosition(DoorDirection::None);
+            transitionState = TransitionState::FadingIn;
+            transitionProgress = 0.f;
+            descending = false;
+        }
+        else if (transitionProgress >= 1.f) {
+            // As salas mudam de tier: o job de fundo tem de acabar antes
+            waitForBackgroundTier();
             currentRoomID = nextRoomID;
             currentRoom = &rooms.at(currentRoomID);
             visitedRooms.insert(currentRoomID); // Registar no minimapa
@@ -171,13 +308,9 @@ void RoomManager::updateTransition(float deltaTime, sf::Vector2f& pPos) {
             if (!currentRoom->isCleared()) currentRoom->closeDoors();
 
             // Spawn centralizado de inimigos (O Room::spawnEnemies agora cuida do tipo de sala)
-            currentRoom->spawnEnemies(
-                assets.getAnimationSet("D_Down"), assets.getAnimationSet("D_Up"),
-                assets.getAnimationSet("D_Left"), assets.getAnimationSet("D_Right"),
-                assets.getTexture("TearAtlas"), assets.getAnimationSet("Bishop"),
-                assets.getTexture("ChubbySheet"),
-                assets.getTexture("ChubbySheet")
-            );
+            spawnRoomEnemies(*currentRoom);
+            rebuildBackgroundTier();
+            retainRoomAssets();
 
             pPos = currentRoom->getPlayerSpawnPosition(getOppositeDirection(transitionDirection));
             transitionState = TransitionState::FadingIn;
@@ -193,8 +326,253 @@ void RoomManager::updateTransition(float deltaTime, sf::Vector2f& pPos) {
     }
 }
 
+sf::Texture& RoomManager::doorTexture() {
+    return headless ? *fixedDoorTexture : assets->get(handles.door);
+}
+
+void RoomManager::spawnRoomEnemies(Room& room) {
+    room.spawnEnemies(enemyTextures());
+}
+
+EnemyTextures RoomManager::enemyTextures() {
+    if (headless) return fixedTextures;
+    EnemyTextures textures;
+    textures.demonDown = &assets->get(handles.demonDown);
+    textures.demonUp = &assets->get(handles.demonUp);
+    textures.demonLeft = &assets->get(handles.demonLeft);
+    textures.demonRight = &assets->get(handles.demonRight);
+    textures.demonProjectile = &assets->get(handles.tears);
+    textures.bishop = &assets->get(handles.bishop);
+    textures.chubbySheet = &assets->get(handles.chubby);
+    textures.chubbyProjectile = &assets->get(handles.chubby);
+    textures.monstroSheet = &assets->get(handles.monstro);
+    return textures;
+}
+
+void RoomManager::captureState(RunSnapshot& snapshot) {
+    // As salas de fundo estão a ser escritas num worker
+    waitForBackgroundTier();
+
+    snapshot.clear();
+    snapshot.runSeed = runSeed;
+    snapshot.floorSeed = currentFloorSeed;
+    snapshot.floorIndex = floorIndex;
+    snapshot.currentRoom = currentRoomID;
+    snapshot.layout = layout;
+    snapshot.rooms.resize(rooms.size());
+    for (const auto& [id, room] : rooms) {
+        room.captureState(snapshot.rooms[id], snapshot.doors, snapshot.enemies, snapshot.projectiles, true);
+    }
+    for (int id : visitedRooms) snapshot.visitedRooms.push_back(static_cast<std::uint16_t>(id));
+}
+
+void RoomManager::restoreState(const RunSnapshot& snapshot) {
+    waitForBackgroundTier();
+    waitForNextFloor();
+    nextFloor.reset();
+
+    transitionState = TransitionState::None;
+    transitionProgress = 0.f;
+    descending = false;
+    transitionOverlay.setFillColor(sf::Color::Transparent);
+
+    // A planta traz os rosters: a sala reconstruída é igual à guardada (obstáculos incluídos)
+    runSeed = snapshot.runSeed;
+    Floor floor;
+    floor.index = snapshot.floorIndex;
+    floor.seed = snapshot.floorSeed;
+    floor.layout = snapshot.layout;
+    assembleFloor(floor, doorTexture());
+    applyRosters(floor);
+    swapInFloor(floor);
+
+    const EnemyTextures textures = enemyTextures();
+    for (auto& [id, room] : rooms) {
+        room.restoreState(snapshot.rooms[id], snapshot.doors.data(), snapshot.enemies.data(), snapshot.projectiles.data(), textures);
+    }
+
+    currentRoomID = snapshot.currentRoom;
+    currentRoom = &rooms.at(currentRoomID);
+    visitedRooms.insert(snapshot.visitedRooms.begin(), snapshot.visitedRooms.end());
+    visitedRooms.insert(currentRoomID);
+    rebuildBackgroundTier();
+    retainRoomAssets();
+    prepareNextFloor();
+    LOG_INFO(LogCategory::Rooms, "run retomada no andar ", floorIndex + 1, ", sala ", currentRoomID, " (", snapshot.enemies.size(), " inimigos vivos)");
+}
+
+void RoomManager::captureWorld(WorldSnapshot& snapshot) {
+    waitForBackgroundTier();
+
+    snapshot.clear();
+    snapshot.floorIndex = floorIndex;
+    snapshot.floorSeed = currentFloorSeed;
+    snapshot.currentRoom = currentRoomID;
+    snapshot.transitionState = static_cast<std::uint8_t>(transitionState);
+    snapshot.transitionDirection = static_cast<std::uint8_t>(transitionDirection);
+    snapshot.descending = descending ? 1 : 0;
+    snapshot.overlayAlpha = transitionOverlay.getFillColor().a;
+    snapshot.transitionProgress = transitionProgress;
+    snapshot.nextRoom = nextRoomID;
+
+    snapshot.backgroundAccumulator = backgroundAccumulator;
+    snapshot.backgroundCursor = static_cast<std::uint32_t>(backgroundCursor);
+    for (const BackgroundSlot& slot : backgroundSlots) snapshot.backgroundPending.push_back(slot.pendingTime);
+
+    snapshot.rooms.resize(rooms.size());
+    for (const auto& [id, room] : rooms) {
+        room.captureState(snapshot.rooms[id], snapshot.doors, snapshot.enemies, snapshot.projectiles, false);
+    }
+    for (int id : visitedRooms) snapshot.visitedRooms.push_back(static_cast<std::uint16_t>(id));
+}
+
+bool RoomManager::restoreWorld(const WorldSnapshot& snapshot) {
+    waitForBackgroundTier();
+    // Desceu pelo alçapão depois da captura: as salas do snapshot já não existem
+    if (snapshot.floorIndex != floorIndex || snapshot.floorSeed != currentFloorSeed || snapshot.rooms.size() != rooms.size()) {
+        return false;
+    }
+
+    // As texturas só são precisas se alguma sala tiver de criar os inimigos de novo
+    bool inPlace = true;
+    for (const auto& [id, room] : rooms) inPlace = inPlace && room.restoresInPlace(snapshot.rooms[id], snapshot.enemies.data());
+    const EnemyTextures textures = inPlace ? EnemyTextures() : enemyTextures();
+    for (auto& [id, room] : rooms) {
+        room.restoreState(snapshot.rooms[id], snapshot.doors.data(), snapshot.enemies.data(), snapshot.projectiles.data(), textures);
+    }
+
+    transitionState = static_cast<TransitionState>(snapshot.transitionState);
+    transitionDirection = static_cast<DoorDirection>(snapshot.transitionDirection);
+    descending = snapshot.descending != 0;
+    transitionOverlay.setFillColor(sf::Color(0, 0, 0, snapshot.overlayAlpha));
+    transitionProgress = snapshot.transitionProgress;
+    nextRoomID = snapshot.nextRoom;
+
+    // O minimapa só cresce: na maioria dos rollbacks não há nada a mudar
+    if (!std::equal(visitedRooms.begin(), visitedRooms.end(), snapshot.visitedRooms.begin(), snapshot.visitedRooms.end())) {
+        visitedRooms.clear();
+        visitedRooms.insert(snapshot.visitedRooms.begin(), snapshot.visitedRooms.end());
+    }
+
+    if (currentRoomID != snapshot.currentRoom) {
+        currentRoomID = snapshot.currentRoom;
+        currentRoom = &rooms.at(currentRoomID);
+        rebuildBackgroundTier();
+        retainRoomAssets();
+    }
+    if (backgroundSlots.size() == snapshot.backgroundPending.size()) {
+        for (std::size_t i = 0; i < backgroundSlots.size(); ++i) backgroundSlots[i].pendingTime = snapshot.backgroundPending[i];
+        backgroundAccumulator = snapshot.backgroundAccumulator;
+        backgroundCursor = snapshot.backgroundCursor;
+    }
+    return true;
+}
+
+void RoomManager::appendRoomAssets(RoomType type, std::vector<AssetLease>& leases) {
+    if (type == RoomType::Normal) {
+        leases.emplace_back(*assets, handles.demonDown);
+        leases.emplace_back(*assets, handles.demonUp);
+        leases.emplace_back(*assets, handles.demonLeft);
+        leases.emplace_back(*assets, handles.demonRight);
+        leases.emplace_back(*assets, handles.bishop);
+        leases.emplace_back(*assets, handles.chubby);
+    }
+    else if (type == RoomType::Boss) {
+        leases.emplace_back(*assets, handles.monstro);
+    }
+}
+
+void RoomManager::retainRoomAssets() {
+    if (headless) return;
+    // As novas referencias entram antes de as antigas sairem, para o que se mantem
+    // entre salas nunca chegar a zero
+    std::vector<AssetLease> leases;
+    appendRoomAssets(currentRoom->getType(), leases);
+    for (const BackgroundSlot& slot : backgroundSlots) appendRoomAssets(slot.room->getType(), leases);
+    roomAssets.swap(leases);
+    leases.clear();
+
+    // Chamado com o tier de fundo parado (acabou de ser reconstruido), por isso e seguro despejar
+    assets->trim();
+}
+
 void RoomManager::update(float dt, sf::Vector2f pPos) {
     if (currentRoom) currentRoom->update(dt, pPos);
+    scheduleBackgroundTier(dt);
+}
+
+void RoomManager::rebuildBackgroundTier() {
+    backgroundSlots.clear();
+    backgroundCursor = 0;
+    backgroundAccumulator = 0.f;
+
+    const auto& sched = ConfigManager::getInstance().getConfig().game.room_scheduler;
+    if (headless || !sched.background_rooms || !currentRoom || JobSystem::getInstance().workerCount() == 0) return;
+
+    for (const auto& door : currentRoom->getDoors()) {
+        if (door.leadsToRoomID == -1) continue;
+        Room& neighbor = rooms.at(door.leadsToRoomID);
+        if (neighbor.getType() != RoomType::Normal || neighbor.isCleared()) continue;
+
+        // O spawn usa rand() e o AssetManager, por isso acontece aqui na thread principal
+        spawnRoomEnemies(neighbor);
+
+        BackgroundSlot slot;
+        slot.room = &neighbor;
+        slot.target = gameBounds.position + gameBounds.size / 2.f;
+        backgroundSlots.push_back(slot);
+    }
+}
+
+void RoomManager::scheduleBackgroundTier(float dt) {
+    if (backgroundSlots.empty()) return;
+
+    backgroundAccumulator += dt;
+    const auto& sched = ConfigManager::getInstance().getConfig().game.room_scheduler;
+    const float step = 1.f / std::max(1.f, sched.background_hz);
+    if (backgroundAccumulator < step) return;
+
+    // Tick anterior ainda a correr: nunca esperamos por ele aqui, o tempo fica acumulado
+    if (!backgroundJob.done()) return;
+
+    for (auto& slot : backgroundSlots)
+        slot.pendingTime = std::min(slot.pendingTime + backgroundAccumulator, sched.max_catchup_seconds);
+    backgroundAccumulator = 0.f;
+
+    JobSystem::getInstance().submit([this] { runBackgroundTick(); }, backgroundJob, JobLane::WorkersOnly);
+}
+
+void RoomManager::runBackgroundTick() {
+    using SliceClock = std::chrono::steady_clock;
+    const auto& sched = ConfigManager::getInstance().getConfig().game.room_scheduler;
+    const auto start = SliceClock::now();
+    const auto slice = std::chrono::duration<float, std::milli>(sched.time_slice_ms);
+    const std::size_t budget = static_cast<std::size_t>(std::max(1, sched.max_rooms_per_tick));
+    const float step = 1.f / std::max(1.f, sched.background_hz);
+
+    // Round-robin: as salas que ficarem de fora continuam no próximo tick com o tempo acumulado.
+    // A fatia é verificada a cada passo (só o primeiro do tick corre sempre, para haver progresso):
+    // uma sala a meio guarda o resto do pendingTime e é a primeira do próximo tick.
+    const std::size_t count = backgroundSlots.size();
+    std::size_t processed = 0;
+    bool stepped = false;
+    while (processed < count && processed < budget) {
+        BackgroundSlot& slot = backgroundSlots[backgroundCursor % count];
+        // O tempo acumulado é aplicado em passos de no máximo 1/background_hz
+        while (slot.pendingTime > 0.f) {
+            if (stepped && SliceClock::now() - start >= slice) return;
+            const float dt = std::min(slot.pendingTime, step);
+            slot.room->updateBackground(dt, slot.target);
+            slot.pendingTime -= dt;
+            stepped = true;
+        }
+        backgroundCursor = (backgroundCursor + 1) % count;
+        ++processed;
+    }
+}
+
+void RoomManager::waitForBackgroundTier() {
+    if (!backgroundJob.done()) JobSystem::getInstance().wait(backgroundJob);
 }
 
 void RoomManager::draw(sf::RenderWindow& win) {
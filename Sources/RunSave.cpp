@@ -0,0 +1,139 @@
+#include "RunSave.hpp"
+#include "Logger.hpp"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace fs = std::filesystem;
+
+namespace {
+    bool validRange(std::uint32_t begin, std::uint32_t count, std::size_t size) {
+        return begin <= size && count <= size - begin;
+    }
+
+    bool validSnapshot(const RunSnapshot& snapshot, const GameConfig& config) {
+        const std::size_t roomCount = snapshot.layout.rooms.size();
+        if (snapshot.rooms.size() != roomCount) return false;
+        if (snapshot.currentRoom < 0 || static_cast<std::size_t>(snapshot.currentRoom) >= roomCount) return false;
+        for (std::uint16_t id : snapshot.visitedRooms) {
+            if (id >= roomCount) return false;
+        }
+        for (const RoomState& room : snapshot.rooms) {
+            if (!validRange(room.doorBegin, room.doorCount, snapshot.doors.size())) return false;
+            if (!validRange(room.enemyBegin, room.enemyCount, snapshot.enemies.size())) return false;
+        }
+        const std::size_t archetypeCount = config.archetypes.records.size();
+        for (const EnemyState& enemy : snapshot.enemies) {
+            if (enemy.kind > static_cast<std::uint8_t>(SpawnKind::Monstro)) return false;
+            const bool usesArchetype = enemy.kind == static_cast<std::uint8_t>(SpawnKind::Chubby) ||
+                enemy.kind == static_cast<std::uint8_t>(SpawnKind::Monstro);
+            if (usesArchetype && enemy.archetype >= archetypeCount) return false;
+            if (!validRange(enemy.projectileBegin, enemy.projectileCount, snapshot.projectiles.size())) return false;
+        }
+        return validRange(snapshot.player.projectileBegin, snapshot.player.projectileCount, snapshot.projectiles.size());
+    }
+}
+
+void RunSnapshot::clear() {
+    runSeed = 0;
+    floorSeed = 0;
+    floorIndex = 0;
+    currentRoom = 0;
+    layout.clear();
+    rooms.clear();
+    doors.clear();
+    visitedRooms.clear();
+    enemies.clear();
+    projectiles.clear();
+    player = PlayerState();
+}
+
+void writeRunSnapshot(const RunSnapshot& snapshot, const GameConfig& config, std::vector<char>& out) {
+    RunSaveHeader header{};
+    std::memcpy(header.magic, kRunSaveMagic, sizeof(header.magic));
+    header.format = kRunSaveFormat;
+    header.generatorVersion = kDungeonGeneratorVersion;
+    header.fingerprint = layoutFingerprint(config, config.game.dungeon.floor(snapshot.floorIndex));
+    header.runSeed = snapshot.runSeed;
+    header.floorSeed = snapshot.floorSeed;
+    header.floorIndex = snapshot.floorIndex;
+    header.currentRoom = snapshot.currentRoom;
+    header.roomCount = static_cast<std::uint32_t>(snapshot.rooms.size());
+    header.doorCount = static_cast<std::uint32_t>(snapshot.doors.size());
+    header.visitedCount = static_cast<std::uint32_t>(snapshot.visitedRooms.size());
+    header.enemyCount = static_cast<std::uint32_t>(snapshot.enemies.size());
+    header.projectileCount = static_cast<std::uint32_t>(snapshot.projectiles.size());
+    header.player = snapshot.player;
+
+    out.clear();
+    out.resize(sizeof(header));
+    appendLayoutRecords(snapshot.layout, header.layout, out);
+    out.reserve(out.size() + snapshot.rooms.size() * sizeof(RoomState) + snapshot.doors.size() * sizeof(DoorSaveState) +
+        snapshot.visitedRooms.size() * sizeof(std::uint16_t) + snapshot.enemies.size() * sizeof(EnemyState) +
+        snapshot.projectiles.size() * sizeof(ProjectileState));
+    appendRecords(out, snapshot.rooms.data(), snapshot.rooms.size());
+    appendRecords(out, snapshot.doors.data(), snapshot.doors.size());
+    appendRecords(out, snapshot.visitedRooms.data(), snapshot.visitedRooms.size());
+    appendRecords(out, snapshot.enemies.data(), snapshot.enemies.size());
+    appendRecords(out, snapshot.projectiles.data(), snapshot.projectiles.size());
+    std::memcpy(out.data(), &header, sizeof(header));
+}
+
+bool readRunSnapshot(const std::vector<char>& data, const GameConfig& config, RunSnapshot& snapshot) {
+    if (data.size() < sizeof(RunSaveHeader)) return false;
+    RunSaveHeader header;
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (std::memcmp(header.magic, kRunSaveMagic, sizeof(header.magic)) != 0 || header.format != kRunSaveFormat ||
+        header.generatorVersion != kDungeonGeneratorVersion || header.floorIndex < 0) {
+        return false;
+    }
+    if (header.fingerprint != layoutFingerprint(config, config.game.dungeon.floor(header.floorIndex))) return false;
+
+    RunSnapshot loaded;
+    std::size_t offset = sizeof(header);
+    if (!readLayoutRecords(data, offset, header.layout, loaded.layout) ||
+        !readRecords(data, offset, header.roomCount, loaded.rooms) ||
+        !readRecords(data, offset, header.doorCount, loaded.doors) ||
+        !readRecords(data, offset, header.visitedCount, loaded.visitedRooms) ||
+        !readRecords(data, offset, header.enemyCount, loaded.enemies) ||
+        !readRecords(data, offset, header.projectileCount, loaded.projectiles)) {
+        return false;
+    }
+    loaded.runSeed = header.runSeed;
+    loaded.floorSeed = header.floorSeed;
+    loaded.floorIndex = header.floorIndex;
+    loaded.currentRoom = header.currentRoom;
+    loaded.player = header.player;
+    if (!validSnapshot(loaded, config)) return false;
+
+    snapshot = std::move(loaded);
+    return true;
+}
+
+bool saveRunSnapshot(const std::string& path, const RunSnapshot& snapshot, const GameConfig& config) {
+    std::vector<char> data;
+    writeRunSnapshot(snapshot, config, data);
+    std::error_code error;
+    const fs::path parent = fs::path(path).parent_path();
+    if (!parent.empty()) fs::create_directories(parent, error);
+    return writeFileAtomically(path, data);
+}
+
+bool loadRunSnapshot(const std::string& path, const GameConfig& config, RunSnapshot& snapshot) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) return false;
+    std::vector<char> data(static_cast<std::size_t>(in.tellg()));
+    in.seekg(0);
+    if (!in.read(data.data(), static_cast<std::streamsize>(data.size()))) return false;
+
+    if (!readRunSnapshot(data, config, snapshot)) {
+        LOG_WARN(LogCategory::General, "save '", path, "' invalido ou de outra versao, ignorado");
+        return false;
+    }
+    return true;
+}
+
+void deleteRunSnapshot(const std::string& path) {
+    std::error_code error;
+    fs::remove(path, error);
+}
@@ -0,0 +1,289 @@
+#include "Simulation.hpp"
+#include "Utils.hpp"
+#include "ConfigManager.hpp"
+#include "Chubby.hpp"
+#include "Monstro.hpp"
+#include "EventBus.hpp"
+
+Simulation::Simulation(AssetManager& assets, const PlayerTextures& player, const sf::FloatRect& gameBounds)
+    : playerTextures(player)
+    , gameBounds(gameBounds)
+    , roomManager(assets, gameBounds)
+{
+    createPlayer();
+}
+
+Simulation::Simulation(const PlayerTextures& player, const EnemyTextures& enemies, sf::Texture& doorTexture, const sf::FloatRect& gameBounds)
+    : playerTextures(player)
+    , gameBounds(gameBounds)
+    , roomManager(enemies, doorTexture, gameBounds)
+{
+    createPlayer();
+}
+
+void Simulation::createPlayer() {
+    const auto& config = ConfigManager::getInstance().getConfig();
+    isaac.emplace(*playerTextures.walkDown, *playerTextures.tears, *playerTextures.walkUp, *playerTextures.walkLeft, *playerTextures.walkRight);
+
+    const auto& projConfig = config.projectile_textures.isaac_tear;
+    isaac->setProjectileTextureRect(sf::IntRect(sf::Vector2i(projConfig.x, projConfig.y), sf::Vector2i(projConfig.width, projConfig.height)));
+    isaac->setPosition({ (float)config.game.window_width / 2.f, (float)config.game.window_height / 2.f });
+}
+
+void Simulation::newRun() {
+    createPlayer();
+    roomManager.generateDungeon();
+}
+
+void Simulation::newRun(std::uint32_t seed) {
+    createPlayer();
+    roomManager.generateDungeon(seed);
+}
+
+void Simulation::update(float deltaTime) {
+    simulate(deltaTime);
+    dropExpiredProjectiles();
+
+    // Fase de eventos em todos os caminhos (portas e alcapao incluidos): o que a sala
+    // publicou neste tick e resolvido e entregue antes de a sala ou o andar mudarem
+    resolveEvents();
+    EventBus::getInstance().dispatch();
+}
+
+void Simulation::simulate(float deltaTime) {
+    const auto& config = ConfigManager::getInstance().getConfig();
+    sf::Vector2f playerPosition = isaac->getPosition();
+
+    if (roomManager.isTransitioning()) {
+        roomManager.updateTransition(deltaTime, playerPosition);
+        isaac->setPosition(playerPosition);
+        isaac->setSpeedMultiplier(0.f);
+        return;
+    }
+
+    isaac->setSpeedMultiplier(1.f);
+    Room* activeRoom = roomManager.getCurrentRoom();
+    isaac->setObstacles(activeRoom ? &activeRoom->getObstacles() : nullptr);
+    isaac->update(deltaTime, gameBounds);
+    roomManager.update(deltaTime, isaac->getPosition());
+
+    DoorDirection doorHit = roomManager.checkPlayerAtDoor(isaac->getHitbox());
+    if (doorHit != DoorDirection::None) {
+        roomManager.requestTransition(doorHit);
+        return;
+    }
+    if (roomManager.checkPlayerAtTrapdoor(isaac->getHitbox())) {
+        roomManager.requestFloorTransition();
+        return;
+    }
+
+    Room* currentRoom = roomManager.getCurrentRoom();
+    if (currentRoom) {
+        auto& isaacProjectiles = isaac->getProjectiles();
+        auto& demons = currentRoom->getDemons();
+        auto& bishops = currentRoom->getBishops();
+        auto& chubbies = currentRoom->getChubbies();
+        auto& monstros = currentRoom->getMonstros();
+
+        sf::FloatRect isaacBounds = isaac->getHitbox();
+        EventBus& events = EventBus::getInstance();
+
+        // O dano e so pedido aqui; resolveEvents() aplica tudo depois das colisoes
+        auto hurtIsaac = [&](int amount) {
+            GameEvent event;
+            event.type = GameEventType::Damage;
+            event.target = GameEventTarget::Player;
+            event.amount = amount;
+            event.position = isaac->getPosition();
+            events.publish(event);
+            };
+
+        // Modo contínuo: os projéteis testam todo o caminho feito neste tick
+        const bool swept = config.game.collision.swept_projectiles;
+        auto startOfTick = [](sf::FloatRect bounds, sf::Vector2f step) { bounds.position -= step; return bounds; };
+
+        // Colisões Isaac -> Inimigos
+        // Lote com os inimigos vivos, pela mesma prioridade de antes (Monstro, Demons, Bishops, Chubbies)
+        enemyHitboxes.clear();
+        enemyTargets.clear();
+        auto gatherTargets = [&](auto& list) {
+            for (auto& e : list) {
+                if (e->getHealth() <= 0) continue;
+                enemyHitboxes.push(e->getHitbox());
+                enemyTargets.push_back(e.get());
+            }
+            };
+        gatherTargets(monstros);
+        gatherTargets(demons);
+        gatherTargets(bishops);
+        gatherTargets(chubbies);
+        enemyPendingDamage.assign(enemyTargets.size(), 0);
+
+        if (!enemyTargets.empty()) {
+            for (auto itTear = isaacProjectiles.begin(); itTear != isaacProjectiles.end();) {
+                const sf::FloatRect& tearBounds = itTear->hitbox;
+                int hitIndex = swept
+                    ? firstSweptCollision(startOfTick(tearBounds, itTear->lastStep), itTear->lastStep, enemyHitboxes, hitMask)
+                    : firstCollision(tearBounds, enemyHitboxes);
+                if (hitIndex >= 0) {
+                    EnemyBase* target = enemyTargets[hitIndex];
+                    const sf::Vector2f impact = tearBounds.position + tearBounds.size / 2.f;
+                    GameEvent event;
+                    event.target = GameEventTarget::Enemy;
+                    event.enemy = target;
+                    event.position = impact;
+                    event.type = GameEventType::ProjectileHit;
+                    events.publish(event);
+                    event.type = GameEventType::Damage;
+                    event.amount = config.player.stats.damage;
+                    events.publish(event);
+                    // Inimigo que vai morrer com o dano pendente deixa de contar para as lagrimas seguintes
+                    enemyPendingDamage[hitIndex] += event.amount;
+                    if (target->getHealth() - enemyPendingDamage[hitIndex] <= 0) enemyHitboxes.disable(hitIndex);
+                    itTear = isaacProjectiles.erase(itTear);
+                }
+                else ++itTear;
+            }
+        }
+
+        // Projeteis inimigos -> Isaac (um teste em lote por lista de projeteis)
+        auto hitIsaacWithProjectiles = [&](std::vector<EnemyProjectile>& list) {
+            if (list.empty()) return;
+            projectileHitboxes.clear();
+            for (const auto& p : list) {
+                const sf::FloatRect& bounds = p.hitbox;
+                projectileHitboxes.push(swept ? sweptBounds(startOfTick(bounds, p.lastStep), p.lastStep) : bounds);
+            }
+            std::size_t hits = collisionMask(isaacBounds, projectileHitboxes, hitMask);
+            if (hits == 0) return;
+            if (swept) {
+                // Narrow phase: confirma o varrimento exato dos candidatos
+                hits = 0;
+                for (std::size_t i = 0; i < list.size(); ++i) {
+                    if (!hitMask[i]) continue;
+                    float t;
+                    const sf::FloatRect& bounds = list[i].hitbox;
+                    if (sweptCollision(startOfTick(bounds, list[i].lastStep), list[i].lastStep, isaacBounds, t)) ++hits;
+                    else hitMask[i] = 0;
+                }
+                if (hits == 0) return;
+            }
+            for (std::size_t i = 0; i < hits; ++i) hurtIsaac(1);
+            eraseMasked(list, hitMask);
+            };
+
+        // Colisões Inimigos -> Isaac
+        for (auto& m : monstros) {
+            if (m->getHealth() <= 0) continue;
+            const sf::FloatRect& monstroBounds = m->getHitbox();
+            bool touching = checkCollision(isaacBounds, monstroBounds);
+            if (!touching && swept) {
+                // Na queda o Monstro pode atravessar o Isaac num único tick
+                float t;
+                touching = sweptCollision(startOfTick(monstroBounds, m->getBodyMotion()), m->getBodyMotion(), isaacBounds, t);
+            }
+            if (touching) {
+                hurtIsaac(m->getContactDamage());
+            }
+            hitIsaacWithProjectiles(m->getProjectiles());
+        }
+
+        for (auto& d : demons) {
+            if (d->getHealth() <= 0) continue;
+            if (checkCollision(isaacBounds, d->getHitbox())) hurtIsaac(1);
+            hitIsaacWithProjectiles(d->getProjectiles());
+        }
+
+        for (auto& b : bishops) {
+            if (b->getHealth() > 0 && checkCollision(isaacBounds, b->getHitbox())) hurtIsaac(1);
+        }
+
+        for (auto& c : chubbies) {
+            if (c->getHealth() <= 0) continue;
+            if (checkCollision(isaacBounds, c->getHitbox())) hurtIsaac(1);
+            if (c->BoomerangActive()) {
+                sf::FloatRect boomerangBounds = c->getBoomerangBounds();
+                sf::Vector2f step = c->getBoomerangMotion();
+                float t;
+                bool hitByBoomerang = swept
+                    ? sweptCollision(startOfTick(boomerangBounds, step), step, isaacBounds, t)
+                    : checkCollision(isaacBounds, boomerangBounds);
+                if (hitByBoomerang) hurtIsaac(2);
+            }
+        }
+    }
+}
+
+void Simulation::dropExpiredProjectiles() {
+    // Os projeteis que acabaram neste tick ja foram testados pelas colisoes
+    eraseExpiring(isaac->getProjectiles());
+    Room* currentRoom = roomManager.getCurrentRoom();
+    if (!currentRoom) return;
+    for (auto& m : currentRoom->getMonstros()) eraseExpiring(m->getProjectiles());
+    for (auto& d : currentRoom->getDemons()) eraseExpiring(d->getProjectiles());
+}
+
+void Simulation::captureRun(RunSnapshot& snapshot) {
+    roomManager.captureState(snapshot);
+    isaac->saveState(snapshot.player, snapshot.projectiles);
+}
+
+void Simulation::restoreRun(const RunSnapshot& snapshot) {
+    roomManager.restoreState(snapshot);
+    isaac->loadState(snapshot.player, snapshot.projectiles.data() + snapshot.player.projectileBegin);
+    // Pedidos ainda na fila apontam para inimigos que acabaram de ser repostos
+    EventBus::getInstance().pending().clear();
+}
+
+void Simulation::captureWorld(WorldSnapshot& snapshot) {
+    roomManager.captureWorld(snapshot);
+    isaac->saveState(snapshot.player, snapshot.projectiles);
+}
+
+bool Simulation::restoreWorld(const WorldSnapshot& snapshot) {
+    if (!roomManager.restoreWorld(snapshot)) return false;
+    isaac->loadState(snapshot.player, snapshot.projectiles.data() + snapshot.player.projectileBegin);
+    EventBus::getInstance().pending().clear();
+    return true;
+}
+
+void Simulation::resolveEvents() {
+    std::vector<GameEvent>& queue = EventBus::getInstance().pending();
+    // Por indice: as mortes sao acrescentadas a mesma fila durante o ciclo
+    for (std::size_t i = 0; i < queue.size(); ++i) {
+        GameEvent& event = queue[i];
+        if (event.type != GameEventType::Damage && event.type != GameEventType::Heal) continue;
+
+        int before = 0;
+        int after = 0;
+        if (event.target == GameEventTarget::Player && isaac) {
+            before = isaac->getHealth();
+            // O Isaac nao tem cura por agora; o dano respeita a invulnerabilidade
+            if (event.type == GameEventType::Damage) isaac->takeDamage(event.amount);
+            after = isaac->getHealth();
+        }
+        else if (event.target == GameEventTarget::Enemy && event.enemy) {
+            before = event.enemy->getHealth();
+            // Mortos nao recebem mais dano nem curas do mesmo tick
+            if (before > 0) {
+                if (event.type == GameEventType::Damage) event.enemy->takeDamage(event.amount);
+                else event.enemy->heal(event.amount);
+            }
+            after = event.enemy->getHealth();
+        }
+        else continue;
+
+        // Os subscritores veem o efeito real (0 se invulneravel, curas limitadas a vida maxima)
+        event.amount = event.type == GameEventType::Damage ? before - after : after - before;
+        event.health = after;
+        if (before > 0 && after <= 0) {
+            GameEvent death;
+            death.type = GameEventType::Death;
+            death.target = event.target;
+            death.enemy = event.enemy;
+            death.health = after;
+            death.position = event.position;
+            queue.push_back(death);
+        }
+    }
+}
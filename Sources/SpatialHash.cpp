@@ -0,0 +1,32 @@
+#include "SpatialHash.hpp"
+#include <algorithm>
+
+void SpatialHash::build(const std::vector<sf::Vector2f>& points, float cellSize) {
+    cell = std::max(1.f, cellSize);
+    inverseCell = 1.f / cell;
+    count = points.size();
+
+    // Tabela com potencia de 2 >= 2n (poucas colisoes e o hash fica num AND)
+    std::size_t tableSize = 16;
+    while (tableSize < count * 2) tableSize <<= 1;
+    mask = static_cast<std::uint32_t>(tableSize - 1);
+
+    bucketStart.assign(tableSize + 1, 0);
+    pointBucket.resize(count);
+    entries.resize(count);
+
+    // Counting sort: conta por bucket, prefix sum, e distribui pela ordem dos pontos
+    for (std::size_t i = 0; i < count; ++i) {
+        std::uint32_t bucket = static_cast<std::uint32_t>(bucketOf(cellCoord(points[i].x), cellCoord(points[i].y)));
+        pointBucket[i] = bucket;
+        ++bucketStart[bucket + 1];
+    }
+    for (std::size_t b = 0; b < tableSize; ++b) bucketStart[b + 1] += bucketStart[b];
+
+    // bucketStart[b] serve de cursor durante a distribuicao e e reposto no fim
+    for (std::size_t i = 0; i < count; ++i) {
+        entries[bucketStart[pointBucket[i]]++] = static_cast<std::uint32_t>(i);
+    }
+    for (std::size_t b = tableSize; b > 0; --b) bucketStart[b] = bucketStart[b - 1];
+    bucketStart[0] = 0;
+}
@@ -1,21 +1,39 @@
 #include "enemy.hpp"
 #include "ConfigManager.hpp" 
+#include "Collision.hpp"
+#include "BulletPattern.hpp"
 #include <algorithm>
 #include <stdexcept>
 #include <iostream>
 #include <cmath>
-
-// --- Funções Auxiliares ---
-float calculateAngle(sf::Vector2f p1, sf::Vector2f p2) {
-    sf::Vector2f diff = p2 - p1;
-    return std::atan2f(-diff.y, diff.x) * 180.f / M_PI;
-}
+#include <cstdlib>
 
 // --- Implementações de EnemyBase ---
 
 EnemyBase::EnemyBase() {
     const PlayerConfig& player_cfg = ConfigManager::getInstance().getConfig().player;
-    hitFlashDuration = sf::seconds(player_cfg.stats.hit_flash_duration);
+    hitFlashDuration = player_cfg.stats.hit_flash_duration;
+    projectileHitboxShape = ConfigManager::getInstance().getConfig().game.collision.enemy_tear_hitbox;
+
+    // Semente provisória do rand() global; a sala troca-a pela do roster (seedRandom)
+    rngState = static_cast<std::uint32_t>(std::rand()) * 2654435761u + 0x9E3779B9u;
+    if (rngState == 0) rngState = 1;
+}
+
+int EnemyBase::randomInt(int maxExclusive) {
+    return randomBelow(rngState, maxExclusive);
+}
+
+void EnemyBase::buildProjectilePrototype(const sf::Texture& texture, const sf::IntRect& rect, sf::Vector2f origin, float scale) {
+    EnemyProjectile p = { sf::Sprite(texture), {}, 0.f };
+    p.sprite.setTextureRect(rect);
+    p.sprite.setOrigin(origin);
+    p.sprite.setScale(sf::Vector2f(scale, scale));
+    projectilePrototype.emplace(p);
+}
+
+void EnemyBase::refreshHitbox() {
+    hitbox = sprite ? makeHitbox(sprite->getPosition(), hitboxShape) : sf::FloatRect();
 }
 
 // Implementação da função virtual de cura na BASE
@@ -23,14 +41,35 @@ void EnemyBase::heal(int amount) {
     // A lógica específica de vida máxima fica nas classes filhas ou 
     // pode ser generalizada aqui se houver um max_health na base.
     isHealing = true;
-    healFlashClock.restart();
+    healFlashTimer = 0.f;
     if (sprite) sprite->setColor(sf::Color::Green);
 }
 
-void EnemyBase::handleHealFlash() {
+void EnemyBase::applyAura(const AuraEffect& aura) {
+    switch (aura.kind) {
+    case AuraKind::Heal:
+        heal(static_cast<int>(aura.magnitude));
+        break;
+    case AuraKind::Haste:
+    case AuraKind::Slow:
+        // A aura mais recente substitui a anterior
+        speedMultiplier = aura.kind == AuraKind::Haste ? 1.f + aura.magnitude : std::max(0.f, 1.f - aura.magnitude);
+        speedStatusTimer = aura.duration;
+        break;
+    }
+}
+
+void EnemyBase::updateStatus(float deltaTime) {
+    if (speedStatusTimer <= 0.f) return;
+    speedStatusTimer -= deltaTime;
+    if (speedStatusTimer <= 0.f) speedMultiplier = 1.f;
+}
+
+void EnemyBase::handleHealFlash(float deltaTime) {
     if (!sprite || !isHealing) return;
 
-    if (healFlashClock.getElapsedTime() >= healFlashDuration) {
+    healFlashTimer += deltaTime;
+    if (healFlashTimer >= healFlashDuration) {
         sprite->setColor(sf::Color::White);
         isHealing = false;
     }
@@ -39,19 +78,24 @@ void EnemyBase::handleHealFlash() {
     }
 }
 
+void EnemyBase::scaleHealth(float multiplier) {
+    if (health > 0) health = std::max(1, static_cast<int>(std::lround(health * multiplier)));
+}
+
 void EnemyBase::takeDamage(int amount) {
     if (health > 0) {
         health = std::max(0, health - amount);
         isHit = true;
-        hitClock.restart();
+        hitTimer = 0.f;
         if (sprite) sprite->setColor(sf::Color::Red);
     }
 }
 
-void EnemyBase::handleHitFlash() {
+void EnemyBase::handleHitFlash(float deltaTime) {
     if (!sprite || !isHit) return;
 
-    if (hitClock.getElapsedTime() < hitFlashDuration) {
+    hitTimer += deltaTime;
+    if (hitTimer < hitFlashDuration) {
         sprite->setColor(sf::Color::Red);
     }
     else {
@@ -72,22 +116,94 @@ std::vector<EnemyProjectile>& EnemyBase::getProjectiles() {
 }
 
 void EnemyBase::updateProjectiles(float deltaTime, const sf::FloatRect& gameBounds) {
-    for (auto it = projectiles.begin(); it != projectiles.end(); ) {
-        it->sprite.move(it->direction * enemyHitSpeed * deltaTime);
-        it->distanceTraveled += enemyHitSpeed * deltaTime;
-        sf::FloatRect projBounds = it->sprite.getGlobalBounds();
+    // Os que expiraram no tick anterior sem passar pelas colisões (ex.: salas em segundo plano)
+    eraseExpiring(projectiles);
+
+    for (EnemyProjectile& p : projectiles) {
+        p.lastStep = p.direction * enemyHitSpeed * deltaTime;
+        p.sprite.move(p.lastStep);
+        p.distanceTraveled += enemyHitSpeed * deltaTime;
+        p.hitbox = makeHitbox(p.sprite.getPosition(), projectileHitboxShape);
 
-        sf::Vector2f center = projBounds.position + projBounds.size / 2.f;
+        sf::Vector2f center = p.hitbox.position + p.hitbox.size / 2.f;
 
         bool is_outside_bounds = center.x < gameBounds.position.x ||
             center.x > gameBounds.position.x + gameBounds.size.x ||
             center.y < gameBounds.position.y ||
             center.y > gameBounds.position.y + gameBounds.size.y;
 
-        if (it->distanceTraveled >= maxHitDistance || is_outside_bounds)
-            it = projectiles.erase(it);
-        else
-            ++it;
+        // As rochas param o projétil (raio pelo caminho do tick, não salta tiles).
+        // O passo fica cortado no impacto: o teste contínuo só varre até à rocha.
+        float hitFraction;
+        bool hit_rock = obstacles && obstacles->raycast(center - p.lastStep, center, ObstacleLayer::Projectiles, hitFraction);
+        if (hit_rock) {
+            const sf::Vector2f blocked = p.lastStep * (1.f - hitFraction);
+            p.sprite.move(-blocked);
+            p.lastStep -= blocked;
+            p.hitbox = makeHitbox(p.sprite.getPosition(), projectileHitboxShape);
+        }
+
+        // Não sai já: a Simulation ainda testa o caminho deste tick e apaga-o depois
+        p.expiring = p.distanceTraveled >= maxHitDistance || is_outside_bounds || hit_rock;
+    }
+}
+
+void EnemyBase::saveState(EnemyState& state, std::vector<ProjectileState>& out) const {
+    state.flags = (isHit ? EnemyState::Hit : 0) | (isHealing ? EnemyState::Healing : 0);
+    state.health = health;
+    state.rngState = rngState;
+    state.position = sprite ? sprite->getPosition() : sf::Vector2f();
+    state.speedMultiplier = speedMultiplier;
+    state.speedStatusTimer = speedStatusTimer;
+    state.hitTimer = hitTimer;
+    state.healFlashTimer = healFlashTimer;
+    animation.save(state.animation);
+
+    state.projectileBegin = static_cast<std::uint32_t>(out.size());
+    state.projectileCount = 0;
+    for (const EnemyProjectile& p : projectiles) {
+        if (p.expiring) continue;  // Ja acabou; so esperava pelas colisoes
+        ++state.projectileCount;
+        ProjectileState saved;
+        saved.position = p.sprite.getPosition();
+        saved.direction = p.direction;
+        saved.distanceTraveled = p.distanceTraveled;
+        saved.rotation = p.sprite.getRotation().asDegrees();
+        saved.scale = p.sprite.getScale();
+        out.push_back(saved);
+    }
+}
+
+void EnemyBase::loadState(const EnemyState& state, const ProjectileState* saved) {
+    health = state.health;
+    rngState = state.rngState ? state.rngState : 1;
+    setPosition(state.position);
+    speedMultiplier = state.speedMultiplier;
+    speedStatusTimer = state.speedStatusTimer;
+    hitTimer = state.hitTimer;
+    healFlashTimer = state.healFlashTimer;
+    isHit = (state.flags & EnemyState::Hit) != 0;
+    isHealing = (state.flags & EnemyState::Healing) != 0;
+    animation.load(state.animation);
+    if (sprite) {
+        animation.apply(*sprite);
+        sprite->setColor(isHit ? sf::Color::Red : isHealing ? sf::Color::Green : sf::Color::White);
+    }
+
+    // Os projéteis partem do protótipo, como num disparo normal
+    projectiles.clear();
+    if (!projectilePrototype) return;
+    projectiles.reserve(state.projectileCount);
+    for (std::uint32_t i = 0; i < state.projectileCount; ++i) {
+        const ProjectileState& p = saved[i];
+        projectiles.push_back(*projectilePrototype);
+        EnemyProjectile& projectile = projectiles.back();
+        projectile.direction = p.direction;
+        projectile.distanceTraveled = p.distanceTraveled;
+        projectile.sprite.setPosition(p.position);
+        projectile.sprite.setRotation(sf::degrees(p.rotation));
+        projectile.sprite.setScale(p.scale);
+        projectile.hitbox = makeHitbox(p.position, projectileHitboxShape);
     }
 }
 
@@ -110,37 +226,46 @@ Demon_ALL::Demon_ALL(
 {
     const auto& config = ConfigManager::getInstance().getConfig().demon;
 
+    hitboxShape = config.hitbox;
     health = config.stats.initial_health;
     speed = config.stats.speed;
-    frame_duration = config.visual.animation.frame_duration;
 
-    cooldownTime = sf::seconds(config.attack.fire_cooldown);
-    attackDelayTime = sf::seconds(config.attack.attack_delay);
+    cooldownTime = config.attack.fire_cooldown;
+    attackDelayTime = config.attack.attack_delay;
 
     enemyHitSpeed = config.attack.projectile_speed;
     maxHitDistance = config.attack.projectile_max_distance;
+    attackPattern = BulletPatternLibrary::getInstance().find(config.attack.pattern);
 
     projectileTexture = &projectileTextureRef;
-    textures_walk_down = &walkDown;
-    textures_walk_up = &walkUp;
-    textures_walk_left = &walkLeft;
-    textures_walk_right = &walkRight;
-    last_animation_set = textures_walk_down;
-
-    if (textures_walk_down && !textures_walk_down->empty()) {
-        sprite.emplace(textures_walk_down->at(0));
+
+    const auto& anim = config.visual.animation;
+    auto& library = AnimationLibrary::getInstance();
+    clipWalkDown = library.fromTextures("demon/walk_down", walkDown, anim.frames, anim.frame_duration);
+    clipWalkUp = library.fromTextures("demon/walk_up", walkUp, anim.frames, anim.frame_duration);
+    clipWalkLeft = library.fromTextures("demon/walk_left", walkLeft, anim.frames, anim.frame_duration);
+    clipWalkRight = library.fromTextures("demon/walk_right", walkRight, anim.frames, anim.frame_duration);
+    animation.play(clipWalkDown);
+
+    if (!walkDown.empty()) {
+        sprite.emplace(walkDown.at(0));
         sprite->setScale(sf::Vector2f(config.visual.scale, config.visual.scale));
         sprite->setPosition({ config.spawn.start_position_x, config.spawn.start_position_y });
         sprite->setOrigin(sf::Vector2f(config.visual.origin_x, config.visual.origin_y));
     }
+    refreshHitbox();
 
     if (projectileTexture) {
-        projectileTextureRect = sf::IntRect({ 0, 0 }, (sf::Vector2i)projectileTexture->getSize());
+        setProjectileTextureRect(sf::IntRect({ 0, 0 }, (sf::Vector2i)projectileTexture->getSize()));
     }
 }
 
 void Demon_ALL::setProjectileTextureRect(const sf::IntRect& rect) {
     projectileTextureRect = rect;
+    if (projectileTexture) {
+        const float scale = ConfigManager::getInstance().getConfig().demon.projectile_visual.scale;
+        buildProjectilePrototype(*projectileTexture, rect, sf::Vector2f(8.f, 8.f), scale);
+    }
 }
 
 void Demon_ALL::setHealth(int newHealth) {
@@ -158,117 +283,95 @@ void Demon_ALL::heal(int amount) {
 void Demon_ALL::handleMovementAndAnimation(float deltaTime, sf::Vector2f playerPosition, bool isAttacking) {
     if (!sprite) return;
 
-    const int current_total_frames = ConfigManager::getInstance().getConfig().demon.visual.animation.frames;
-
     sf::Vector2f currentPos = sprite->getPosition();
     sf::Vector2f move = playerPosition - currentPos;
 
     float length = std::sqrtf(move.x * move.x + move.y * move.y);
     if (length > 0.0f) move /= length;
 
-    if (!isAttacking && length > 100.f) {
-        sprite->move(move * deltaTime * speed);
-    }
+    // Com flow field contorna obstáculos; em campo aberto dá a mesma reta
+    if (flowField) move = flowField->direction(currentPos);
 
-    std::vector<sf::Texture>* current_animation_set = textures_walk_down;
-    bool isAnimating = length > 10.f || isAttacking;
-
-    if (length > 10.f) {
-        if (std::abs(move.x) > std::abs(move.y)) {
-            if (move.x > 0) current_animation_set = textures_walk_right;
-            else current_animation_set = textures_walk_left;
-        }
-        else {
-            if (move.y > 0) current_animation_set = textures_walk_down;
-            else current_animation_set = textures_walk_up;
-        }
+    if (crowd) {
+        // Chegada suave em vez da paragem seca; a separação continua a atuar parado ou a atacar
+        sf::Vector2f desired = isAttacking ? sf::Vector2f(0.f, 0.f) : move * crowd->arrival(length);
+        sprite->move(crowd->steer(crowdIndex, desired) * deltaTime * speed * speedMultiplier);
     }
-    else {
-        current_animation_set = last_animation_set;
-    }
-
-    if (current_animation_set && current_animation_set != last_animation_set) {
-        current_frame = 0;
-        animation_time = 0.0f;
-        last_animation_set = current_animation_set;
+    else if (!isAttacking && length > 100.f) {
+        sprite->move(move * deltaTime * speed * speedMultiplier);
     }
 
-    if (isAnimating) {
-        animation_time += deltaTime;
-        if (animation_time >= frame_duration) {
-            animation_time -= frame_duration;
-            current_frame = (current_frame + 1) % current_total_frames;
-        }
-    }
-    else {
-        current_frame = 0;
-        animation_time = 0.0f;
+    const AnimationClip* clip = animation.clip ? animation.clip : clipWalkDown;
+    if (length > 10.f) {
+        if (std::abs(move.x) > std::abs(move.y)) clip = move.x > 0 ? clipWalkRight : clipWalkLeft;
+        else clip = move.y > 0 ? clipWalkDown : clipWalkUp;
     }
 
-    if (current_animation_set && !current_animation_set->empty() && current_frame < current_animation_set->size()) {
-        sprite->setTexture(current_animation_set->at(current_frame));
-    }
+    // O avanço dos frames já foi feito em lote pela sala; aqui só se escolhe o clip
+    animation.play(clip);
+    if (length <= 10.f && !isAttacking) animation.stop();
+    animation.apply(*sprite);
 }
 
-void Demon_ALL::handleAttack(sf::Vector2f playerPosition) {
-    if (!sprite || !projectileTexture) return;
-
-    const auto& config = ConfigManager::getInstance().getConfig().demon;
+void Demon_ALL::handleAttack(float deltaTime, sf::Vector2f playerPosition) {
+    if (!sprite || !projectilePrototype || !attackPattern) return;
 
     if (!isPreparingAttack) {
-        if (cooldownClock.getElapsedTime() >= cooldownTime) {
+        cooldownTimer += deltaTime;
+        if (cooldownTimer >= cooldownTime) {
             isPreparingAttack = true;
-            attackDelayClock.restart();
+            attackDelayTimer = 0.f;
             targetPositionAtStartOfAttack = playerPosition;
         }
     }
 
     if (isPreparingAttack) {
-        if (attackDelayClock.getElapsedTime() >= attackDelayTime) {
-            float baseAngle = calculateAngle(sprite->getPosition(), targetPositionAtStartOfAttack);
-            const int numProjectiles = config.attack.projectile_count;
-            const float spreadAngle = config.attack.projectile_spread;
-            const float projectileScale = config.projectile_visual.scale;
-
-            float startOffset = -(spreadAngle / 2.0f);
-            float step = (numProjectiles > 1) ? spreadAngle / (numProjectiles - 1) : 0.0f;
-
-            for (int i = 0; i < numProjectiles; ++i) {
-                float angleOffset = startOffset + i * step;
-                float finalAngle = baseAngle + angleOffset;
-                float angleRad = finalAngle * (M_PI / 180.f);
-                sf::Vector2f direction = { std::cosf(angleRad), -std::sinf(angleRad) };
-
-                EnemyProjectile p = { sf::Sprite(*projectileTexture), direction, 0.f };
-                p.sprite.setScale(sf::Vector2f(projectileScale, projectileScale));
-                p.sprite.setTextureRect(projectileTextureRect);
-                p.sprite.setOrigin(sf::Vector2f(8.f, 8.f));
-                p.sprite.setPosition(sprite->getPosition());
-                p.sprite.setRotation(sf::degrees(finalAngle - 90.f));
-                projectiles.push_back(p);
-            }
+        attackDelayTimer += deltaTime;
+        if (attackDelayTimer >= attackDelayTime) {
+            sf::Vector2f diff = targetPositionAtStartOfAttack - sprite->getPosition();
+            float aim = std::atan2(diff.y, diff.x) * 180.f / static_cast<float>(M_PI);
+            attackPattern->emit(*projectilePrototype, projectileHitboxShape, sprite->getPosition(),
+                aim, volleyCount++, rngState, projectiles);
 
             isPreparingAttack = false;
-            cooldownClock.restart();
+            cooldownTimer = 0.f;
         }
     }
 }
 
 void Demon_ALL::update(float deltaTime, sf::Vector2f playerPosition, const sf::FloatRect& gameBounds) {
     if (health <= 0) return;
+    const sf::Vector2f previousPosition = sprite->getPosition();
 
     handleMovementAndAnimation(deltaTime, playerPosition, isPreparingAttack);
-    handleAttack(playerPosition);
+    handleAttack(deltaTime, playerPosition);
     updateProjectiles(deltaTime, gameBounds);
 
-    handleHitFlash();
-    handleHealFlash();
+    handleHitFlash(deltaTime);
+    handleHealFlash(deltaTime);
+
+    sprite->setPosition(resolveMovement(previousPosition, sprite->getPosition(), hitboxShape, gameBounds, obstacles));
+    refreshHitbox();
+}
+
+// timers = { cooldownTimer, attackDelayTimer }, points = { alvo do ataque },
+// values = { volleyCount, isPreparingAttack }
+void Demon_ALL::saveState(EnemyState& state, std::vector<ProjectileState>& projectiles) const {
+    EnemyBase::saveState(state, projectiles);
+    state.timers[0] = cooldownTimer;
+    state.timers[1] = attackDelayTimer;
+    state.points[0] = targetPositionAtStartOfAttack;
+    state.values[0] = volleyCount;
+    state.values[1] = isPreparingAttack ? 1 : 0;
+}
 
-    sf::Vector2f newPos = sprite->getPosition();
-    sf::FloatRect demonBounds = sprite->getGlobalBounds();
-    newPos.x = std::min(std::max(newPos.x, gameBounds.position.x + demonBounds.size.x / 2.f), gameBounds.position.x + gameBounds.size.x - demonBounds.size.x / 2.f);
-    newPos.y = std::min(std::max(newPos.y, gameBounds.position.y + demonBounds.size.y / 2.f), gameBounds.position.y + gameBounds.size.y - demonBounds.size.y / 2.f);
-    sprite->setPosition(newPos);
+void Demon_ALL::loadState(const EnemyState& state, const ProjectileState* projectiles) {
+    EnemyBase::loadState(state, projectiles);
+    cooldownTimer = state.timers[0];
+    attackDelayTimer = state.timers[1];
+    targetPositionAtStartOfAttack = state.points[0];
+    volleyCount = state.values[0];
+    isPreparingAttack = state.values[1] != 0;
 }
 
 // --- Implementações de Bishop_ALL ---
@@ -277,74 +380,85 @@ Bishop_ALL::Bishop_ALL(std::vector<sf::Texture>& walkTextures)
     : EnemyBase()
 {
     const auto& config = ConfigManager::getInstance().getConfig().bishop;
+    hitboxShape = config.hitbox;
     health = config.stats.initial_health;
     speed = config.stats.speed;
-    frame_duration = config.visual.animation.frame_duration;
-    FRAME_B7_INDEX = config.visual.animation.heal_trigger_frame;
-    healCooldown = sf::seconds(config.heal.cooldown);
+    healCooldown = config.heal.cooldown;
+    healAura.kind = AuraKind::Heal;
+    healAura.source = this;
+    healAura.radius = config.heal.radius;
+    healAura.magnitude = static_cast<float>(config.heal.amount);
+    healAura.targets = config.heal.targets;
     center_pull_weight = config.movement.center_pull_weight;
     lateral_bias_frequency = config.movement.lateral_bias_frequency;
     lateral_bias_strength = config.movement.lateral_bias_strength;
-    textures_idle = &walkTextures;
 
-    if (textures_idle && !textures_idle->empty()) {
-        sprite.emplace(textures_idle->at(0));
+    const auto& anim = config.visual.animation;
+    clipChant = AnimationLibrary::getInstance().fromTextures("bishop/chant", walkTextures,
+        anim.frames, anim.frame_duration, false, anim.heal_trigger_frame);
+    animation.play(clipChant);
+    animation.stop();
+
+    if (!walkTextures.empty()) {
+        sprite.emplace(walkTextures.at(0));
         sprite->setScale(sf::Vector2f(config.visual.scale, config.visual.scale));
         sprite->setPosition({ config.spawn.start_position_x, config.spawn.start_position_y });
         sprite->setOrigin(sf::Vector2f(config.visual.origin_x, config.visual.origin_y));
     }
+    refreshHitbox();
 }
 
 void Bishop_ALL::handleAnimation(float deltaTime) {
     if (!sprite) return;
-    const int current_total_frames = ConfigManager::getInstance().getConfig().bishop.visual.animation.frames;
 
     if (isChanting) {
-        animation_time += deltaTime;
-        if (animation_time >= frame_duration) {
-            animation_time -= frame_duration;
-            current_frame++;
-
-            if (current_frame == FRAME_B7_INDEX) {
-                if (healClock.getElapsedTime() >= healCooldown) {
-                    canHealDemon = true;
-                }
-            }
-
-            if (current_frame >= current_total_frames) {
-                isChanting = false;
-                current_frame = 0;
-                animation_time = 0.0f;
-            }
-
-            if (textures_idle && current_frame < textures_idle->size())
-                sprite->setTexture(textures_idle->at(current_frame));
-        }
-    }
-    else {
-        current_frame = 0;
-        animation_time = 0.0f;
-        if (sprite && textures_idle && !textures_idle->empty()) {
-            sprite->setTexture(textures_idle->at(0));
-        }
+        // O evento do clip (heal_trigger_frame) marca o momento da cura
+        if (animation.eventFired && healTimer >= healCooldown) canHealDemon = true;
 
-        if (healClock.getElapsedTime() >= healCooldown && !canHealDemon) {
-            isChanting = true;
+        if (animation.finished) {
+            isChanting = false;
+            animation.stop();
         }
     }
+    else if (healTimer >= healCooldown && !canHealDemon) {
+        isChanting = true;
+        animation.play(clipChant, true);
+    }
+
+    animation.apply(*sprite);
 }
 
 bool Bishop_ALL::shouldHealDemon() const { return canHealDemon; }
 
-void Bishop_ALL::resetHealFlag() {
+// timers = { healTimer }, values = { canHealDemon, isChanting }
+void Bishop_ALL::saveState(EnemyState& state, std::vector<ProjectileState>& projectiles) const {
+    EnemyBase::saveState(state, projectiles);
+    state.timers[0] = healTimer;
+    state.values[0] = canHealDemon ? 1 : 0;
+    state.values[1] = isChanting ? 1 : 0;
+}
+
+void Bishop_ALL::loadState(const EnemyState& state, const ProjectileState* projectiles) {
+    EnemyBase::loadState(state, projectiles);
+    healTimer = state.timers[0];
+    canHealDemon = state.values[0] != 0;
+    isChanting = state.values[1] != 0;
+}
+
+void Bishop_ALL::emitCommands(EnemyCommandBuffer& commands) {
+    if (health <= 0 || !canHealDemon) return;
+    // A aura é resolvida pela sala no fim do tick; o cântico recomeça a contar já
+    healAura.center = hitbox.position + hitbox.size / 2.f;
+    commands.auras.push_back(healAura);
     canHealDemon = false;
-    healClock.restart();
+    healTimer = 0.f;
 }
 
 void Bishop_ALL::update(float deltaTime, sf::Vector2f playerPosition, const sf::FloatRect& gameBounds) {
     if (health <= 0 || !sprite) return;
+    healTimer += deltaTime;
 
-    sf::Vector2f currentPos = sprite->getPosition();
+    const sf::Vector2f currentPos = sprite->getPosition();
     sf::Vector2f diff = playerPosition - currentPos;
     sf::Vector2f flee = -diff;
     float length = std::sqrtf(flee.x * flee.x + flee.y * flee.y);
@@ -359,21 +473,22 @@ void Bishop_ALL::update(float deltaTime, sf::Vector2f playerPosition, const sf::
     }
 
     sf::Vector2f lateralMove = { -flee.y, flee.x };
-    float lateralBias = std::sin(healClock.getElapsedTime().asSeconds() * lateral_bias_frequency) * lateral_bias_strength;
+    float lateralBias = std::sin(healTimer * lateral_bias_frequency) * lateral_bias_strength;
     sf::Vector2f finalMove = flee + (lateralMove * lateralBias) + centerPull;
 
     float finalLength = std::sqrtf(finalMove.x * finalMove.x + finalMove.y * finalMove.y);
     if (finalLength > 0.0f) finalMove /= finalLength;
 
-    sprite->move(finalMove * deltaTime * speed);
+    // Separação dos outros inimigos e desvio das paredes na fuga
+    if (crowd) finalMove = crowd->steer(crowdIndex, finalMove);
+
+    sprite->move(finalMove * deltaTime * speed * speedMultiplier);
 
     handleAnimation(deltaTime);
-    handleHitFlash();
-    handleHealFlash();
-
-    sf::Vector2f newPos = sprite->getPosition();
-    sf::FloatRect bounds = sprite->getGlobalBounds();
-    newPos.x = std::min(std::max(newPos.x, gameBounds.position.x + (bounds.size.x / 2.f) - 112), gameBounds.position.x + gameBounds.size.x - (bounds.size.x / 2.f));
-    newPos.y = std::min(std::max(newPos.y, gameBounds.position.y + (bounds.size.y / 2.f) - 85.f), gameBounds.position.y + gameBounds.size.y - (bounds.size.y / 2.f) - 50.f);
-    sprite->setPosition(newPos);
+    handleHitFlash(deltaTime);
+    handleHealFlash(deltaTime);
+
+    // O offset da hitbox já compensa a origem do sprite (antes eram os -112/-85/-50)
+    sprite->setPosition(resolveMovement(currentPos, sprite->getPosition(), hitboxShape, gameBounds, obstacles));
+    refreshHitbox();
 }
\ No newline at end of file
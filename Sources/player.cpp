@@ -1,24 +1,19 @@
 #include "player.hpp"
 #include "SFML/Window/Keyboard.hpp"
 #include "ConfigManager.hpp" 
+#include "Collision.hpp"
 #include <algorithm>
 #include <iostream>
 #include <cmath>
 #include <SFML/Graphics/RenderWindow.hpp>
 
-// --- FUNÇÃO DE COLISÃO MANUAL LOCAL ---
-static bool checkCollision(const sf::FloatRect& rect1, const sf::FloatRect& rect2) {
-    bool x_overlap = rect1.position.x < rect2.position.x + rect2.size.x &&
-        rect1.position.x + rect1.size.x > rect2.position.x;
-
-    bool y_overlap = rect1.position.y < rect2.position.y + rect2.size.y &&
-        rect1.position.y + rect1.size.y > rect2.position.y;
-
-    return x_overlap && y_overlap;
-}
-
 void Player_ALL::setPosition(const sf::Vector2f& newPosition) {
     if (Isaac) Isaac->setPosition(newPosition);
+    refreshHitbox();
+}
+
+void Player_ALL::refreshHitbox() {
+    hitbox = Isaac ? makeHitbox(Isaac->getPosition(), hitboxShape) : sf::FloatRect();
 }
 
 void Player_ALL::setSpeedMultiplier(float multiplier) {
@@ -40,6 +35,8 @@ Player_ALL::Player_ALL(
     const auto& visual = config.player.visual;
     const auto& spawn = config.player.spawn;
 
+    hitboxShape = config.player.hitbox;
+    tearHitboxShape = config.game.collision.isaac_tear_hitbox;
     health = stats.initial_health;
     speed = stats.speed;
     isaacHitSpeed = attack.projectile_speed;
@@ -59,7 +56,15 @@ Player_ALL::Player_ALL(
     textures_walk_left = &walkLeftTextures;
     textures_walk_right = &walkRightTextures;
     hitTexture = &hitTextureRef;
-    last_animation_set = textures_walk_down;
+
+    const auto& anim = visual.animation;
+    auto& library = AnimationLibrary::getInstance();
+    clipWalkDown = library.fromTextures("isaac/walk_down", walkDownTextures, anim.frames_vertical, anim.frame_duration);
+    clipWalkUp = library.fromTextures("isaac/walk_up", walkUpTextures, anim.frames_vertical, anim.frame_duration);
+    clipWalkLeft = library.fromTextures("isaac/walk_left", walkLeftTextures, anim.frames_horizontal, anim.frame_duration);
+    clipWalkRight = library.fromTextures("isaac/walk_right", walkRightTextures, anim.frames_horizontal, anim.frame_duration);
+    animation.play(clipWalkDown);
+    animation.stop();
 
     if (textures_walk_down && !textures_walk_down->empty()) {
         Isaac.emplace(textures_walk_down->at(0));
@@ -67,6 +72,7 @@ Player_ALL::Player_ALL(
         Isaac->setOrigin({ visual.origin_x, visual.origin_y });
         Isaac->setPosition({ spawn.start_position_x, spawn.start_position_y });
     }
+    refreshHitbox();
 
     if (hitTexture) {
         projectileTextureRect = sf::IntRect({ 0, 0 }, (sf::Vector2i)hitTexture->getSize());
@@ -81,7 +87,7 @@ void Player_ALL::setProjectileTextureRect(const sf::IntRect& rect) {
 void Player_ALL::takeDamage(int amount) {
     // Se isHit é verdadeiro, verificamos se o tempo de invencibilidade já passou
     if (isHit) {
-        if (hitClock.getElapsedTime() < minDamageInterval) {
+        if (hitTimer < minDamageInterval.asSeconds()) {
             return; // Ignora o dano se estiver no intervalo de segurança
         }
     }
@@ -89,8 +95,7 @@ void Player_ALL::takeDamage(int amount) {
     if (health > 0) {
         health = std::max(0, health - amount);
         isHit = true;
-        hitClock.restart(); // Começa a contar o tempo de invulnerabilidade
-        std::cout << "Isaac took damage! Health: " << health << std::endl;
+        hitTimer = 0.f; // Começa a contar o tempo de invulnerabilidade
     }
 }
 
@@ -110,29 +115,34 @@ sf::FloatRect Player_ALL::getGlobalBounds() const {
     return Isaac ? Isaac->getGlobalBounds() : sf::FloatRect();
 }
 
-void Player_ALL::handleMovementAndAnimation(float deltaTime) {
-    if (!Isaac) return;
+PlayerInput Player_ALL::readKeyboard() {
+    PlayerInput input;
 
-    sf::Vector2f move(0.f, 0.f);
-    bool is_moving = false;
-    std::vector<sf::Texture>* current_animation_set = nullptr;
-    int current_total_frames = 0;
+    // Teclas de Movimento (WASD)
+    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Scancode::S)) input.move += {0.f, 1.f};
+    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Scancode::W)) input.move += {0.f, -1.f};
+    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Scancode::A)) input.move += {-1.f, 0.f};
+    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Scancode::D)) input.move += {1.f, 0.f};
+
+    // Setas: a primeira pela ordem Cima, Baixo, Esquerda, Direita
+    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Scancode::Up)) input.shoot = ShootDirection::Up;
+    else if (sf::Keyboard::isKeyPressed(sf::Keyboard::Scancode::Down)) input.shoot = ShootDirection::Down;
+    else if (sf::Keyboard::isKeyPressed(sf::Keyboard::Scancode::Left)) input.shoot = ShootDirection::Left;
+    else if (sf::Keyboard::isKeyPressed(sf::Keyboard::Scancode::Right)) input.shoot = ShootDirection::Right;
+    return input;
+}
 
-    const auto& animConfig = ConfigManager::getInstance().getConfig().player.visual.animation;
-    const int frames_v = animConfig.frames_vertical;
-    const int frames_h = animConfig.frames_horizontal;
+void Player_ALL::handleMovementAndAnimation(float deltaTime, const PlayerInput& input) {
+    if (!Isaac) return;
 
-    // Teclas de Movimento (WASD)
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Scancode::S)) move += {0.f, 1.f};
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Scancode::W)) move += {0.f, -1.f};
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Scancode::A)) move += {-1.f, 0.f};
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Scancode::D)) move += {1.f, 0.f};
+    sf::Vector2f move(std::clamp(input.move.x, -1.f, 1.f), std::clamp(input.move.y, -1.f, 1.f));
+    const AnimationClip* clip = nullptr;
 
     // Define animação baseada no movimento
-    if (move.y > 0) { current_animation_set = textures_walk_down; current_total_frames = frames_v; is_moving = true; }
-    else if (move.y < 0) { current_animation_set = textures_walk_up; current_total_frames = frames_v; is_moving = true; }
-    else if (move.x < 0) { current_animation_set = textures_walk_left; current_total_frames = frames_h; is_moving = true; }
-    else if (move.x > 0) { current_animation_set = textures_walk_right; current_total_frames = frames_h; is_moving = true; }
+    if (move.y > 0) clip = clipWalkDown;
+    else if (move.y < 0) clip = clipWalkUp;
+    else if (move.x < 0) clip = clipWalkLeft;
+    else if (move.x > 0) clip = clipWalkRight;
 
     // Normalização
     float length = std::sqrt(move.x * move.x + move.y * move.y);
@@ -142,39 +152,32 @@ void Player_ALL::handleMovementAndAnimation(float deltaTime) {
         Isaac->move(move * deltaTime * speed * speedMultiplier_);
     }
 
-    // Update de frames
-    if (is_moving && current_animation_set) {
-        if (current_animation_set != last_animation_set) {
-            current_frame = 0;
-            animation_time = 0.0f;
-            last_animation_set = current_animation_set;
-        }
-        animation_time += deltaTime;
-        if (animation_time >= animConfig.frame_duration) {
-            animation_time = 0;
-            current_frame = (current_frame + 1) % current_total_frames;
-            if (current_frame < current_animation_set->size())
-                Isaac->setTexture(current_animation_set->at(current_frame));
-        }
+    // Update de frames (o Isaac e o unico playhead fora das salas)
+    if (clip) {
+        animation.play(clip);
+        advanceAnimation(animation, deltaTime);
     }
     else {
-        if (last_animation_set && !last_animation_set->empty())
-            Isaac->setTexture(last_animation_set->at(0));
+        animation.stop();
     }
+    animation.apply(*Isaac);
 }
 
-void Player_ALL::handleAttack() {
+void Player_ALL::handleAttack(const PlayerInput& input) {
     if (!Isaac || !hitTexture) return;
 
-    if (cooldownClock.getElapsedTime() >= cooldownTime) {
+    if (cooldownTimer >= cooldownTime.asSeconds()) {
         sf::Vector2f dir(0.f, 0.f);
         float rot = 0.f;
-        bool shooting = false;
-
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Scancode::Up)) { dir = { 0.f, -1.f }; rot = -180.f; shooting = true; }
-        else if (sf::Keyboard::isKeyPressed(sf::Keyboard::Scancode::Down)) { dir = { 0.f, 1.f };  rot = 0.f;    shooting = true; }
-        else if (sf::Keyboard::isKeyPressed(sf::Keyboard::Scancode::Left)) { dir = { -1.f, 0.f }; rot = 90.f;   shooting = true; }
-        else if (sf::Keyboard::isKeyPressed(sf::Keyboard::Scancode::Right)) { dir = { 1.f, 0.f };  rot = -90.f;  shooting = true; }
+        bool shooting = true;
+
+        switch (input.shoot) {
+        case ShootDirection::Up: dir = { 0.f, -1.f }; rot = -180.f; break;
+        case ShootDirection::Down: dir = { 0.f, 1.f }; rot = 0.f; break;
+        case ShootDirection::Left: dir = { -1.f, 0.f }; rot = 90.f; break;
+        case ShootDirection::Right: dir = { 1.f, 0.f }; rot = -90.f; break;
+        default: shooting = false; break;
+        }
 
         if (shooting) {
             const auto& pVis = ConfigManager::getInstance().getConfig().player.projectile_visual;
@@ -184,21 +187,36 @@ void Player_ALL::handleAttack() {
             p.sprite.setOrigin({ pVis.origin_x, pVis.origin_y });
             p.sprite.setPosition(Isaac->getPosition());
             p.sprite.setRotation(sf::degrees(rot));
+            p.hitbox = makeHitbox(p.sprite.getPosition(), tearHitboxShape);
             projectiles.push_back(p);
-            cooldownClock.restart();
+            cooldownTimer = 0.f;
         }
     }
 }
 
 void Player_ALL::updateProjectiles(float deltaTime, const sf::FloatRect& gameBounds) {
-    for (auto it = projectiles.begin(); it != projectiles.end(); ) {
-        it->sprite.move(it->direction * isaacHitSpeed * deltaTime);
-        it->distanceTraveled += isaacHitSpeed * deltaTime;
-
-        if (it->distanceTraveled >= maxHitDistance || !checkCollision(it->sprite.getGlobalBounds(), gameBounds))
-            it = projectiles.erase(it);
-        else
-            ++it;
+    // Os que expiraram no tick anterior sem passar pelas colisoes (ex.: tick de porta)
+    eraseExpiring(projectiles);
+
+    for (Projectile& p : projectiles) {
+        p.lastStep = p.direction * isaacHitSpeed * deltaTime;
+        p.sprite.move(p.lastStep);
+        p.distanceTraveled += isaacHitSpeed * deltaTime;
+
+        // As rochas param a lágrima (raio pelo caminho do tick). O passo fica cortado
+        // no impacto para o teste contínuo só varrer o caminho até à rocha.
+        sf::Vector2f center = p.sprite.getPosition();
+        float hitFraction;
+        bool hitRock = obstacles && obstacles->raycast(center - p.lastStep, center, ObstacleLayer::Projectiles, hitFraction);
+        if (hitRock) {
+            const sf::Vector2f blocked = p.lastStep * (1.f - hitFraction);
+            p.sprite.move(-blocked);
+            p.lastStep -= blocked;
+        }
+        p.hitbox = makeHitbox(p.sprite.getPosition(), tearHitboxShape);
+
+        // Não sai já: a Simulation ainda testa o caminho deste tick e apaga-a depois
+        p.expiring = p.distanceTraveled >= maxHitDistance || !checkCollision(p.hitbox, gameBounds) || hitRock;
     }
 }
 
@@ -206,7 +224,7 @@ void Player_ALL::handleHitFlash(float deltaTime) {
     if (!Isaac) return;
 
     if (isHit) {
-        sf::Time elapsed = hitClock.getElapsedTime();
+        sf::Time elapsed = sf::seconds(hitTimer);
         if (elapsed < minDamageInterval) {
             // Efeito visual: pisca rápido usando o tempo decorrido
             if (static_cast<int>(elapsed.asMilliseconds() / 100) % 2 == 0)
@@ -223,18 +241,72 @@ void Player_ALL::handleHitFlash(float deltaTime) {
 
 void Player_ALL::update(float deltaTime, const sf::FloatRect& gameBounds) {
     if (!Isaac || health <= 0) return;
+    const sf::Vector2f previousPosition = Isaac->getPosition();
+    cooldownTimer = std::min(cooldownTimer + deltaTime, cooldownTime.asSeconds());
+    if (isHit) hitTimer += deltaTime;
 
-    handleMovementAndAnimation(deltaTime);
-    handleAttack();
+    const PlayerInput input = scriptedInput ? *scriptedInput : readKeyboard();
+    handleMovementAndAnimation(deltaTime, input);
+    handleAttack(input);
     handleHitFlash(deltaTime);
     updateProjectiles(deltaTime, gameBounds);
 
-    // Bordas da sala
-    sf::Vector2f pos = Isaac->getPosition();
-    sf::FloatRect bounds = Isaac->getGlobalBounds();
-    pos.x = std::clamp(pos.x, gameBounds.position.x + bounds.size.x / 2.f, gameBounds.position.x + gameBounds.size.x - bounds.size.x / 2.f);
-    pos.y = std::clamp(pos.y, gameBounds.position.y + bounds.size.y / 2.f, gameBounds.position.y + gameBounds.size.y - bounds.size.y / 2.f);
-    Isaac->setPosition(pos);
+    // Bordas da sala e obstáculos
+    Isaac->setPosition(resolveMovement(previousPosition, Isaac->getPosition(), hitboxShape, gameBounds, obstacles));
+    refreshHitbox();
+}
+
+void Player_ALL::saveState(PlayerState& state, std::vector<ProjectileState>& out) const {
+    state.position = getPosition();
+    state.health = health;
+    state.isHit = isHit ? 1 : 0;
+    state.hitTimer = hitTimer;
+    state.cooldownTimer = cooldownTimer;
+    animation.save(state.animation);
+
+    state.projectileBegin = static_cast<std::uint32_t>(out.size());
+    state.projectileCount = 0;
+    for (const Projectile& p : projectiles) {
+        if (p.expiring) continue;  // Ja acabou; so esperava pelas colisoes
+        ++state.projectileCount;
+        ProjectileState saved;
+        saved.position = p.sprite.getPosition();
+        saved.direction = p.direction;
+        saved.distanceTraveled = p.distanceTraveled;
+        saved.rotation = p.sprite.getRotation().asDegrees();
+        saved.scale = p.sprite.getScale();
+        out.push_back(saved);
+    }
+}
+
+void Player_ALL::loadState(const PlayerState& state, const ProjectileState* saved) {
+    health = state.health;
+    isHit = state.isHit != 0;
+    hitTimer = state.hitTimer;
+    cooldownTimer = state.cooldownTimer;
+    setPosition(state.position);
+    animation.load(state.animation);
+    if (Isaac) {
+        animation.apply(*Isaac);
+        Isaac->setColor(sf::Color::White);
+    }
+
+    // Mesmo sprite que o handleAttack monta a cada disparo
+    projectiles.clear();
+    if (!hitTexture) return;
+    const auto& pVis = ConfigManager::getInstance().getConfig().player.projectile_visual;
+    projectiles.reserve(state.projectileCount);
+    for (std::uint32_t i = 0; i < state.projectileCount; ++i) {
+        const ProjectileState& p = saved[i];
+        Projectile projectile = { sf::Sprite(*hitTexture), p.direction, p.distanceTraveled };
+        projectile.sprite.setTextureRect(projectileTextureRect);
+        projectile.sprite.setScale(p.scale);
+        projectile.sprite.setOrigin({ pVis.origin_x, pVis.origin_y });
+        projectile.sprite.setPosition(p.position);
+        projectile.sprite.setRotation(sf::degrees(p.rotation));
+        projectile.hitbox = makeHitbox(p.position, tearHitboxShape);
+        projectiles.push_back(projectile);
+    }
 }
 
 void Player_ALL::draw(sf::RenderWindow& window) {
@@ -1,14 +1,28 @@
 #include "Game.hpp"
-#include <iostream>
+#include "Benchmark.hpp"
+#include "AssetPacker.hpp"
+#include "Logger.hpp"
+#include <string>
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && std::string(argv[1]) == "--bench") {
+        runBenchmarks();
+        return 0;
+    }
+    if (argc > 1 && std::string(argv[1]) == "--pack") {
+        return runAssetPacker(argc > 2 ? argv[2] : "Images", argc > 3 ? argv[3] : "assets.pak");
+    }
 
-int main() {
     try {
         Game game;
         game.run();
     }
     catch (const std::runtime_error& e) {
-        std::cerr << "ERRO FATAL NA EXECUÇÃO: " << e.what() << std::endl;
+        LOG_ERROR(LogCategory::General, "FATAL NA EXECUÇÃO: ", e.what());
+        Logger::getInstance().stop();
         return -1;
     }
+    // Escreve o que ainda estiver na fila antes de sair
+    Logger::getInstance().stop();
     return 0;
-}
\ No newline at end of file
+}